@@ -0,0 +1,89 @@
+#include "examples_common.cpp"
+
+/*******************************************************************************
+ * We benchmark the cost per arc of the product construction in Apply when the
+ * operator is one of the predefined operators in <adiar/data.h>, and hence is
+ * resolved at compile-time, compared to a generic operator that computes the
+ * very same truth table. The latter has to go through the 'std::function' of
+ * the 'adiar::bool_op' for every pair of sinks.
+ *
+ * The two inputs are the BDDs for 'exactly N/2' and 'exactly N/3' of the N
+ * variables being set to true. Their product has O(N^3) many nodes.
+ */
+size_t R = 5;
+
+struct benchmark_result
+{
+  double seconds = 0.0;
+  size_t arcs = 0;
+};
+
+benchmark_result run(const adiar::bdd &f, const adiar::bdd &g, const adiar::bool_op &op)
+{
+  benchmark_result res;
+
+  for (size_t r = 0; r < R; r++) {
+    timestamp_t before = get_timestamp();
+    adiar::__bdd out = adiar::bdd_apply(f, g, op);
+    timestamp_t after = get_timestamp();
+
+    res.seconds += duration_of(before, after);
+    res.arcs += out.get<adiar::arc_file>().size();
+  }
+
+  return res;
+}
+
+void print_row(const std::string &name, const benchmark_result &res)
+{
+  std::cout << "|  | " << name << " : "
+            << res.seconds / R << " s, "
+            << (res.seconds * 1e9) / res.arcs << " ns/arc" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  // ===== Parse argument =====
+  {
+    bool should_error_exit = init_cl_arguments(argc, argv);
+    if (!should_error_exit && N < 3) {
+      std::cout << "  Must specify a number of at least 3 for N" << std::endl;
+      should_error_exit = true;
+    }
+
+    if (should_error_exit) { exit(1); }
+  }
+
+  // ===== ADIAR =====
+  // Initialize
+  adiar::adiar_init(M*1024*1024);
+  std::cout << "| Initialized Adiar with " << M << " MiB of memory"  << std::endl << "|" << std::endl;
+
+  { // Add scope to garbage collect all 'adiar::bdd' instances before calling
+    // the 'adiar::adiar_deinit()' function.
+
+    const adiar::bdd f = adiar::bdd_counter(0, N-1, N/2);
+    const adiar::bdd g = adiar::bdd_counter(0, N-1, N/3);
+
+    std::cout << "| Apply on " << bdd_nodecount(f) << " and " << bdd_nodecount(g) << " nodes"
+              << " (average of " << R << " runs)" << std::endl;
+
+    // Generic operators with the very same truth tables as the predefined ones
+    const adiar::bool_op generic_and = [](adiar::ptr_t s1, adiar::ptr_t s2) -> adiar::ptr_t
+    { return adiar::and_op_t()(s1, s2); };
+
+    const adiar::bool_op generic_xor = [](adiar::ptr_t s1, adiar::ptr_t s2) -> adiar::ptr_t
+    { return adiar::xor_op_t()(s1, s2); };
+
+    print_row("and (compile-time)", run(f, g, adiar::and_op));
+    print_row("and (bool_op)     ", run(f, g, generic_and));
+    print_row("xor (compile-time)", run(f, g, adiar::xor_op));
+    print_row("xor (bool_op)     ", run(f, g, generic_xor));
+  }
+
+  // ===== ADIAR =====
+  // Close all of Adiar down again
+  adiar::adiar_deinit();
+
+  exit(0);
+}
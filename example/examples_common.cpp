@@ -21,6 +21,8 @@ inline double duration_of(timestamp_t &before, timestamp_t &after) {
 // Command-line arguments
 uint64_t N = std::numeric_limits<uint64_t>::max();
 size_t M = 0;
+size_t L = 0;
+bool S = false;
 
 bool init_cl_arguments(int argc, char* argv[])
 {
@@ -29,7 +31,7 @@ bool init_cl_arguments(int argc, char* argv[])
 
   opterr = 0; // Squelch errors of "weird" command-line arguments
 
-  while ((c = getopt(argc, argv, "N:M:h")) != -1) {
+  while ((c = getopt(argc, argv, "N:M:L:Sh")) != -1) {
     try {
       switch(c) {
       case 'N':
@@ -44,12 +46,22 @@ bool init_cl_arguments(int argc, char* argv[])
 
         continue;
 
+      case 'L':
+        L = std::stoi(optarg);
+        continue;
+
+      case 'S':
+        S = true;
+        continue;
+
       case 'h':
         std::cout << "Usage:  -flag    [mandatory]  Description" << std::endl
                   << std::endl
                   << "        -h       [ ]          Print this information" << std::endl
                   << "        -N SIZE  [x]          Specify the size of problem" << std::endl
-                  << "        -M MiB   [x]          Specify the amount of memory (MiB) to be dedicated to Adiar" << std::endl;
+                  << "        -M MiB   [x]          Specify the amount of memory (MiB) to be dedicated to Adiar" << std::endl
+                  << "        -L NUM   [ ]          Fix the look-ahead of the levelized priority queues (0 = adaptive)" << std::endl
+                  << "        -S       [ ]          Print statistics (if Adiar is compiled with ADIAR_STATS)" << std::endl;
         return true;
       }
     } catch (std::invalid_argument const &ex) {
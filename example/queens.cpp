@@ -414,6 +414,7 @@ int main(int argc, char* argv[])
   // Initialize
 
   adiar::adiar_init(M*1024*1024);
+  adiar::adiar_set_lpq_lookahead(L);
   std::cout << "| Initialized Adiar with " << M << " MiB of memory"  << std::endl << "|" << std::endl;
 
   bool correct_result = true;
@@ -459,6 +460,7 @@ int main(int argc, char* argv[])
 
   // ===== ADIAR =====
   // Close all of Adiar down again
+  if (S) { adiar::adiar_printstat(); }
   adiar::adiar_deinit();
 
   // Return 'all good'
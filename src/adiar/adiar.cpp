@@ -1,41 +1,73 @@
 #include "adiar.h"
 
-#include <tpie/tpie.h>
+#include <adiar/context.h>
 
 #include <adiar/internal/assert.h>
+#include <adiar/internal/async.h>
+#include <adiar/internal/cache.h>
+#include <adiar/internal/levelized_priority_queue.h>
 #include <adiar/internal/memory.h>
+#include <adiar/internal/parallel.h>
 
 namespace adiar
 {
   bool _adiar_initialized = false;
+  size_t _adiar_memory_limit = 0u;
 
-  void adiar_init(size_t memory_limit_bytes, std::string temp_dir)
+  void adiar_init(size_t memory_limit_bytes, std::string temp_dir, size_t threads,
+                  bool parallel_sort)
   {
     if (_adiar_initialized) {
       std::cerr << "Adiar has already been initialized!" << std::endl;
       return;
     }
+    adiar_assert(memory_limit_bytes >= memory::MINIMUM_BYTES,
+                 "Adiar requires at least 128 MiB of memory");
+
     _adiar_initialized = true;
+    _adiar_memory_limit = memory_limit_bytes;
 
     adiar_statsreset();
 
-    // Initialise TPIE
-    tpie::tpie_init();
+    // Initialise TPIE (unless some adiar_context already did so) and add the
+    // memory to its limit.
+    adiar_context::acquire(memory_limit_bytes, temp_dir);
+    if (temp_dir != "") { memory::set_path(temp_dir); }
+
+    // Multi-threading
+    parallel::set_threads(threads);
+    parallel::set_sorting(parallel_sort);
+  }
 
-    // Memory management
-    memory::set_path(temp_dir);
-    memory::set_limit(memory_limit_bytes);
-    memory::set_block_size(memory::recommended_block_size(memory_limit_bytes));
+  void adiar_set_cache_limit(size_t bytes)
+  {
+    cache::set_limit(bytes);
+  }
+
+  void adiar_set_internal_file_threshold(size_t bytes)
+  {
+    memory::set_internal_file_threshold(bytes);
+  }
+
+  void adiar_set_lpq_lookahead(size_t lookahead)
+  {
+    lpq::set_lookahead(lookahead);
+  }
+
+  void adiar_set_async_workers(size_t workers)
+  {
+    async::shutdown();
+    async::set_workers(workers);
   }
 
   bool adiar_initialized()
   {
-    return _adiar_initialized;
+    return _adiar_initialized || adiar_context::acquired();
   }
 
   void adiar_deinit()
   {
-    if (_adiar_initialized) tpie::tpie_finish();
+    if (_adiar_initialized) adiar_context::release(_adiar_memory_limit);
     _adiar_initialized = false;
   }
 }
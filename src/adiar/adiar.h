@@ -19,6 +19,10 @@
 /// Statistics
 #include <adiar/statistics.h>
 
+////////////////////////////////////////////////////////////////////////////////
+/// Sessions
+#include <adiar/context.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Deprecated Functions
 #include <adiar/deprecated.h>
@@ -35,8 +39,65 @@ namespace adiar
   /// \param temp_dir
   /// The directory to use for all temporary external memory files. By default
   /// on Unix, this is the '/tmp' folder.
+  ///
+  /// \param threads
+  /// The number of threads each operation may use on its wider levels. By
+  /// default, this is 1, i.e. all operations are single-threaded.
+  ///
+  /// \param parallel_sort
+  /// Whether the buckets of the levelized priority queues (and other sorting in
+  /// internal memory) are sorted with the above number of threads. By default,
+  /// this is disabled.
+  //////////////////////////////////////////////////////////////////////////////
+  void adiar_init(size_t memory_limit_bytes, std::string temp_dir = "", size_t threads = 1u,
+                  bool parallel_sort = false);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Sets the number of bytes of results of top-level operations, e.g.
+  ///        <tt>bdd_apply</tt> and <tt>bdd_exists</tt>, to keep for when they
+  ///        are called again on the very same inputs.
+  ///
+  /// \param bytes
+  /// The size of the results' files (in internal or external memory) kept
+  /// in the cache. By default, this is 0, i.e. the cache is disabled.
+  //////////////////////////////////////////////////////////////////////////////
+  void adiar_set_cache_limit(size_t bytes);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Sets the maximum size of a file that is kept in internal memory
+  ///        rather than on disk.
+  ///
+  /// \param bytes
+  /// A temporary file is only moved to disk when it grows beyond this many
+  /// bytes. Furthermore, all streams of a read-only file on disk of at most
+  /// this size read from a single copy of it in internal memory. By default,
+  /// this is the size of a single block, i.e. such a file does not use more
+  /// memory than a stream on it would have. Setting this to 0 places all files
+  /// on disk. This only affects files that are created afterwards.
+  //////////////////////////////////////////////////////////////////////////////
+  void adiar_set_internal_file_threshold(size_t bytes);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Sets the number of levels that the levelized priority queues of all
+  ///        subsequent operations look ahead.
+  ///
+  /// \param lookahead
+  /// The number of levels (at most ADIAR_LPQ_LOOKAHEAD) to keep buckets for. By
+  /// default, this is 0, i.e. each operation chooses it based on the shape of
+  /// its input(s) and its available memory.
+  //////////////////////////////////////////////////////////////////////////////
+  void adiar_set_lpq_lookahead(size_t lookahead = 0u);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Sets the number of worker threads for asynchronous operations, e.g.
+  ///        <tt>bdd_apply_async</tt>.
+  ///
+  /// \param workers
+  /// The number of operations that may run concurrently. By default, this is
+  /// 0, i.e. as many as the hardware supports. This only takes effect when no
+  /// asynchronous operation is running.
   //////////////////////////////////////////////////////////////////////////////
-  void adiar_init(size_t memory_limit_bytes, std::string temp_dir = "");
+  void adiar_set_async_workers(size_t workers = 0u);
 
   //////////////////////////////////////////////////////////////////////////////
   /// \brief Whether Adiar is initialized.
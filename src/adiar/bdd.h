@@ -1,7 +1,14 @@
 #ifndef ADIAR_BDD_H
 #define ADIAR_BDD_H
 
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <random>
 #include <string>
+#include <vector>
 
 #include <adiar/data.h>
 #include <adiar/file.h>
@@ -138,6 +145,19 @@ namespace adiar
   __bdd operator& (__bdd &&, const bdd &);
   __bdd operator& (__bdd &&, __bdd &&);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief    Logical 'and' of many BDDs.
+  ///
+  /// \details  Up to 64 BDDs are combined in a single sweep, if it fits into
+  ///           memory. Otherwise, they are split into a balanced tree of
+  ///           smaller products.
+  ///
+  /// \param fs BDDs to conjoin
+  ///
+  /// \returns  \f$ \bigwedge_{f \in \mathit{fs}} f \f$
+  //////////////////////////////////////////////////////////////////////////////
+  __bdd bdd_and(const std::vector<bdd> &fs);
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief   Logical 'nand' operator.
   ///
@@ -159,6 +179,19 @@ namespace adiar
   __bdd operator| (__bdd &&, const bdd &);
   __bdd operator| (__bdd &&, __bdd &&);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief    Logical 'or' of many BDDs.
+  ///
+  /// \details  Up to 64 BDDs are combined in a single sweep, if it fits into
+  ///           memory. Otherwise, they are split into a balanced tree of
+  ///           smaller products.
+  ///
+  /// \param fs BDDs to disjoin
+  ///
+  /// \returns  \f$ \bigvee_{f \in \mathit{fs}} f \f$
+  //////////////////////////////////////////////////////////////////////////////
+  __bdd bdd_or(const std::vector<bdd> &fs);
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief   Logical 'nor' operator.
   ///
@@ -278,11 +311,14 @@ namespace adiar
   //////////////////////////////////////////////////////////////////////////////
   /// \brief      Existentially quantify multiple variables.
   ///
-  /// \details    Repeatedly calls <tt>bdd_exists</tt> for the given variables
-  ///             while optimising garbage collecting intermediate results.
+  /// \details    Quantifies all the given variables in a single sweep. If a
+  ///             request grows too large on some variable, then that variable
+  ///             is quantified afterwards by a call to <tt>bdd_exists</tt> per
+  ///             variable. This also is the fallback, if not a single level of
+  ///             f fits into memory.
   ///
   /// \param f    BDD to be quantified
-  /// \param vars Variables to quantify in f (in order of their quantification)
+  /// \param vars Variables to quantify in f
   ///
   /// \returns    \f$ \exists x_{i_1}, \dots, x_{i_k} : f \f$
   //////////////////////////////////////////////////////////////////////////////
@@ -306,21 +342,294 @@ namespace adiar
   //////////////////////////////////////////////////////////////////////////////
   /// \brief      Forall quantify multiple variables.
   ///
-  /// \details    Repeatedly calls <tt>bdd_exists</tt> for the given variables
-  ///             while optimising garbage collecting intermediate results.
+  /// \details    Quantifies all the given variables in a single sweep. If a
+  ///             request grows too large on some variable, then that variable
+  ///             is quantified afterwards by a call to <tt>bdd_forall</tt> per
+  ///             variable. This also is the fallback, if not a single level of
+  ///             f fits into memory.
   ///
   /// \param f    BDD to be quantified
-  /// \param vars Variables to quantify in f (in order of their quantification)
+  /// \param vars Variables to quantify in f
   ///
   /// \returns    \f$ \forall x_{i_1}, \dots, x_{i_k} : f \f$
   //////////////////////////////////////////////////////////////////////////////
   __bdd bdd_forall(const bdd &f, const label_file &vars);
   __bdd bdd_forall(bdd &&f, const label_file &vars);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief      Relational product, i.e. existential quantification of the
+  ///             conjunction of two BDDs.
+  ///
+  /// \details    Computes the same as <tt>bdd_exists(bdd_and(f, g), vars)</tt>
+  ///             but quantifies the variables while the conjunction is being
+  ///             computed. This way, the (usually much larger) unquantified
+  ///             conjunction is never constructed.
+  ///
+  /// \param f    BDD for the left-hand-side of the conjunction
+  ///
+  /// \param g    BDD for the right-hand-side of the conjunction
+  ///
+  /// \param vars Labels of the variables to quantify (in any order)
+  ///
+  /// \returns    \f$ \exists x_{i_1}, \dots, x_{i_k} : f \land g \f$
+  //////////////////////////////////////////////////////////////////////////////
+  __bdd bdd_relprod(const bdd &f, const bdd &g, const label_file &vars);
+
   __bdd bdd_reorder(const bdd &dd, const std::vector<label_t> permutation);
   void reset_reorder_stats();
   
 
+  /* ===================== ASYNCHRONOUS BDD MANIPULATION ==================== */
+
+  namespace async { struct task; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   The (reduced) result of an operation that is computed
+  ///          asynchronously.
+  ///
+  /// \details The operations below are run on an internal pool of worker
+  ///          threads as soon as all the futures they are given are ready, i.e.
+  ///          independent operations run concurrently. The internal memory
+  ///          available to the thread that submits an operation is split
+  ///          equally between the operations that may run concurrently, but
+  ///          fewer than all workers are used if each would get less than
+  ///          32 MiB. The statistics of an operation are added to the ones of
+  ///          the thread (or context) that submitted it when it is done.
+  ///
+  ///          Any exception of an operation is thrown by <tt>get()</tt> of its
+  ///          future and of the futures of all operations that depend on it.
+  ///
+  /// \remark  Do not wait for a future from within an operation on the pool.
+  //////////////////////////////////////////////////////////////////////////////
+  class bdd_future
+  {
+  private:
+    std::shared_future<bdd> _result;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The task computing the result (<tt>nullptr</tt> if the result was
+    ///        given up front).
+    ////////////////////////////////////////////////////////////////////////////
+    std::shared_ptr<async::task> _task;
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief A future that already is ready with the given BDD.
+    ////////////////////////////////////////////////////////////////////////////
+    bdd_future(const bdd &f);
+
+    bdd_future(const std::shared_future<bdd> &result,
+               const std::shared_ptr<async::task> &task);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Wait for the result and obtain it.
+    ////////////////////////////////////////////////////////////////////////////
+    bdd get() const
+    { return _result.get(); }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Wait for the result.
+    ////////////////////////////////////////////////////////////////////////////
+    void wait() const
+    { _result.wait(); }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Whether the result has been computed.
+    ////////////////////////////////////////////////////////////////////////////
+    bool is_ready() const
+    { return _result.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The task computing the result.
+    ////////////////////////////////////////////////////////////////////////////
+    const std::shared_ptr<async::task>& task() const
+    { return _task; }
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Asynchronous <tt>bdd_apply</tt>.
+  //////////////////////////////////////////////////////////////////////////////
+  bdd_future bdd_apply_async(const bdd_future &f, const bdd_future &g, const bool_op &op);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Asynchronous <tt>bdd_ite</tt>.
+  //////////////////////////////////////////////////////////////////////////////
+  bdd_future bdd_ite_async(const bdd_future &f, const bdd_future &g, const bdd_future &h);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Asynchronous <tt>bdd_exists</tt>.
+  //////////////////////////////////////////////////////////////////////////////
+  bdd_future bdd_exists_async(const bdd_future &f, label_t var);
+  bdd_future bdd_exists_async(const bdd_future &f, const label_file &vars);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Asynchronous <tt>bdd_forall</tt>.
+  //////////////////////////////////////////////////////////////////////////////
+  bdd_future bdd_forall_async(const bdd_future &f, label_t var);
+  bdd_future bdd_forall_async(const bdd_future &f, const label_file &vars);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Asynchronous <tt>bdd_relprod</tt>.
+  //////////////////////////////////////////////////////////////////////////////
+  bdd_future bdd_relprod_async(const bdd_future &f, const bdd_future &g, const label_file &vars);
+
+  /* ========================= LAZY BDD MANIPULATION ======================== */
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   An expression over BDDs that is only computed once it is
+  ///          converted into a <tt>bdd</tt>.
+  ///
+  /// \details The operators <tt>&</tt>, <tt>|</tt>, <tt>^</tt>, and <tt>~</tt>
+  ///          as well as <tt>bdd_exists</tt> and <tt>bdd_forall</tt> on an
+  ///          expression do not run a sweep but build a DAG of the operations.
+  ///          While doing so,
+  ///
+  ///          - negations are folded into the operands (which are negated in
+  ///            constant time),
+  ///
+  ///          - chains of the same operator (e.g. <tt>a & b & c & d</tt>) are
+  ///            flattened into a single n-ary operation, that is computed with
+  ///            a single product construction,
+  ///
+  ///          - constant operands are removed or short-circuit the operation,
+  ///
+  ///          - quantification of a conjunction is computed as a relational
+  ///            product.
+  ///
+  ///          Only temporary subexpressions are flattened into others. One that
+  ///          is shared, e.g. stored in a variable, is kept as is and is only
+  ///          computed once.
+  ///
+  /// \remark  For the same reason, <tt>f = f & g</tt> does not extend the
+  ///          conjunction of <tt>f</tt>, since <tt>f</tt> still is shared with
+  ///          the left operand while the new expression is built. Use
+  ///          <tt>f &= g</tt> instead, which appends <tt>g</tt> in-place.
+  ///
+  /// \remark  Laziness is opt-in: use <tt>bdd_lazy</tt> on one of the
+  ///          operands, after which mixing in a <tt>bdd</tt> keeps the
+  ///          expression lazy.
+  //////////////////////////////////////////////////////////////////////////////
+  class bdd_expr
+  {
+  public:
+    struct node;
+
+  private:
+    std::shared_ptr<node> _root;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Whether to negate the result of <tt>_root</tt>.
+    ////////////////////////////////////////////////////////////////////////////
+    bool _negate = false;
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The expression of a single (already computed) BDD.
+    ////////////////////////////////////////////////////////////////////////////
+    explicit bdd_expr(const bdd &f);
+
+    bdd_expr(std::shared_ptr<node> root, bool negate = false);
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Compute the BDD of this expression. Every (sub)expression is
+    ///        computed at most once.
+    ////////////////////////////////////////////////////////////////////////////
+    bdd eval() const;
+
+    const std::shared_ptr<node>& root() const
+    { return _root; }
+
+    bool negated() const
+    { return _negate; }
+
+  public:
+    bdd_expr& operator&= (bdd_expr other);
+    bdd_expr& operator&= (const bdd &other);
+
+    bdd_expr& operator|= (bdd_expr other);
+    bdd_expr& operator|= (const bdd &other);
+
+    bdd_expr& operator^= (bdd_expr other);
+    bdd_expr& operator^= (const bdd &other);
+
+    friend bdd_expr operator~ (bdd_expr f);
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief A single operation in the DAG of a <tt>bdd_expr</tt>.
+  //////////////////////////////////////////////////////////////////////////////
+  struct bdd_expr::node
+  {
+    enum class op_t { LEAF, AND, OR, XOR, EXISTS, FORALL };
+
+    op_t op;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The BDD of a leaf or of an operation that has been computed.
+    ////////////////////////////////////////////////////////////////////////////
+    std::optional<bdd> leaf;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The operands (of which there is a single one to quantify). The
+    ///        operands of an 'and' and an 'or' are never themselves an
+    ///        unshared 'and' nor 'or' that could have been flattened. The
+    ///        operands of a 'xor' are never negated.
+    ////////////////////////////////////////////////////////////////////////////
+    std::vector<bdd_expr> args;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The variables to quantify.
+    ////////////////////////////////////////////////////////////////////////////
+    std::optional<label_file> vars;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Destroys the operands iteratively, such that a deep expression
+    ///        does not overflow the stack.
+    ////////////////////////////////////////////////////////////////////////////
+    ~node();
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Start a lazy expression with the given BDD.
+  //////////////////////////////////////////////////////////////////////////////
+  inline bdd_expr bdd_lazy(const bdd &f)
+  { return bdd_expr(f); }
+
+  bdd_expr operator~ (bdd_expr f);
+
+  bdd_expr operator& (bdd_expr lhs, bdd_expr rhs);
+  bdd_expr operator& (bdd_expr lhs, const bdd &rhs);
+  bdd_expr operator& (const bdd &lhs, bdd_expr rhs);
+  bdd_expr operator& (bdd_expr lhs, __bdd &&rhs);
+  bdd_expr operator& (__bdd &&lhs, bdd_expr rhs);
+
+  bdd_expr operator| (bdd_expr lhs, bdd_expr rhs);
+  bdd_expr operator| (bdd_expr lhs, const bdd &rhs);
+  bdd_expr operator| (const bdd &lhs, bdd_expr rhs);
+  bdd_expr operator| (bdd_expr lhs, __bdd &&rhs);
+  bdd_expr operator| (__bdd &&lhs, bdd_expr rhs);
+
+  bdd_expr operator^ (bdd_expr lhs, bdd_expr rhs);
+  bdd_expr operator^ (bdd_expr lhs, const bdd &rhs);
+  bdd_expr operator^ (const bdd &lhs, bdd_expr rhs);
+  bdd_expr operator^ (bdd_expr lhs, __bdd &&rhs);
+  bdd_expr operator^ (__bdd &&lhs, bdd_expr rhs);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Lazy <tt>bdd_exists</tt>. If <tt>f</tt> is a conjunction, then it
+  ///        is computed as a <tt>bdd_relprod</tt>.
+  //////////////////////////////////////////////////////////////////////////////
+  bdd_expr bdd_exists(const bdd_expr &f, label_t var);
+  bdd_expr bdd_exists(const bdd_expr &f, const label_file &vars);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Lazy <tt>bdd_forall</tt>. If <tt>f</tt> is a disjunction, then it
+  ///        is computed as a (negated) <tt>bdd_relprod</tt>.
+  //////////////////////////////////////////////////////////////////////////////
+  bdd_expr bdd_forall(const bdd_expr &f, label_t var);
+  bdd_expr bdd_forall(const bdd_expr &f, const label_file &vars);
+
   /* ============================ BDD PREDICATES ============================ */
 
   //////////////////////////////////////////////////////////////////////////////
@@ -344,6 +653,16 @@ namespace adiar
   bool operator!= (__bdd &&f, const bdd &g);
   bool operator!= (__bdd &&f, __bdd &&g);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief A hash of the function f, i.e. if f and g represent the same
+  ///        function then bdd_hash(f) == bdd_hash(g).
+  ///
+  /// \details The hash is derived bottom-up while the BDD is constructed, so
+  ///          this takes constant time. The converse does not hold: two
+  ///          different functions may (rarely) have the same hash.
+  //////////////////////////////////////////////////////////////////////////////
+  uint64_t bdd_hash(const bdd &f);
+
   /* ============================= BDD COUNTING ============================= */
 
   //////////////////////////////////////////////////////////////////////////////
@@ -365,6 +684,35 @@ namespace adiar
   //////////////////////////////////////////////////////////////////////////////
   uint64_t bdd_pathcount(const bdd &f);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   The (base 2) logarithm of the number of unique paths to the true
+  ///          sink.
+  ///
+  /// \details Unlike bdd_pathcount, this does not overflow. If there are no
+  ///          such paths, then the result is negative infinity.
+  //////////////////////////////////////////////////////////////////////////////
+  double bdd_pathcountln(const bdd &f);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief The number of unique paths to the true sink modulo the given
+  ///        (positive) number.
+  ///
+  /// \throws std::invalid_argument If <tt>modulus</tt> is 0.
+  //////////////////////////////////////////////////////////////////////////////
+  uint64_t bdd_pathcount_mod(const bdd &f, uint64_t modulus);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   The exact number of unique paths to the true sink in decimal.
+  ///
+  /// \details The requests of the sweep carry numbers with as many bits as
+  ///          there are levels in f. Hence, they may spill to disk sooner.
+  ///
+  /// \throws std::overflow_error If f has more than 65535 levels or if the
+  ///         numbers needed are too large for the priority queue to fit into
+  ///         memory.
+  //////////////////////////////////////////////////////////////////////////////
+  std::string bdd_pathcount_str(const bdd &f);
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief          Count the number of assignments x that make f(x) true.
   ///
@@ -387,6 +735,88 @@ namespace adiar
   inline uint64_t bdd_satcount(const bdd &f)
   { return bdd_satcount(f, bdd_varcount(f)); };
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   The (base 2) logarithm of the number of assignments x that make
+  ///          f(x) true.
+  ///
+  /// \details Unlike bdd_satcount, this does not overflow. If f is
+  ///          unsatisfiable, then the result is negative infinity.
+  ///
+  /// \param varcount The number of variables in the domain of the function.
+  //////////////////////////////////////////////////////////////////////////////
+  double bdd_satcountln(const bdd &f, label_t varcount);
+
+  inline double bdd_satcountln(const bdd &f)
+  { return bdd_satcountln(f, bdd_varcount(f)); };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Count the number of assignments x that make f(x) true modulo the
+  ///        given (positive) number.
+  ///
+  /// \param varcount The number of variables in the domain of the function.
+  ///
+  /// \throws std::invalid_argument If <tt>modulus</tt> is 0.
+  //////////////////////////////////////////////////////////////////////////////
+  uint64_t bdd_satcount_mod(const bdd &f, label_t varcount, uint64_t modulus);
+
+  inline uint64_t bdd_satcount_mod(const bdd &f, uint64_t modulus)
+  { return bdd_satcount_mod(f, bdd_varcount(f), modulus); };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   The exact number of assignments x that make f(x) true in
+  ///          decimal.
+  ///
+  /// \details The requests of the sweep carry numbers of varcount bits. Hence,
+  ///          they may spill to disk sooner.
+  ///
+  /// \param varcount The number of variables in the domain of the function.
+  ///
+  /// \throws std::overflow_error If varcount is larger than 65535 or if the
+  ///         numbers needed are too large for the priority queue to fit into
+  ///         memory.
+  //////////////////////////////////////////////////////////////////////////////
+  std::string bdd_satcount_str(const bdd &f, label_t varcount);
+
+  inline std::string bdd_satcount_str(const bdd &f)
+  { return bdd_satcount_str(f, bdd_varcount(f)); };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Weighted model count, i.e. the probability of f(x) being true
+  ///          when each x_i independently is true with the given probability.
+  ///
+  /// \param probabilities The i'th element is the probability of x_i being
+  ///                      true. There should be one for every variable in f.
+  //////////////////////////////////////////////////////////////////////////////
+  double bdd_wmc(const bdd &f, const weight_file &probabilities);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   The minimal cost of an assignment x that makes f(x) true, where
+  ///          the cost of x is the sum of the costs of the variables set to
+  ///          true.
+  ///
+  /// \param costs The i'th element is the (finite) cost of x_i. There should be
+  ///              one for every variable in f.
+  ///
+  /// \returns The minimal cost or infinity if f is unsatisfiable.
+  ///
+  /// \see bdd_satmincost
+  //////////////////////////////////////////////////////////////////////////////
+  double bdd_mincost(const bdd &f, const weight_file &costs);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   The maximal cost of an assignment x that makes f(x) true, where
+  ///          the cost of x is the sum of the costs of the variables set to
+  ///          true.
+  ///
+  /// \param costs The i'th element is the (finite) cost of x_i. There should be
+  ///              one for every variable in f.
+  ///
+  /// \returns The maximal cost or negative infinity if f is unsatisfiable.
+  ///
+  /// \see bdd_satmaxcost
+  //////////////////////////////////////////////////////////////////////////////
+  double bdd_maxcost(const bdd &f, const weight_file &costs);
+
   /* ========================= BDD  INPUT VARIABLES ========================= */
 
   //////////////////////////////////////////////////////////////////////////////
@@ -413,6 +843,85 @@ namespace adiar
   //////////////////////////////////////////////////////////////////////////////
   assignment_file bdd_satmax(const bdd &f);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   An x of minimal cost such that f(x) is true, where the cost of x
+  ///          is the sum of the costs of the variables set to true.
+  ///
+  /// \details The best incoming arc of each node is recorded during the sweep
+  ///          of bdd_mincost. The optimal path is then traced backwards with
+  ///          O(N) extra space.
+  ///
+  /// \param costs The i'th element is the (finite) cost of x_i. There should be
+  ///              one for every variable in f.
+  ///
+  /// \returns An <tt>assignment_file</tt> with an assignment to every variable
+  ///          with a cost or an empty file if f is unsatisfiable.
+  //////////////////////////////////////////////////////////////////////////////
+  assignment_file bdd_satmincost(const bdd &f, const weight_file &costs);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   An x of maximal cost such that f(x) is true, where the cost of x
+  ///          is the sum of the costs of the variables set to true.
+  ///
+  /// \copydetails bdd_satmincost
+  //////////////////////////////////////////////////////////////////////////////
+  assignment_file bdd_satmaxcost(const bdd &f, const weight_file &costs);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief A batch of assignments, each given as a list of (label, value) in
+  ///        ascending order.
+  //////////////////////////////////////////////////////////////////////////////
+  typedef std::vector<std::vector<assignment_t>> assignment_batch;
+
+  typedef std::function<void(const assignment_batch&)> assignment_batch_func;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Enumerate all x such that f(x) is true.
+  ///
+  /// \details The BDD is walked depth-first with a stack of at most one entry
+  ///          per level and random access into its nodes, such that only the
+  ///          current batch of assignments is kept in internal memory. The
+  ///          assignments are provided in lexicographical order.
+  ///
+  /// \param cb         Callback, which is given the assignments (to every
+  ///                   variable mentioned by f) in batches.
+  ///
+  /// \param batch_size Maximum number of assignments in a batch.
+  //////////////////////////////////////////////////////////////////////////////
+  void bdd_satall(const bdd &f, const assignment_batch_func &cb, size_t batch_size = 1024u);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Enumerate all cubes of f, i.e. the traces of all paths to the
+  ///          true sink.
+  ///
+  /// \details Same as <tt>bdd_satall</tt>, except that the variables skipped
+  ///          by a path are left out of its (partial) assignment rather than
+  ///          enumerated.
+  //////////////////////////////////////////////////////////////////////////////
+  void bdd_satcubes(const bdd &f, const assignment_batch_func &cb, size_t batch_size = 1024u);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Draw k assignments x such that f(x) is true independently and
+  ///          uniformly at random.
+  ///
+  /// \details The number of assignments below each node is derived in a single
+  ///          bottom-up sweep, after which all k samples are drawn together in
+  ///          a single top-down sweep. This takes O(sort(N + k L)) I/Os rather
+  ///          than k separate walks through the BDD.
+  ///
+  /// \param k          Number of samples.
+  ///
+  /// \param rng        Source of randomness.
+  ///
+  /// \param cb         Callback, which is given the assignments (to every
+  ///                   variable mentioned by f) in batches. If f is
+  ///                   unsatisfiable, then it is never called.
+  ///
+  /// \param batch_size Maximum number of assignments in a batch.
+  //////////////////////////////////////////////////////////////////////////////
+  void bdd_sample(const bdd &f, size_t k, std::mt19937_64 &rng,
+                  const assignment_batch_func &cb, size_t batch_size = 1024u);
+
   typedef std::function<bool(label_t)> assignment_func;
 
   //////////////////////////////////////////////////////////////////////////////
@@ -436,6 +945,121 @@ namespace adiar
   //////////////////////////////////////////////////////////////////////////////
   bool bdd_eval(const bdd &f, const assignment_file &xs);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief    Evaluate a BDD according to many assignments at once.
+  ///
+  /// \details  The requests of all assignments are forwarded through the BDD
+  ///           together, such that every node is read only once per chunk of
+  ///           assignments that fits into internal memory.
+  ///
+  /// \param f        The BDD to evaluate
+  ///
+  /// \param xs       Bit-packed assignments, each of which is the
+  ///                 <tt>ceil(varcount / 64)</tt> words with the value of the
+  ///                 variable with label i as bit (i mod 64) of its (i / 64)'th
+  ///                 word.
+  ///
+  /// \param varcount The number of variables of each assignment (larger than
+  ///                 the label of any variable in f).
+  ///
+  /// \returns  Bit-packed results, where the i'th bit is the value of f on the
+  ///           i'th assignment.
+  ///
+  /// \throws std::invalid_argument If varcount is 0 but xs is not empty, since
+  ///         the number of (empty) assignments then is not defined.
+  //////////////////////////////////////////////////////////////////////////////
+  bitvector_file bdd_eval_batch(const bdd &f, const bitvector_file &xs, size_t varcount);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   A BDD flattened into an array in internal memory, which is
+  ///          evaluated on many assignments at once.
+  ///
+  /// \details The nodes are stored bottom-up, such that the children of a node
+  ///          always precede it. Assignments are bit-sliced, i.e. each 64-bit
+  ///          word holds the value of a single variable for 64 assignments.
+  ///          Hence, a single bottom-up pass over the array evaluates 64
+  ///          assignments per word (or 256 and 512 with AVX2 and AVX-512, if
+  ///          the library is compiled with support for them).
+  ///
+  /// \sa bdd_compile
+  //////////////////////////////////////////////////////////////////////////////
+  class compiled_bdd
+  {
+    friend compiled_bdd bdd_compile(const bdd &f);
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief A node with the indices of its children. The indices 0 and 1 are
+    ///        the false and true sink, whereas the i'th node has index i + 2.
+    ////////////////////////////////////////////////////////////////////////////
+    struct entry
+    {
+      label_t label;
+      uint32_t low;
+      uint32_t high;
+    };
+
+  private:
+    std::vector<entry> _nodes;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Index of the root, i.e. the last node or a sink.
+    ////////////////////////////////////////////////////////////////////////////
+    uint32_t _root = 0u;
+
+    label_t _varcount = 0u;
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Number of (non-sink) nodes.
+    ////////////////////////////////////////////////////////////////////////////
+    size_t size() const
+    { return _nodes.size(); }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief One more than the largest label in the BDD, i.e. the number of
+    ///        variables of an assignment.
+    ////////////////////////////////////////////////////////////////////////////
+    label_t varcount() const
+    { return _varcount; }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The nodes in bottom-up order.
+    ////////////////////////////////////////////////////////////////////////////
+    const std::vector<entry>& nodes() const
+    { return _nodes; }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Evaluate the BDD on <tt>64 * words</tt> assignments.
+    ///
+    /// \param xs    Bit-sliced assignments of <tt>varcount() * words</tt>
+    ///              words, where the values of the variable with label i are
+    ///              the words <tt>xs[i * words]</tt> to
+    ///              <tt>xs[(i+1) * words - 1]</tt>.
+    ///
+    /// \param words Number of words per variable.
+    ///
+    /// \param out   Output of <tt>words</tt> words, where bit j of word w is
+    ///              the value of the (64w + j)'th assignment.
+    ////////////////////////////////////////////////////////////////////////////
+    void eval_batch(const uint64_t *xs, size_t words, uint64_t *out) const;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Evaluate the BDD on <tt>64 * words</tt> assignments.
+    ///
+    /// \see eval_batch(const uint64_t*, size_t, uint64_t*)
+    ////////////////////////////////////////////////////////////////////////////
+    std::vector<uint64_t> eval_batch(const std::vector<uint64_t> &xs, size_t words) const;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Compile a BDD into its flattened form for evaluation in bulk.
+  ///
+  /// \details The compiled BDD is placed in internal memory (12 bytes per
+  ///          node), so this is only meant for BDDs that fit in RAM.
+  //////////////////////////////////////////////////////////////////////////////
+  compiled_bdd bdd_compile(const bdd &f);
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief    Get the labels of the levels of the BDD
   //////////////////////////////////////////////////////////////////////////////
@@ -456,6 +1080,42 @@ namespace adiar
   //////////////////////////////////////////////////////////////////////////////
   __bdd bdd_from(const zdd &A, const label_file &dom);
 
+  /* ============================== PERSISTENCE ============================= */
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief          Store a BDD persistently on disk.
+  ///
+  /// \param f        The BDD to store
+  ///
+  /// \param filename Path for the header of the stored BDD. Its nodes and
+  ///                 levels are stored in files next to it with the same name
+  ///                 but different suffixes. The file must not already exist.
+  ///
+  /// \throws std::invalid_argument If <tt>filename</tt> already exists.
+  ///
+  /// \sa bdd_load
+  //////////////////////////////////////////////////////////////////////////////
+  void bdd_save(const bdd &f, const std::string &filename);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief          Reopen a BDD previously stored with <tt>bdd_save</tt>.
+  ///
+  /// \param filename Path for the header of the stored BDD
+  ///
+  /// \details        The stored files are used as they are, i.e. nothing is
+  ///                 copied and the files are left on disk when the BDD is
+  ///                 garbage collected.
+  ///
+  /// \throws std::invalid_argument If <tt>filename</tt> does not exist.
+  ///
+  /// \throws std::runtime_error    If <tt>filename</tt> is not a BDD stored by
+  ///                               this version of Adiar, or if its nodes or
+  ///                               levels files are missing or do not match it.
+  ///
+  /// \sa bdd_save
+  //////////////////////////////////////////////////////////////////////////////
+  bdd bdd_load(const std::string &filename);
+
   /* ================================= DEBUG ================================ */
 
   //////////////////////////////////////////////////////////////////////////////
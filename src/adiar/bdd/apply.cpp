@@ -5,7 +5,9 @@
 #include <adiar/file_writer.h>
 
 #include <adiar/internal/assert.h>
+#include <adiar/internal/cache.h>
 #include <adiar/internal/levelized_priority_queue.h>
+#include <adiar/internal/nary_product_construction.h>
 #include <adiar/internal/product_construction.h>
 #include <adiar/internal/tuple.h>
 
@@ -33,9 +35,10 @@ namespace adiar
     }
 
   public:
+    template<typename op_t>
     static __bdd resolve_sink_root(const node_t &v1, const bdd& bdd_1,
                                    const node_t &v2, const bdd& bdd_2,
-                                   const bool_op &op)
+                                   const op_t &op)
     {
       if (is_sink(v1) && is_sink(v2)) {
         ptr_t p = op(v1.uid, v2.uid);
@@ -63,20 +66,23 @@ namespace adiar
     }
 
   public:
-    static size_t left_leaves(const bool_op &op)
+    template<typename op_t>
+    static size_t left_leaves(const op_t &op)
     {
       return !can_left_shortcut(op, create_sink_ptr(false)) +
              !can_left_shortcut(op, create_sink_ptr(true));
     }
 
-    static size_t right_leaves(const bool_op &op)
+    template<typename op_t>
+    static size_t right_leaves(const op_t &op)
     {
       return !can_right_shortcut(op, create_sink_ptr(false)) +
              !can_right_shortcut(op, create_sink_ptr(true));
     }
 
   private:
-    static tuple __resolve_request(const bool_op &op, ptr_t r1, ptr_t r2)
+    template<typename op_t>
+    static tuple __resolve_request(const op_t &op, ptr_t r1, ptr_t r2)
     {
       if (is_sink(r1) && can_left_shortcut(op, r1)) {
         return { r1, create_sink_ptr(true) };
@@ -88,7 +94,8 @@ namespace adiar
     }
 
   public:
-    static prod_rec resolve_request(const bool_op &op,
+    template<typename op_t>
+    static prod_rec resolve_request(const op_t &op,
                                     ptr_t low1, ptr_t low2,
                                     ptr_t high1, ptr_t high2)
     {
@@ -103,6 +110,43 @@ namespace adiar
 
   __bdd bdd_apply(const bdd &bdd_1, const bdd &bdd_2, const bool_op &op)
   {
-    return product_construction<apply_prod_policy>(bdd_1, bdd_2, op);
+    return cache::memoize<bdd, __bdd>(cache::key_of(cache::operation::BDD_APPLY, bdd_1, bdd_2, op), [&]() {
+      return product_construction<apply_prod_policy>(bdd_1, bdd_2, op);
+    });
+  }
+
+  class apply_nary_policy : public bdd_policy
+  {
+  public:
+    static bool is_absorbing(const bool_op &op, const ptr_t sink)
+    {
+      return can_left_shortcut(op, sink);
+    }
+
+    static bool is_neutral(const bool_op &op, const ptr_t sink)
+    {
+      return is_left_irrelevant(op, sink);
+    }
+
+  public:
+    static __bdd resolve_empty(const bool_op &op)
+    {
+      return bdd_sink(is_left_irrelevant(op, create_sink_ptr(true)));
+    }
+
+    static __bdd resolve_binary(const bdd &f, const bdd &g, const bool_op &op)
+    {
+      return bdd_apply(f, g, op);
+    }
+  };
+
+  __bdd bdd_and(const std::vector<bdd> &fs)
+  {
+    return nary_product_construction<apply_nary_policy>(fs, and_op);
+  }
+
+  __bdd bdd_or(const std::vector<bdd> &fs)
+  {
+    return nary_product_construction<apply_nary_policy>(fs, or_op);
   }
 }
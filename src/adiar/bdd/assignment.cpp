@@ -5,6 +5,9 @@
 #include <adiar/file_stream.h>
 #include <adiar/file_writer.h>
 
+#include <adiar/internal/count.h>
+#include <adiar/internal/enumerate.h>
+#include <adiar/internal/sample.h>
 #include <adiar/internal/traverse.h>
 
 namespace adiar
@@ -66,4 +69,58 @@ namespace adiar
     traverse(f,v);
     return v.get_result();
   }
+
+  template<typename semiring_t>
+  assignment_file __bdd_satcost(const bdd &f, const weight_file &costs)
+  {
+    const semiring_t sr;
+
+    simple_file<arc_t> arcs;
+    arc_t best_arc;
+    {
+      simple_file_writer<arc_t> aw(arcs);
+      semiring_sweep(f, costs, sr, aw, best_arc);
+    }
+    return semiring_reconstruct(arcs, best_arc, costs, sr);
+  }
+
+  assignment_file bdd_satmincost(const bdd &f, const weight_file &costs)
+  {
+    return __bdd_satcost<min_plus_semiring>(f, costs);
+  }
+
+  assignment_file bdd_satmaxcost(const bdd &f, const weight_file &costs)
+  {
+    return __bdd_satcost<max_plus_semiring>(f, costs);
+  }
+
+  template<bool expand_skipped>
+  void __bdd_satall(const bdd &f, const assignment_batch_func &cb, size_t batch_size)
+  {
+    enumerate_batch<assignment_t> batch(cb, batch_size);
+    enumerate_paths<expand_skipped>(f, [&batch](const std::vector<assignment_t> &path) {
+      batch.next() = path;
+    });
+    batch.flush();
+  }
+
+  void bdd_satall(const bdd &f, const assignment_batch_func &cb, size_t batch_size)
+  {
+    __bdd_satall<true>(f, cb, batch_size);
+  }
+
+  void bdd_satcubes(const bdd &f, const assignment_batch_func &cb, size_t batch_size)
+  {
+    __bdd_satall<false>(f, cb, batch_size);
+  }
+
+  void bdd_sample(const bdd &f, size_t k, std::mt19937_64 &rng,
+                  const assignment_batch_func &cb, size_t batch_size)
+  {
+    enumerate_batch<assignment_t> batch(cb, batch_size);
+    sample_paths<true>(f, k, rng, [&batch](const std::vector<assignment_t> &path) {
+      batch.next() = path;
+    });
+    batch.flush();
+  }
 }
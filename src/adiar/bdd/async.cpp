@@ -0,0 +1,93 @@
+#include <adiar/bdd.h>
+
+#include <exception>
+#include <utility>
+
+#include <adiar/internal/async.h>
+
+namespace adiar
+{
+  bdd_future::bdd_future(const bdd &f)
+    : _task(nullptr)
+  {
+    std::promise<bdd> p;
+    p.set_value(f);
+    _result = p.get_future().share();
+  }
+
+  bdd_future::bdd_future(const std::shared_future<bdd> &result,
+                         const std::shared_ptr<async::task> &task)
+    : _result(result), _task(task)
+  { }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Schedule <tt>op</tt> on the pool, once all the given inputs are
+  ///        ready. The operation is called with the (reduced) inputs.
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename op_t, typename... futures_t>
+  bdd_future __bdd_async(op_t &&op, const futures_t&... in)
+  {
+    std::shared_ptr<std::promise<bdd>> p = std::make_shared<std::promise<bdd>>();
+    std::shared_future<bdd> result = p -> get_future().share();
+
+    std::shared_ptr<async::task> t =
+      async::submit([p, op = std::forward<op_t>(op), in...]() {
+        try {
+          p -> set_value(op(in.get()...));
+        } catch (...) {
+          p -> set_exception(std::current_exception());
+        }
+      }, { in.task()... });
+
+    return bdd_future(result, t);
+  }
+
+  bdd_future bdd_apply_async(const bdd_future &f, const bdd_future &g, const bool_op &op)
+  {
+    return __bdd_async([op](const bdd &f_in, const bdd &g_in) -> bdd {
+      return bdd_apply(f_in, g_in, op);
+    }, f, g);
+  }
+
+  bdd_future bdd_ite_async(const bdd_future &f, const bdd_future &g, const bdd_future &h)
+  {
+    return __bdd_async([](const bdd &f_in, const bdd &g_in, const bdd &h_in) -> bdd {
+      return bdd_ite(f_in, g_in, h_in);
+    }, f, g, h);
+  }
+
+  bdd_future bdd_exists_async(const bdd_future &f, label_t var)
+  {
+    return __bdd_async([var](const bdd &f_in) -> bdd {
+      return bdd_exists(f_in, var);
+    }, f);
+  }
+
+  bdd_future bdd_exists_async(const bdd_future &f, const label_file &vars)
+  {
+    return __bdd_async([vars](const bdd &f_in) -> bdd {
+      return bdd_exists(f_in, vars);
+    }, f);
+  }
+
+  bdd_future bdd_forall_async(const bdd_future &f, label_t var)
+  {
+    return __bdd_async([var](const bdd &f_in) -> bdd {
+      return bdd_forall(f_in, var);
+    }, f);
+  }
+
+  bdd_future bdd_forall_async(const bdd_future &f, const label_file &vars)
+  {
+    return __bdd_async([vars](const bdd &f_in) -> bdd {
+      return bdd_forall(f_in, vars);
+    }, f);
+  }
+
+  bdd_future bdd_relprod_async(const bdd_future &f, const bdd_future &g, const label_file &vars)
+  {
+    return __bdd_async([vars](const bdd &f_in, const bdd &g_in) -> bdd {
+      return bdd_relprod(f_in, g_in, vars);
+    }, f, g);
+  }
+}
@@ -10,6 +10,7 @@
 #include <adiar/internal/convert.h>
 #include <adiar/internal/dot.h>
 #include <adiar/internal/intercut.h>
+#include <adiar/internal/io.h>
 #include <adiar/internal/reduce.h>
 #include <adiar/internal/util.h>
 
@@ -32,6 +33,8 @@ namespace adiar {
 
   bdd::bdd(__bdd &&o) : decision_diagram(reduce<bdd_policy>(std::forward<__bdd>(o))) { }
 
+  bdd::bdd(const bdd_expr &e) : bdd(e.eval()) { }
+
   bdd::bdd(bool v) : bdd(bdd_sink(v)) { }
   bdd::bdd() : bdd(false) { }
 
@@ -144,6 +147,18 @@ namespace adiar {
     return intercut<convert_decision_diagram_policy<bdd_policy, zdd_policy>>(A, dom);
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  // Persistence
+  void bdd_save(const bdd &f, const std::string &filename)
+  {
+    save(f, filename);
+  }
+
+  bdd bdd_load(const std::string &filename)
+  {
+    return bdd(load(filename));
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   // Debug
   void output_dot(const bdd &f, const std::string &file_name)
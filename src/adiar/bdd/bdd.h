@@ -9,6 +9,7 @@
 
 namespace adiar {
   class bdd;
+  class bdd_expr;
 
   //////////////////////////////////////////////////////////////////////////////
   /// \internal \brief A (possibly non-reduced) Ordered Binary Decision Diagram.
@@ -53,6 +54,7 @@ namespace adiar {
     bdd(const bdd &o);
     bdd(bdd &&o);
     bdd(__bdd &&o);
+    bdd(const bdd_expr &e);
     bdd(bool v);
 
   public:
@@ -1,5 +1,7 @@
 #include <adiar/bdd.h>
 
+#include <stdexcept>
+
 #include <adiar/data.h>
 
 #include <adiar/internal/assert.h>
@@ -9,17 +11,20 @@ namespace adiar
 {
   //////////////////////////////////////////////////////////////////////////////
   // Data structures
-  struct sat_sum : path_sum
+  template<typename value_t>
+  struct sat_sum
   {
+    uid_t uid;
+    value_t sum;
     label_t levels_visited = 0u;
   };
 
   //////////////////////////////////////////////////////////////////////////////
   // Priority queue functions
-  template<>
-  struct count_queue_lt<sat_sum>
+  template<typename value_t>
+  struct count_queue_lt<sat_sum<value_t>>
   {
-    bool operator()(const sat_sum &a, const sat_sum &b)
+    bool operator()(const sat_sum<value_t> &a, const sat_sum<value_t> &b)
     {
       return a.uid < b.uid || (a.uid == b.uid && a.levels_visited < b.levels_visited);
     }
@@ -27,19 +32,21 @@ namespace adiar
 
   //////////////////////////////////////////////////////////////////////////////
   // Helper functions
+  template<typename arithmetic_t = uint64_arithmetic>
   class sat_count_policy
   {
   public:
-    typedef sat_sum queue_t;
+    typedef arithmetic_t arith_t;
+    typedef typename arith_t::value_t value_t;
+    typedef sat_sum<value_t> queue_t;
 
     template<typename count_pq_t>
-    inline static uint64_t forward_request(count_pq_t &count_pq,
-                                           const label_t varcount,
-                                           const ptr_t child_to_resolve,
-                                           const queue_t &request)
+    inline static value_t forward_request(count_pq_t &count_pq,
+                                          const arith_t &arith,
+                                          const label_t varcount,
+                                          const ptr_t child_to_resolve,
+                                          const queue_t &request)
     {
-      adiar_debug(request.sum > 0, "No 'empty' request should be created");
-
       adiar_debug(request.levels_visited < varcount,
                   "Cannot have already visited more levels than are expected");
 
@@ -47,15 +54,17 @@ namespace adiar
 
       if (is_sink(child_to_resolve)) {
         return value_of(child_to_resolve)
-          ? request.sum * (1u << (varcount - levels_visited))
-          : 0u;
+          ? arith.shift(request.sum, varcount - levels_visited)
+          : arith.zero();
       } else {
         count_pq.push({ child_to_resolve, request.sum, levels_visited });
-        return 0u;
+        return arith.zero();
       }
     }
 
-    inline static queue_t combine_requests(const queue_t &acc, const queue_t &next)
+    inline static queue_t combine_requests(const arith_t &arith,
+                                           const queue_t &acc,
+                                           const queue_t &next)
     {
       adiar_debug(acc.uid == next.uid,
                   "Requests should be for the same node");
@@ -65,12 +74,38 @@ namespace adiar
 
       return {
         acc.uid,
-        acc.sum * (1u << (next.levels_visited - acc.levels_visited)) + next.sum,
+        arith.add(arith.shift(acc.sum, next.levels_visited - acc.levels_visited), next.sum),
         next.levels_visited
       };
     }
   };
 
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename arith_t>
+  typename arith_t::value_t __bdd_pathcount(const bdd &bdd, const arith_t &arith)
+  {
+    return is_sink(bdd)
+      ? arith.zero()
+      : count<path_count_policy<arith_t>>(bdd, bdd_varcount(bdd), arith);
+  }
+
+  template<typename arith_t>
+  typename arith_t::value_t __bdd_satcount(const bdd &bdd, label_t varcount,
+                                           const arith_t &arith)
+  {
+    if (is_sink(bdd)) {
+      // Without any variables in the domain, there are no assignments at all.
+      return value_of(bdd) && 0u < varcount
+        ? arith.shift(arith.one(), varcount)
+        : arith.zero();
+    }
+
+    adiar_assert(bdd_varcount(bdd) <= varcount,
+                 "number of variables in domain should be greater than the ones present in the BDD.");
+
+    return count<sat_count_policy<arith_t>>(bdd, varcount, arith);
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   size_t bdd_nodecount(const bdd &bdd)
   {
@@ -84,20 +119,63 @@ namespace adiar
 
   uint64_t bdd_pathcount(const bdd &bdd)
   {
-    return is_sink(bdd)
-      ? 0
-      : count<path_count_policy>(bdd, bdd_varcount(bdd));
+    return __bdd_pathcount(bdd, uint64_arithmetic());
+  }
+
+  double bdd_pathcountln(const bdd &bdd)
+  {
+    return __bdd_pathcount(bdd, log2_arithmetic());
+  }
+
+  uint64_t bdd_pathcount_mod(const bdd &bdd, uint64_t modulus)
+  {
+    if (modulus == 0u) { throw std::invalid_argument("Cannot count modulo 0"); }
+    return __bdd_pathcount(bdd, modular_arithmetic { modulus });
+  }
+
+  std::string bdd_pathcount_str(const bdd &bdd)
+  {
+    // A path visits every level at most once, so there are at most 2^levels.
+    return big_uint_dispatch(bdd_varcount(bdd) + 1u, [&bdd](const auto &arith) {
+      return __bdd_pathcount(bdd, arith).to_string();
+    });
   }
 
   uint64_t bdd_satcount(const bdd& bdd, label_t varcount)
   {
-    if (is_sink(bdd)) {
-      return value_of(bdd) ? std::min(1u, varcount) << varcount : 0u;
-    }
+    return __bdd_satcount(bdd, varcount, uint64_arithmetic());
+  }
 
-    adiar_assert(bdd_varcount(bdd) <= varcount,
-                 "number of variables in domain should be greater than the ones present in the BDD.");
+  double bdd_satcountln(const bdd& bdd, label_t varcount)
+  {
+    return __bdd_satcount(bdd, varcount, log2_arithmetic());
+  }
 
-    return count<sat_count_policy>(bdd, varcount);
+  uint64_t bdd_satcount_mod(const bdd& bdd, label_t varcount, uint64_t modulus)
+  {
+    if (modulus == 0u) { throw std::invalid_argument("Cannot count modulo 0"); }
+    return __bdd_satcount(bdd, varcount, modular_arithmetic { modulus });
+  }
+
+  std::string bdd_satcount_str(const bdd& bdd, label_t varcount)
+  {
+    return big_uint_dispatch(varcount + 1u, [&bdd, varcount](const auto &arith) {
+      return __bdd_satcount(bdd, varcount, arith).to_string();
+    });
+  }
+
+  double bdd_wmc(const bdd& bdd, const weight_file &probabilities)
+  {
+    return semiring_sweep<sum_product_semiring>(bdd, probabilities);
+  }
+
+  double bdd_mincost(const bdd& bdd, const weight_file &costs)
+  {
+    return semiring_sweep<min_plus_semiring>(bdd, costs);
+  }
+
+  double bdd_maxcost(const bdd& bdd, const weight_file &costs)
+  {
+    return semiring_sweep<max_plus_semiring>(bdd, costs);
   }
 }
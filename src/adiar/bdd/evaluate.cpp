@@ -1,10 +1,22 @@
 #include <adiar/bdd.h>
 
 #include <adiar/file_stream.h>
+#include <adiar/file_writer.h>
 
 #include <adiar/internal/assert.h>
+#include <adiar/internal/count.h>
 #include <adiar/internal/traverse.h>
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
 namespace adiar
 {
   class bdd_eval_func_visitor
@@ -72,4 +84,308 @@ namespace adiar
     traverse(bdd, v);
     return v.get_result();
   }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Batch evaluation
+  //
+  // The assignments are evaluated in chunks, each of which is loaded into
+  // internal memory. Within a chunk, a request (uid, id) for every assignment
+  // is forwarded with a levelized priority queue, such that each node is read
+  // only once per chunk.
+  struct eval_request
+  {
+    uid_t uid;
+    size_t id;
+  };
+
+  template<>
+  struct count_queue_lt<eval_request>
+  {
+    bool operator()(const eval_request &a, const eval_request &b)
+    {
+      return a.uid < b.uid || (a.uid == b.uid && a.id < b.id);
+    }
+  };
+
+  inline size_t __bdd_eval_batch_words(const size_t varcount)
+  {
+    return (varcount + 63u) / 64u;
+  }
+
+  template<typename eval_pq_t>
+  void __bdd_eval_chunk(const bdd &f,
+                        const std::vector<uint64_t> &xs,
+                        const size_t words,
+                        const size_t chunk_size,
+                        std::vector<uint64_t> &results,
+                        const size_t pq_max_memory)
+  {
+    std::fill(results.begin(), results.end(), 0u);
+
+    node_stream<> ns(f);
+    eval_pq_t eval_pq({f}, pq_max_memory, chunk_size);
+
+    const auto forward = [&](const node_t &n, const size_t id) {
+      const label_t label = label_of(n);
+      const bool value = (xs[id * words + label / 64u] >> (label % 64u)) & 1u;
+
+      const ptr_t child = value ? n.high : n.low;
+      if (is_sink(child)) {
+        results[id / 64u] |= uint64_t(value_of(child)) << (id % 64u);
+      } else {
+        eval_pq.push({ child, id });
+      }
+    };
+
+    node_t n = ns.pull();
+    for (size_t id = 0u; id < chunk_size; id++) { forward(n, id); }
+
+    // Nodes without any requests are skipped
+    while (!eval_pq.empty()) {
+      if (eval_pq.empty_level()) {
+        eval_pq.setup_next_level();
+      }
+
+      const eval_request r = eval_pq.pull();
+      while (n.uid < r.uid) { n = ns.pull(); }
+
+      adiar_debug(n.uid == r.uid, "Priority queue is out-of-sync with node stream");
+      forward(n, r.id);
+    }
+  }
+
+  template<typename eval_pq_t>
+  void __bdd_eval_batch(const bdd &f,
+                        const bitvector_file &xs,
+                        const size_t words,
+                        const size_t chunk_size,
+                        bitvector_writer &out,
+                        const size_t pq_max_memory)
+  {
+    const size_t assignments = xs.size() / words;
+
+    bitvector_stream<> in(xs);
+
+    std::vector<uint64_t> chunk(chunk_size * words);
+    std::vector<uint64_t> results(chunk_size / 64u);
+
+    for (size_t begin = 0u; begin < assignments; begin += chunk_size) {
+      const size_t size = std::min(chunk_size, assignments - begin);
+
+      for (size_t i = 0u; i < size * words; i++) { chunk[i] = in.pull(); }
+      __bdd_eval_chunk<eval_pq_t>(f, chunk, words, size, results, pq_max_memory);
+
+      const size_t result_words = (size + 63u) / 64u;
+      for (size_t i = 0u; i < result_words; i++) { out.unsafe_push(results[i]); }
+    }
+  }
+
+  bitvector_file bdd_eval_batch(const bdd &f, const bitvector_file &xs, size_t varcount)
+  {
+    const size_t words = __bdd_eval_batch_words(varcount);
+
+    // An assignment to no variables takes up no space, so the number of them
+    // in 'xs' is only well-defined if it is empty.
+    if (words == 0u) {
+      if (0u < xs.size()) {
+        throw std::invalid_argument("Cannot split 'xs' into assignments to zero variables");
+      }
+      return bitvector_file();
+    }
+
+    adiar_assert(xs.size() % words == 0u,
+                 "Given file should consist of whole assignments to 'varcount' variables");
+
+    const size_t assignments = xs.size() / words;
+
+    bitvector_file res;
+    bitvector_writer out(res);
+
+    if (is_sink(f)) {
+      const uint64_t word = value_of(f) ? ~uint64_t(0u) : 0u;
+      for (size_t i = 0u; i < assignments / 64u; i++) { out.unsafe_push(word); }
+      if (assignments % 64u != 0u) {
+        out.unsafe_push(word >> (64u - assignments % 64u));
+      }
+      return res;
+    }
+
+    if (assignments == 0u) { return res; }
+
+    adiar_assert(max_label(f) < varcount,
+                 "Given assignments should include all variables of the BDD");
+
+    // Half of the memory is given to the chunk of assignments and the other
+    // half to the priority queue. The chunk is a multiple of 64, such that the
+    // results of each chunk are whole words.
+    const size_t aux_available_memory = memory::available()
+      - node_stream<>::memory_usage()
+      - bitvector_stream<>::memory_usage()
+      - bitvector_writer::memory_usage();
+
+    const size_t chunk_memory = aux_available_memory / 2u;
+    const size_t pq_memory = aux_available_memory - chunk_memory;
+
+    const size_t max_chunk_size =
+      std::max<size_t>(64u, (chunk_memory / (words * sizeof(uint64_t) + 1u)) & ~size_t(63u));
+    const size_t chunk_size = std::min(max_chunk_size, ((assignments + 63u) / 64u) * 64u);
+
+    if (chunk_size <= count_priority_queue_t<eval_request>::memory_fits(pq_memory)) {
+      __bdd_eval_batch<count_priority_queue_t<eval_request, internal_sorter, internal_priority_queue>>
+        (f, xs, words, chunk_size, out, pq_memory);
+    } else {
+      __bdd_eval_batch<count_priority_queue_t<eval_request, external_sorter, external_priority_queue>>
+        (f, xs, words, chunk_size, out, pq_memory);
+    }
+    return res;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Compiled evaluation
+  //
+  // Each lane holds the bit-sliced values of a number of assignments. The value
+  // of a node is the 'if-then-else' of its children's values and the lane of
+  // its variable, which is computed for every node from the bottom up.
+  struct scalar_lane
+  {
+    static constexpr size_t WORDS = 1u;
+
+    uint64_t v;
+
+    static scalar_lane load(const uint64_t *p)
+    { return { *p }; }
+
+    static scalar_lane fill(bool value)
+    { return { value ? ~uint64_t(0u) : uint64_t(0u) }; }
+
+    static scalar_lane ite(const scalar_lane &x, const scalar_lane &hi, const scalar_lane &lo)
+    { return { (x.v & hi.v) | (~x.v & lo.v) }; }
+
+    void store(uint64_t *p) const
+    { *p = v; }
+  };
+
+#if defined(__AVX512F__)
+  struct simd_lane
+  {
+    static constexpr size_t WORDS = 8u;
+
+    __m512i v;
+
+    static simd_lane load(const uint64_t *p)
+    { return { _mm512_loadu_si512(p) }; }
+
+    static simd_lane fill(bool value)
+    { return { _mm512_set1_epi64(value ? -1 : 0) }; }
+
+    static simd_lane ite(const simd_lane &x, const simd_lane &hi, const simd_lane &lo)
+    { return { _mm512_ternarylogic_epi64(x.v, hi.v, lo.v, 0xCA) }; }
+
+    void store(uint64_t *p) const
+    { _mm512_storeu_si512(p, v); }
+  };
+#elif defined(__AVX2__)
+  struct simd_lane
+  {
+    static constexpr size_t WORDS = 4u;
+
+    __m256i v;
+
+    static simd_lane load(const uint64_t *p)
+    { return { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)) }; }
+
+    static simd_lane fill(bool value)
+    { return { _mm256_set1_epi64x(value ? -1 : 0) }; }
+
+    static simd_lane ite(const simd_lane &x, const simd_lane &hi, const simd_lane &lo)
+    { return { _mm256_or_si256(_mm256_and_si256(x.v, hi.v), _mm256_andnot_si256(x.v, lo.v)) }; }
+
+    void store(uint64_t *p) const
+    { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+  };
+#else
+  typedef scalar_lane simd_lane;
+#endif
+
+  template<typename lane_t>
+  void __compiled_eval(const std::vector<compiled_bdd::entry> &nodes,
+                       const uint64_t *xs, const size_t words,
+                       const size_t begin, const size_t end,
+                       uint64_t *out)
+  {
+    std::vector<lane_t> values(nodes.size() + 2u);
+    values[0] = lane_t::fill(false);
+    values[1] = lane_t::fill(true);
+
+    for (size_t w = begin; w + lane_t::WORDS <= end; w += lane_t::WORDS) {
+      for (size_t i = 0u; i < nodes.size(); i++) {
+        const compiled_bdd::entry &n = nodes[i];
+        const lane_t x = lane_t::load(xs + n.label * words + w);
+        values[i + 2u] = lane_t::ite(x, values[n.high], values[n.low]);
+      }
+      values.back().store(out + w);
+    }
+  }
+
+  void compiled_bdd::eval_batch(const uint64_t *xs, size_t words, uint64_t *out) const
+  {
+    if (_nodes.empty()) {
+      std::fill(out, out + words, _root == 1u ? ~uint64_t(0u) : uint64_t(0u));
+      return;
+    }
+
+    // Whole SIMD lanes first, and then the remaining words one at a time
+    const size_t simd_end = words - words % simd_lane::WORDS;
+    __compiled_eval<simd_lane>(_nodes, xs, words, 0u, simd_end, out);
+    __compiled_eval<scalar_lane>(_nodes, xs, words, simd_end, words, out);
+  }
+
+  std::vector<uint64_t> compiled_bdd::eval_batch(const std::vector<uint64_t> &xs, size_t words) const
+  {
+    adiar_assert(_varcount * words <= xs.size(), "Given assignments should include all variables");
+
+    std::vector<uint64_t> out(words);
+    eval_batch(xs.data(), words, out.data());
+    return out;
+  }
+
+  compiled_bdd bdd_compile(const bdd &f)
+  {
+    compiled_bdd res;
+
+    if (is_sink(f)) {
+      res._root = value_of(f) ? 1u : 0u;
+      return res;
+    }
+
+    const size_t size = f.file_ptr() -> size();
+    adiar_assert(size <= std::numeric_limits<uint32_t>::max() - 2u,
+                 "Too many nodes to index the compiled BDD");
+
+    res._nodes.reserve(size);
+    res._varcount = max_label(f) + 1u;
+
+    // The uids of the nodes (in the order of the file, i.e. descending) to look
+    // up the index of a child.
+    std::vector<uid_t> uids;
+    uids.reserve(size);
+
+    const auto index_of = [&uids](const ptr_t p) -> uint32_t {
+      if (is_sink(p)) { return value_of(p); }
+
+      const auto it = std::lower_bound(uids.begin(), uids.end(), p, std::greater<uid_t>());
+      adiar_debug(it != uids.end() && *it == p, "Children should precede their parent");
+      return (it - uids.begin()) + 2u;
+    };
+
+    node_stream<true> ns(f);
+    while (ns.can_pull()) {
+      const node_t n = ns.pull();
+      res._nodes.push_back({ label_of(n), index_of(n.low), index_of(n.high) });
+      uids.push_back(n.uid);
+    }
+
+    res._root = res._nodes.size() + 1u;
+    return res;
+  }
 }
@@ -0,0 +1,391 @@
+#include <adiar/bdd.h>
+
+#include <utility>
+#include <vector>
+
+#include <adiar/file_writer.h>
+
+#include <adiar/internal/assert.h>
+#include <adiar/internal/decision_diagram.h>
+#include <adiar/internal/util.h>
+
+namespace adiar
+{
+  typedef bdd_expr::node::op_t expr_op;
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Constructors
+  bdd_expr::bdd_expr(const bdd &f)
+    : _root(std::make_shared<node>(node { expr_op::LEAF, f, {}, {} }))
+  { }
+
+  bdd_expr::bdd_expr(std::shared_ptr<node> root, bool negate)
+    : _root(std::move(root)), _negate(negate)
+  { }
+
+  bdd_expr::node::~node()
+  {
+    // Destroying a long chain of expressions recursively would overflow the
+    // stack. Hence, the operands not shared with anyone else are moved out and
+    // destroyed one at a time, each after having moved out its own operands.
+    std::vector<std::shared_ptr<node>> worklist;
+
+    const auto release = [&worklist](std::vector<bdd_expr> &args) {
+      for (bdd_expr &a : args) {
+        if (a._root.use_count() == 1) { worklist.push_back(std::move(a._root)); }
+      }
+      args.clear();
+    };
+
+    release(args);
+    while (!worklist.empty()) {
+      std::shared_ptr<node> n = std::move(worklist.back());
+      worklist.pop_back();
+      release(n -> args);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Building the DAG
+  bool __sink_value(const bdd_expr &e, bool &value)
+  {
+    const std::optional<bdd> &leaf = e.root() -> leaf;
+    if (!leaf || !is_sink(*leaf)) { return false; }
+
+    value = e.negated() ^ value_of(*leaf);
+    return true;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Add <tt>e</tt> as an operand of <tt>op</tt>, flattening it into
+  ///        <tt>args</tt> if possible.
+  ///
+  /// \returns Whether the operation still is worth computing, i.e. false if
+  ///          <tt>e</tt> is the absorbing constant of <tt>op</tt>.
+  //////////////////////////////////////////////////////////////////////////////
+  bool __add_operand(expr_op op, std::vector<bdd_expr> &args, bool &negate,
+                     const bdd_expr &e)
+  {
+    // Neutral constants are dropped and absorbing ones short-circuit.
+    bool value;
+    if (__sink_value(e, value)) {
+      switch (op) {
+      case expr_op::AND: return value;
+      case expr_op::OR:  return !value;
+      default:           negate ^= value; return true;
+      }
+    }
+
+    const bdd_expr::node &n = *e.root();
+
+    // As x ^ ~y = ~(x ^ y), the negation of an operand of a 'xor' is moved to
+    // its result.
+    if (op == expr_op::XOR) {
+      negate ^= e.negated();
+
+      if (!n.leaf && n.op == expr_op::XOR && e.root().use_count() == 1) {
+        args.insert(args.end(), n.args.begin(), n.args.end());
+      } else {
+        args.push_back(bdd_expr(e.root()));
+      }
+      return true;
+    }
+
+    // A shared subexpression is kept as is, such that it is computed only once.
+    if (n.leaf || e.root().use_count() > 1) {
+      args.push_back(e);
+      return true;
+    }
+
+    // x & (y & z) = x & y & z
+    if (n.op == op && !e.negated()) {
+      args.insert(args.end(), n.args.begin(), n.args.end());
+      return true;
+    }
+
+    // x & ~(y | z) = x & ~y & ~z
+    const expr_op dual_op = op == expr_op::AND ? expr_op::OR : expr_op::AND;
+    if (n.op == dual_op && e.negated()) {
+      for (const bdd_expr &a : n.args) { args.push_back(~a); }
+      return true;
+    }
+
+    args.push_back(e);
+    return true;
+  }
+
+  bdd_expr __make(expr_op op, std::vector<bdd_expr> &&args, bool negate)
+  {
+    if (args.size() == 0u) {
+      // The operation only consisted of neutral constants.
+      return bdd_expr(bdd_sink((op == expr_op::AND) ^ negate));
+    }
+    if (args.size() == 1u) {
+      return bdd_expr(args[0].root(), args[0].negated() ^ negate);
+    }
+    return bdd_expr(std::make_shared<bdd_expr::node>(bdd_expr::node {
+          op, std::nullopt, std::move(args), std::nullopt
+        }), negate);
+  }
+
+  bdd_expr __combine(expr_op op, const bdd_expr &lhs, const bdd_expr &rhs)
+  {
+    std::vector<bdd_expr> args;
+    bool negate = false;
+
+    if (!__add_operand(op, args, negate, lhs) || !__add_operand(op, args, negate, rhs)) {
+      return bdd_expr(bdd_sink(op == expr_op::OR));
+    }
+    return __make(op, std::move(args), negate);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Add <tt>e</tt> to the operation of <tt>acc</tt>. If no other
+  ///        expression refers to it, then its operands are extended in-place,
+  ///        such that accumulating <i>n</i> operands takes linear time.
+  //////////////////////////////////////////////////////////////////////////////
+  void __accumulate(expr_op op, bdd_expr &acc, const bdd_expr &e)
+  {
+    bdd_expr::node &n = *acc.root();
+
+    const bool in_place = !n.leaf && n.op == op && acc.root().use_count() == 1
+      && (op == expr_op::XOR || !acc.negated());
+
+    if (!in_place) {
+      acc = __combine(op, acc, e);
+      return;
+    }
+
+    bool negate = acc.negated();
+    if (!__add_operand(op, n.args, negate, e)) {
+      acc = bdd_expr(bdd_sink(op == expr_op::OR));
+      return;
+    }
+    acc = bdd_expr(acc.root(), negate);
+  }
+
+  bdd_expr __quantify(expr_op op, const bdd_expr &f, const label_file &vars)
+  {
+    bool value;
+    if (__sink_value(f, value)) { return f; }
+
+    return bdd_expr(std::make_shared<bdd_expr::node>(bdd_expr::node {
+          op, std::nullopt, { f }, vars
+        }));
+  }
+
+  label_file __single_label(label_t var)
+  {
+    label_file vars;
+    {
+      label_writer lw(vars);
+      lw << var;
+    }
+    return vars;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Operators
+  //
+  // The operands are taken by value, such that a temporary expression is
+  // moved into them. This way, its use count is one exactly if it is not
+  // shared with any other expression and so may be flattened.
+  bdd_expr operator~ (bdd_expr f)
+  {
+    return bdd_expr(std::move(f._root), !f._negate);
+  }
+
+#define __bdd_expr_oper(op, op_enum)                                         \
+  bdd_expr operator op (bdd_expr lhs, bdd_expr rhs) {                        \
+    return __combine(op_enum, lhs, rhs);                                     \
+  }                                                                          \
+                                                                             \
+  bdd_expr operator op (bdd_expr lhs, const bdd &rhs) {                      \
+    return __combine(op_enum, lhs, bdd_expr(rhs));                           \
+  }                                                                          \
+                                                                             \
+  bdd_expr operator op (const bdd &lhs, bdd_expr rhs) {                      \
+    return __combine(op_enum, bdd_expr(lhs), rhs);                           \
+  }                                                                          \
+                                                                             \
+  bdd_expr operator op (bdd_expr lhs, __bdd &&rhs) {                         \
+    return __combine(op_enum, lhs, bdd_expr(bdd(std::forward<__bdd>(rhs)))); \
+  }                                                                          \
+                                                                             \
+  bdd_expr operator op (__bdd &&lhs, bdd_expr rhs) {                         \
+    return __combine(op_enum, bdd_expr(bdd(std::forward<__bdd>(lhs))), rhs); \
+  }                                                                          \
+                                                                             \
+  bdd_expr& bdd_expr::operator op##= (bdd_expr other) {                      \
+    __accumulate(op_enum, *this, other);                                     \
+    return *this;                                                            \
+  }                                                                          \
+                                                                             \
+  bdd_expr& bdd_expr::operator op##= (const bdd &other) {                    \
+    __accumulate(op_enum, *this, bdd_expr(other));                          \
+    return *this;                                                            \
+  }
+
+  __bdd_expr_oper(&, expr_op::AND)
+  __bdd_expr_oper(|, expr_op::OR)
+  __bdd_expr_oper(^, expr_op::XOR)
+
+  bdd_expr bdd_exists(const bdd_expr &f, label_t var)
+  {
+    return __quantify(expr_op::EXISTS, f, __single_label(var));
+  }
+
+  bdd_expr bdd_exists(const bdd_expr &f, const label_file &vars)
+  {
+    return __quantify(expr_op::EXISTS, f, vars);
+  }
+
+  bdd_expr bdd_forall(const bdd_expr &f, label_t var)
+  {
+    return __quantify(expr_op::FORALL, f, __single_label(var));
+  }
+
+  bdd_expr bdd_forall(const bdd_expr &f, const label_file &vars)
+  {
+    return __quantify(expr_op::FORALL, f, vars);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Evaluation
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Whether <tt>n</tt> (negated if <tt>negate</tt>) is a conjunction
+  ///        that is yet to be computed, i.e. f_1 & ... & f_k or ~(f_1 | ... |
+  ///        f_k) = ~f_1 & ... & ~f_k.
+  //////////////////////////////////////////////////////////////////////////////
+  bool __is_conjunction(const bdd_expr::node &n, bool negate)
+  {
+    return !n.leaf
+      && ((n.op == expr_op::AND && !negate) || (n.op == expr_op::OR && negate));
+  }
+
+  bdd __exists(const bdd_expr &f, const label_file &vars)
+  {
+    const bdd_expr::node &n = *f.root();
+
+    // Quantification of f_1 & ... & f_k is computed as the relational product
+    // of f_1 & ... & f_k-1 and f_k, where the first conjunction is computed
+    // with a single n-ary product construction.
+    if (!__is_conjunction(n, f.negated())) {
+      return bdd_exists(f.eval(), vars);
+    }
+
+    std::vector<bdd> fs;
+    for (const bdd_expr &a : n.args) {
+      fs.push_back(f.negated() ? (~a).eval() : a.eval());
+    }
+    adiar_debug(fs.size() > 1u, "A conjunction has at least two operands");
+
+    const bdd g = fs.back();
+    fs.pop_back();
+
+    const bdd f_rest = fs.size() == 1u ? fs[0] : bdd(bdd_and(fs));
+
+    // Unlike bdd_exists, the relational product needs its variables in
+    // ascending order.
+    return bdd_relprod(f_rest, g, sorted_labels(vars));
+  }
+
+  bdd __compute(const bdd_expr::node &n)
+  {
+    std::vector<bdd> fs;
+
+    switch (n.op) {
+    case expr_op::AND:
+    case expr_op::OR:
+      for (const bdd_expr &a : n.args) { fs.push_back(a.eval()); }
+      return n.op == expr_op::AND ? bdd_and(fs) : bdd_or(fs);
+
+    case expr_op::XOR:
+      // There is no n-ary product construction for 'xor', so the operands are
+      // combined pairwise in a balanced tree.
+      for (const bdd_expr &a : n.args) { fs.push_back(a.eval()); }
+      while (fs.size() > 1u) {
+        std::vector<bdd> next;
+        for (size_t i = 0u; i + 1u < fs.size(); i += 2u) {
+          next.push_back(bdd_xor(fs[i], fs[i+1u]));
+        }
+        if (fs.size() % 2u == 1u) { next.push_back(fs.back()); }
+        fs = std::move(next);
+      }
+      return fs[0];
+
+    case expr_op::EXISTS:
+      return __exists(n.args[0], *n.vars);
+
+    case expr_op::FORALL:
+      // forall x : f = ~(exists x : ~f)
+      return bdd_not(__exists(~n.args[0], *n.vars));
+
+    default:
+      adiar_unreachable();
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Add the nodes that <tt>__compute(n)</tt> evaluates to
+  ///        <tt>worklist</tt>. In the case of a quantified conjunction, these
+  ///        are the operands of the conjunction rather than the conjunction.
+  //////////////////////////////////////////////////////////////////////////////
+  void __push_operands(const bdd_expr::node &n,
+                       std::vector<std::pair<bdd_expr::node*, bool>> &worklist)
+  {
+    const bool is_quantification = n.op == expr_op::EXISTS || n.op == expr_op::FORALL;
+
+    if (is_quantification) {
+      const bdd_expr &f = n.args[0];
+      const bool negate = f.negated() ^ (n.op == expr_op::FORALL);
+
+      if (__is_conjunction(*f.root(), negate)) {
+        __push_operands(*f.root(), worklist);
+        return;
+      }
+    }
+
+    for (const bdd_expr &a : n.args) {
+      if (!a.root() -> leaf) { worklist.push_back({ a.root().get(), false }); }
+    }
+  }
+
+  bdd bdd_expr::eval() const
+  {
+    // The DAG is computed bottom-up with an explicit worklist rather than by
+    // recursion, such that a deep expression does not overflow the stack. Each
+    // node is on it twice: first to add its operands and then, after these
+    // have been computed, to compute itself.
+    std::vector<std::pair<node*, bool>> worklist;
+    worklist.push_back({ _root.get(), false });
+
+    while (!worklist.empty()) {
+      const std::pair<node*, bool> top = worklist.back();
+      node &n = *top.first;
+
+      // Already computed, e.g. as the operand of another node.
+      if (n.leaf) {
+        worklist.pop_back();
+        continue;
+      }
+
+      if (!top.second) {
+        worklist.back().second = true;
+        __push_operands(n, worklist);
+        continue;
+      }
+
+      worklist.pop_back();
+      n.leaf = __compute(n);
+
+      // Release the operands, such that their files can be garbage collected.
+      n.args.clear();
+      n.vars.reset();
+    }
+
+    const node &n = *_root;
+    return _negate ? bdd_not(*n.leaf) : *n.leaf;
+  }
+}
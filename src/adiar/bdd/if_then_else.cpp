@@ -14,7 +14,7 @@ namespace adiar
 {
   //////////////////////////////////////////////////////////////////////////////
   // Struct to hold statistics
-  stats_t::if_else_t stats_if_else;
+  thread_local stats_t::if_else_t stats_if_else;
 
   //////////////////////////////////////////////////////////////////////////////
   // Data structures
@@ -240,7 +240,7 @@ namespace adiar
     arc_file out_arcs;
     arc_writer aw(out_arcs);
 
-    pq_1_t ite_pq_1({bdd_if, bdd_then, bdd_else}, pq_1_memory, max_pq_size);
+    pq_1_t ite_pq_1({bdd_if, bdd_then, bdd_else}, pq_1_memory, max_pq_size, &stats_if_else);
     pq_2_t ite_pq_2(pq_2_memory, max_pq_size);
     pq_3_t ite_pq_3(pq_3_memory, max_pq_size);
 
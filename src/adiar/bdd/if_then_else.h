@@ -5,7 +5,7 @@ namespace adiar {
 
   //////////////////////////////////////////////////////////////////////////////
   /// Struct to hold statistics
-  extern stats_t::if_else_t stats_if_else;
+  extern thread_local stats_t::if_else_t stats_if_else;
 
 }
 
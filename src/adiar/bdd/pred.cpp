@@ -7,4 +7,9 @@ namespace adiar
     {
         return is_isomorphic(f, g);
     }
+
+    uint64_t bdd_hash(const bdd &f)
+    {
+        return hash_of(f);
+    }
 }
\ No newline at end of file
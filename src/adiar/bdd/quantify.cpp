@@ -7,6 +7,10 @@
 #include <adiar/file_writer.h>
 
 #include <adiar/internal/assert.h>
+#include <adiar/internal/cache.h>
+#include <adiar/internal/levelized_priority_queue.h>
+#include <adiar/internal/memory.h>
+#include <adiar/internal/nary_product_construction.h>
 #include <adiar/internal/quantify.h>
 #include <adiar/internal/tuple.h>
 
@@ -44,6 +48,307 @@ namespace adiar
     }
   };
 
+  //////////////////////////////////////////////////////////////////////////////
+  // Data structures
+  //
+  // A request for quantifying multiple variables in a single sweep is the
+  // (or/and) combination of up to QUANTIFY_MAX_NODES many nodes of the input.
+  // The nodes are kept sorted and the unused positions are NIL.
+  //
+  // Quantifying a variable doubles the number of nodes (before simplification)
+  // and so requests keep resolving through consecutive quantified levels. If
+  // the nodes do not fit into a request, then a node for the variable is output
+  // instead and the variable is quantified afterwards.
+  constexpr size_t QUANTIFY_MAX_NODES = 8u;
+
+  struct multi_quantify_tuple
+  {
+    ptr_t t[QUANTIFY_MAX_NODES];
+  };
+
+  inline ptr_t fst(const multi_quantify_tuple &t)
+  {
+    return t.t[0];
+  }
+
+  inline bool operator== (const multi_quantify_tuple &a, const multi_quantify_tuple &b)
+  {
+    return std::equal(a.t, a.t + QUANTIFY_MAX_NODES, b.t);
+  }
+
+  struct multi_quantify_tuple_label
+  {
+    static inline label_t label_of(const multi_quantify_tuple &t)
+    {
+      return adiar::label_of(fst(t));
+    }
+  };
+
+  struct multi_quantify_request : multi_quantify_tuple
+  {
+    ptr_t source;
+  };
+
+  struct multi_quantify_request_lt
+    : public std::binary_function<multi_quantify_request, multi_quantify_request, bool>
+  {
+    bool operator()(const multi_quantify_request &a, const multi_quantify_request &b)
+    {
+      // Sort primarily by the element to be encountered first and then group
+      // requests to the same tuple together.
+      for (size_t idx = 0u; idx < QUANTIFY_MAX_NODES; idx++) {
+        if (a.t[idx] != b.t[idx]) { return a.t[idx] < b.t[idx]; }
+      }
+#ifndef NDEBUG
+      return a.source < b.source;
+#else
+      return false;
+#endif
+    }
+  };
+
+  template<template<typename, typename> typename sorter_template,
+           template<typename, typename> typename priority_queue_template>
+  using multi_quantify_priority_queue_t =
+    levelized_label_priority_queue<multi_quantify_request, multi_quantify_tuple_label,
+                                   multi_quantify_request_lt,
+                                   sorter_template, priority_queue_template>;
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Helper functions
+
+  // Simplifies the combination of the 'n' first pointers. Returns the number of
+  // nodes left. If none are left, then the combination has collapsed to the
+  // sink placed in 'out_sink'.
+  inline size_t multi_quantify_simplify(const bool_op &op, ptr_t *ps, const size_t n,
+                                        ptr_t &out_sink)
+  {
+    size_t out_n = 0u;
+
+    for (size_t idx = 0u; idx < n; idx++) {
+      if (is_sink(ps[idx])) {
+        out_sink = ps[idx];
+        if (can_left_shortcut(op, ps[idx])) { return 0u; }
+
+        adiar_debug(is_left_irrelevant(op, ps[idx]),
+                    "A sink either shortcuts or is irrelevant for an idempotent operator");
+        continue;
+      }
+      ps[out_n++] = ps[idx];
+    }
+
+    std::sort(ps, ps + out_n);
+    out_n = std::unique(ps, ps + out_n) - ps;
+
+    return out_n;
+  }
+
+  inline multi_quantify_tuple multi_quantify_pack(const ptr_t *ps, const size_t n)
+  {
+    adiar_debug(n <= QUANTIFY_MAX_NODES, "Too many nodes for a single request");
+
+    multi_quantify_tuple t;
+    for (size_t idx = 0u; idx < QUANTIFY_MAX_NODES; idx++) {
+      t.t[idx] = idx < n ? ps[idx] : NIL;
+    }
+    return t;
+  }
+
+  // Places the low (high) cofactors of all nodes in 'low' ('high') and returns
+  // how many nodes there are.
+  inline size_t multi_quantify_cofactors(const multi_quantify_tuple &t,
+                                         const label_t level,
+                                         const std::vector<node_t> &level_nodes,
+                                         ptr_t *low, ptr_t *high)
+  {
+    size_t n = 0u;
+    for (; n < QUANTIFY_MAX_NODES && !is_nil(t.t[n]); n++) {
+      if (label_of(t.t[n]) == level) {
+        const node_t &v = nary_find(level_nodes, t.t[n]);
+        low[n]  = v.low;
+        high[n] = v.high;
+      } else {
+        low[n]  = t.t[n];
+        high[n] = t.t[n];
+      }
+    }
+    return n;
+  }
+
+  template<typename pq_t>
+  inline void multi_quantify_recurse_out(pq_t &quantify_pq, arc_writer &aw,
+                                         const bool_op &op, const ptr_t source,
+                                         ptr_t *ps, const size_t n)
+  {
+    ptr_t out_sink = NIL;
+    const size_t out_n = multi_quantify_simplify(op, ps, n, out_sink);
+
+    if (out_n == 0u) {
+      aw.unsafe_push_sink({ source, out_sink });
+    } else {
+      quantify_pq.push({ multi_quantify_pack(ps, out_n), source });
+    }
+  }
+
+  inline bool multi_quantify_is_quantified(label_stream<> &vars, const label_t level)
+  {
+    while (vars.can_pull() && vars.peek() < level) { vars.pull(); }
+    return vars.can_pull() && vars.peek() == level;
+  }
+
+  template<typename pq_t>
+  __bdd __bdd_multi_quantify(const bdd &in,
+                             const label_file &vars,
+                             const label_file &levels,
+                             const bool_op &op,
+                             label_file &deferred,
+                             const size_t pq_memory,
+                             const size_t max_pq_size)
+  {
+    std::unique_ptr<node_stream<>> in_nodes [1];
+    std::vector<node_t> level_nodes [1];
+
+    in_nodes[0] = std::make_unique<node_stream<>>(in);
+
+    ptr_t low [2 * QUANTIFY_MAX_NODES];
+    ptr_t high [2 * QUANTIFY_MAX_NODES];
+
+    low[0] = in_nodes[0] -> peek().uid;
+
+    multi_quantify_tuple t = multi_quantify_pack(low, 1u);
+    ptr_t source = NIL;
+
+    // Set-up for Quantification Algorithm
+    arc_file out_arcs;
+    arc_writer aw(out_arcs);
+
+    label_writer dw(deferred);
+
+    pq_t quantify_pq({levels}, pq_memory, max_pq_size, &stats_quantify);
+
+    label_stream<> in_vars(vars);
+
+    label_t out_label = label_of(fst(t));
+    id_t out_id = 0;
+
+    nary_setup_level(in_nodes, level_nodes, 1u, out_label);
+    bool quantify = multi_quantify_is_quantified(in_vars, out_label);
+    bool is_deferred = false;
+
+    size_t max_1level_cut = 0;
+
+    // Process requests in topological order. The first one is the root.
+    while (true) {
+      const size_t n = multi_quantify_cofactors(t, out_label, level_nodes[0], low, high);
+
+      // Try to quantify the variable by forwarding the combination of both
+      // cofactors to the children of all sources.
+      bool resolved = false;
+      if (quantify) {
+        std::copy(high, high + n, low + n);
+
+        ptr_t out_sink = NIL;
+        const size_t out_n = multi_quantify_simplify(op, low, 2u * n, out_sink);
+
+        if (out_n == 0u) {
+          // Quantification of the root collapsed into a sink
+          if (is_nil(source)) { return nary_sink(out_sink); }
+
+          aw.unsafe_push_sink({ source, out_sink });
+          while (quantify_pq.can_pull() && quantify_pq.top() == t) {
+            aw.unsafe_push_sink({ quantify_pq.pull().source, out_sink });
+          }
+
+          resolved = true;
+        } else if (out_n <= QUANTIFY_MAX_NODES) {
+          const multi_quantify_tuple r = multi_quantify_pack(low, out_n);
+
+          quantify_pq.push({ r, source });
+          while (quantify_pq.can_pull() && quantify_pq.top() == t) {
+            quantify_pq.push({ r, quantify_pq.pull().source });
+          }
+
+          resolved = true;
+        } else {
+          if (!is_deferred) {
+#ifdef ADIAR_STATS
+            stats_quantify.multi_deferred++;
+#endif
+            dw << out_label;
+            is_deferred = true;
+          }
+
+          // Too many nodes: recompute the cofactors overwritten above and
+          // output the variable to be quantified afterwards.
+          multi_quantify_cofactors(t, out_label, level_nodes[0], low, high);
+        }
+      }
+
+      // Output a node for the combination of the nodes.
+      if (!resolved) {
+        adiar_debug(out_id < MAX_ID, "Has run out of ids");
+        const uid_t out_uid = create_node_uid(out_label, out_id++);
+
+        multi_quantify_recurse_out(quantify_pq, aw, op, out_uid, low, n);
+        multi_quantify_recurse_out(quantify_pq, aw, op, flag(out_uid), high, n);
+
+        if (!is_nil(source)) {
+          aw.unsafe_push_node({ source, out_uid });
+        }
+        while (quantify_pq.can_pull() && quantify_pq.top() == t) {
+          aw.unsafe_push_node({ quantify_pq.pull().source, out_uid });
+        }
+      }
+
+      if (quantify_pq.empty()) { break; }
+
+      if (quantify_pq.empty_level()) {
+        if (out_id > 0) {
+          aw.unsafe_push(create_level_info(out_label, out_id));
+        }
+
+        quantify_pq.setup_next_level();
+        out_label = quantify_pq.current_level();
+        out_id = 0;
+
+        nary_setup_level(in_nodes, level_nodes, 1u, out_label);
+        quantify = multi_quantify_is_quantified(in_vars, out_label);
+        is_deferred = false;
+
+        max_1level_cut = std::max(max_1level_cut, quantify_pq.size());
+      }
+
+      const multi_quantify_request r = quantify_pq.pull();
+      t = r;
+      source = r.source;
+    }
+
+    // Push the level of the very last iteration
+    if (out_id > 0) {
+      aw.unsafe_push(create_level_info(out_label, out_id));
+    }
+
+    out_arcs._file_ptr->max_1level_cut = max_1level_cut;
+
+    return out_arcs;
+  }
+
+  size_t __bdd_multi_quantify_max_cut_upper_bound(const bdd &in)
+  {
+    constexpr size_t max_bits = sizeof(size_t) * 8;
+
+    const size_t nodes = in.file_ptr()->size() + 2;
+    const size_t node_bits = bits_approximation(nodes).bits;
+
+    if (max_bits <= node_bits * QUANTIFY_MAX_NODES) {
+      return std::numeric_limits<size_t>::max();
+    }
+
+    size_t bound = 1u;
+    for (size_t idx = 0u; idx < QUANTIFY_MAX_NODES; idx++) { bound *= nodes; }
+    return bound + 2;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
 # define multi_quantify_macro(bdd_var, labels, op)                  \
   if (labels.size() == 0) { return bdd_var; }                       \
@@ -59,6 +364,111 @@ namespace adiar
     }                                                               \
   }                                                                 \
 
+  __bdd __bdd_quantify_per_label(bdd &&f, const label_file &labels, const bool_op &op)
+  {
+    multi_quantify_macro(f, labels, op);
+  }
+
+  // Sort the variables and only keep the ones that occur in f. The number of
+  // bytes needed for the widest level of f is placed in 'levels_memory'.
+  inline label_file __bdd_multi_quantify_vars(const bdd &f, const label_file &labels,
+                                              label_file &levels, size_t &levels_memory)
+  {
+    std::vector<label_t> vars;
+    {
+      label_stream<> ls(labels);
+      while (ls.can_pull()) { vars.push_back(ls.pull()); }
+    }
+    std::sort(vars.begin(), vars.end());
+
+    const bdd in[1] = { f };
+    levels_memory = __nary_levels(in, 1u, levels);
+
+    label_file out;
+    label_writer lw(out);
+
+    label_stream<> ls(levels);
+    auto it = vars.begin();
+    while (ls.can_pull() && it != vars.end()) {
+      const label_t l = ls.pull();
+      while (it != vars.end() && *it < l) { it++; }
+      if (it != vars.end() && *it == l) { lw << l; }
+    }
+    return out;
+  }
+
+  __bdd __bdd_quantify(bdd &&f, const label_file &labels, const bool_op &op)
+  {
+    if (is_sink(f) || labels.size() <= 1) {
+      return __bdd_quantify_per_label(std::move(f), labels, op);
+    }
+
+    // Only idempotent operators allow collapsing duplicate nodes in a request.
+    const ptr_t sink_F = create_sink_ptr(false);
+    const ptr_t sink_T = create_sink_ptr(true);
+    if (op(sink_F, sink_F) != sink_F || op(sink_T, sink_T) != sink_T) {
+      return __bdd_quantify_per_label(std::move(f), labels, op);
+    }
+
+    label_file levels;
+    size_t levels_memory;
+    const label_file vars = __bdd_multi_quantify_vars(f, labels, levels, levels_memory);
+
+    // The per-variable sweep wins if at most one variable is to be quantified.
+    if (vars.size() <= 1) {
+      return __bdd_quantify_per_label(std::move(f), vars, op);
+    }
+
+    // Compute amount of memory available for auxiliary data structures after
+    // having opened all streams.
+    const size_t available_memory = memory::available()
+      // Input stream
+      - node_stream<>::memory_usage()
+      // Quantified variables
+      - label_stream<>::memory_usage()
+      // Output streams
+      - arc_writer::memory_usage()
+      - label_writer::memory_usage();
+
+    // Fall back to one sweep per variable, if not a single level of f can be
+    // kept in memory.
+    if (available_memory / NARY_LEVELS_MEMORY_FRACTION < levels_memory) {
+#ifdef ADIAR_STATS
+      stats_quantify.multi_fallbacks++;
+#endif
+      return __bdd_quantify_per_label(std::move(f), vars, op);
+    }
+
+#ifdef ADIAR_STATS
+    stats_quantify.multi_sweeps++;
+#endif
+
+    const size_t pq_memory = available_memory - levels_memory;
+    const size_t max_pq_size = __bdd_multi_quantify_max_cut_upper_bound(f);
+
+    const bool internal_memory =
+      max_pq_size <= multi_quantify_priority_queue_t<internal_sorter, internal_priority_queue>::memory_fits(pq_memory);
+
+#ifdef ADIAR_STATS
+    if (internal_memory) {
+      stats_quantify.lpq_internal++;
+    } else {
+      stats_quantify.lpq_external++;
+    }
+#endif
+
+    label_file deferred;
+
+    bdd out = internal_memory
+      ? __bdd_multi_quantify<multi_quantify_priority_queue_t<internal_sorter, internal_priority_queue>>
+          (f, vars, levels, op, deferred, pq_memory, max_pq_size)
+      : __bdd_multi_quantify<multi_quantify_priority_queue_t<external_sorter, external_priority_queue>>
+          (f, vars, levels, op, deferred, pq_memory, max_pq_size);
+
+    // Quantify the variables that had too many nodes to be quantified above.
+    return __bdd_quantify_per_label(std::move(out), deferred, op);
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   __bdd bdd_exists(const bdd &in_bdd, label_t label)
   {
@@ -67,13 +477,17 @@ namespace adiar
 
   __bdd bdd_exists(const bdd &in_bdd, const label_file &labels)
   {
-    bdd out = in_bdd;
-    multi_quantify_macro(out, labels, or_op);
+    return cache::memoize<bdd, __bdd>(cache::key_of(cache::operation::BDD_EXISTS, in_bdd, labels), [&]() {
+      bdd out = in_bdd;
+      return __bdd_quantify(std::move(out), labels, or_op);
+    });
   }
 
   __bdd bdd_exists(bdd &&in_bdd, const label_file &labels)
   {
-    multi_quantify_macro(in_bdd, labels, or_op);
+    return cache::memoize<bdd, __bdd>(cache::key_of(cache::operation::BDD_EXISTS, in_bdd, labels), [&]() {
+      return __bdd_quantify(std::move(in_bdd), labels, or_op);
+    });
   }
 
   __bdd bdd_forall(const bdd &in_bdd, label_t label)
@@ -83,12 +497,16 @@ namespace adiar
 
   __bdd bdd_forall(const bdd &in_bdd, const label_file &labels)
   {
-    bdd out = in_bdd;
-    multi_quantify_macro(out, labels, and_op);
+    return cache::memoize<bdd, __bdd>(cache::key_of(cache::operation::BDD_FORALL, in_bdd, labels), [&]() {
+      bdd out = in_bdd;
+      return __bdd_quantify(std::move(out), labels, and_op);
+    });
   }
 
   __bdd bdd_forall(bdd &&in_bdd, const label_file &labels)
   {
-    multi_quantify_macro(in_bdd, labels, and_op);
+    return cache::memoize<bdd, __bdd>(cache::key_of(cache::operation::BDD_FORALL, in_bdd, labels), [&]() {
+      return __bdd_quantify(std::move(in_bdd), labels, and_op);
+    });
   }
 }
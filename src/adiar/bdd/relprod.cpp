@@ -0,0 +1,390 @@
+#include <adiar/bdd.h>
+#include <adiar/bdd/bdd_policy.h>
+
+#include <adiar/data.h>
+
+#include <adiar/file_stream.h>
+#include <adiar/file_writer.h>
+
+#include <adiar/internal/assert.h>
+#include <adiar/internal/levelized_priority_queue.h>
+#include <adiar/internal/memory.h>
+#include <adiar/internal/nary_product_construction.h>
+#include <adiar/internal/product_construction.h>
+#include <adiar/internal/tuple.h>
+#include <adiar/internal/util.h>
+
+namespace adiar
+{
+  //////////////////////////////////////////////////////////////////////////////
+  // Data structures
+  //
+  // A request is the disjunction of up to RELPROD_MAX_PAIRS many conjunctions
+  // f_i /\ g_i where t1 is a node (or sink) of f and t2 of g. The pairs are kept
+  // sorted and the unused ones are (NIL, NIL).
+  //
+  // Quantifying a variable doubles the number of pairs (before simplification).
+  // If they do not fit into a request, then a node for the variable is output
+  // instead and the variable is quantified afterwards.
+  constexpr size_t RELPROD_MAX_PAIRS = 4u;
+
+  struct relprod_tuple
+  {
+    tuple pairs[RELPROD_MAX_PAIRS];
+  };
+
+  inline ptr_t fst(const relprod_tuple &t)
+  {
+    ptr_t min = NIL;
+    for (const tuple &p : t.pairs) { min = std::min({ min, p.t1, p.t2 }); }
+    return min;
+  }
+
+  inline bool relprod_same_pairs(const relprod_tuple &a, const relprod_tuple &b)
+  {
+    return std::equal(a.pairs, a.pairs + RELPROD_MAX_PAIRS, b.pairs);
+  }
+
+  struct relprod_tuple_label
+  {
+    static inline label_t label_of(const relprod_tuple &t)
+    {
+      return adiar::label_of(fst(t));
+    }
+  };
+
+  struct relprod_request : relprod_tuple
+  {
+    ptr_t source;
+  };
+
+  struct relprod_request_lt : public std::binary_function<relprod_request, relprod_request, bool>
+  {
+    bool operator()(const relprod_request &a, const relprod_request &b)
+    {
+      const ptr_t fst_a = fst(a);
+      const ptr_t fst_b = fst(b);
+
+      // Sort primarily by the element to be encountered first
+      if (fst_a != fst_b) { return fst_a < fst_b; }
+
+      // Group requests to the same tuple together by sorting on the coordinates
+      for (size_t idx = 0u; idx < RELPROD_MAX_PAIRS; idx++) {
+        if (tuple_lt()(a.pairs[idx], b.pairs[idx])) { return true; }
+        if (tuple_lt()(b.pairs[idx], a.pairs[idx])) { return false; }
+      }
+#ifndef NDEBUG
+      return a.source < b.source;
+#else
+      return false;
+#endif
+    }
+  };
+
+  template<template<typename, typename> typename sorter_template,
+           template<typename, typename> typename priority_queue_template>
+  using relprod_priority_queue_t =
+    levelized_label_priority_queue<relprod_request, relprod_tuple_label, relprod_request_lt,
+                                   sorter_template, priority_queue_template>;
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Helper functions
+
+  // Simplifies the disjunction of the 'n' first pairs. Returns the number of
+  // pairs left. If none are left, then the disjunction has collapsed to the
+  // sink placed in 'out_sink'.
+  inline size_t relprod_simplify(tuple *pairs, const size_t n, ptr_t &out_sink)
+  {
+    size_t out_n = 0u;
+
+    for (size_t idx = 0u; idx < n; idx++) {
+      const tuple p = pairs[idx];
+
+      if (is_false(p.t1) || is_false(p.t2)) { continue; }
+
+      if (is_true(p.t1) && is_true(p.t2)) {
+        out_sink = create_sink_ptr(true);
+        return 0u;
+      }
+      pairs[out_n++] = p;
+    }
+
+    std::sort(pairs, pairs + out_n, tuple_lt());
+    out_n = std::unique(pairs, pairs + out_n) - pairs;
+
+    if (out_n == 0u) { out_sink = create_sink_ptr(false); }
+    return out_n;
+  }
+
+  inline relprod_tuple relprod_pack(const tuple *pairs, const size_t n)
+  {
+    adiar_debug(n <= RELPROD_MAX_PAIRS, "Too many pairs for a single request");
+
+    relprod_tuple t;
+    for (size_t idx = 0u; idx < RELPROD_MAX_PAIRS; idx++) {
+      t.pairs[idx] = idx < n ? pairs[idx] : tuple { NIL, NIL };
+    }
+    return t;
+  }
+
+  inline ptr_t relprod_cofactor(const std::vector<node_t> &level_nodes,
+                                const label_t level, const ptr_t p,
+                                const bool high)
+  {
+    if (is_node(p) && label_of(p) == level) {
+      const node_t &v = nary_find(level_nodes, p);
+      return high ? v.high : v.low;
+    }
+    return p;
+  }
+
+  // Places the low (high) cofactors of all pairs in 'low' ('high') and returns
+  // how many pairs there are.
+  inline size_t relprod_cofactors(const relprod_tuple &t, const label_t level,
+                                  const std::vector<node_t> (&level_nodes) [2],
+                                  tuple *low, tuple *high)
+  {
+    size_t n = 0u;
+    for (; n < RELPROD_MAX_PAIRS && !is_nil(t.pairs[n].t1); n++) {
+      low[n]  = { relprod_cofactor(level_nodes[0], level, t.pairs[n].t1, false),
+                  relprod_cofactor(level_nodes[1], level, t.pairs[n].t2, false) };
+      high[n] = { relprod_cofactor(level_nodes[0], level, t.pairs[n].t1, true),
+                  relprod_cofactor(level_nodes[1], level, t.pairs[n].t2, true) };
+    }
+    return n;
+  }
+
+  template<typename pq_t>
+  inline void relprod_recurse_out(pq_t &relprod_pq, arc_writer &aw,
+                                  const ptr_t source, tuple *pairs, const size_t n)
+  {
+    ptr_t out_sink;
+    const size_t out_n = relprod_simplify(pairs, n, out_sink);
+
+    if (out_n == 0u) {
+      aw.unsafe_push_sink({ source, out_sink });
+    } else {
+      relprod_pq.push({ relprod_pack(pairs, out_n), source });
+    }
+  }
+
+  inline bool relprod_is_quantified(label_stream<> &vars, const label_t level)
+  {
+    while (vars.can_pull() && vars.peek() < level) { vars.pull(); }
+    return vars.can_pull() && vars.peek() == level;
+  }
+
+  template<typename pq_t>
+  __bdd __bdd_relprod(const bdd (&in) [2],
+                      const label_file &vars,
+                      const label_file &levels,
+                      const size_t pq_memory,
+                      const size_t max_pq_size,
+                      bool &deferred)
+  {
+    std::unique_ptr<node_stream<>> in_nodes [2];
+    std::vector<node_t> level_nodes [2];
+
+    in_nodes[0] = std::make_unique<node_stream<>>(in[0]);
+    in_nodes[1] = std::make_unique<node_stream<>>(in[1]);
+
+    // Resolve the pair of roots
+    tuple low [2 * RELPROD_MAX_PAIRS];
+    tuple high [2 * RELPROD_MAX_PAIRS];
+
+    low[0] = { in_nodes[0] -> peek().uid, in_nodes[1] -> peek().uid };
+
+    ptr_t out_sink;
+    if (relprod_simplify(low, 1u, out_sink) == 0u) {
+      return nary_sink(out_sink);
+    }
+
+    relprod_tuple t = relprod_pack(low, 1u);
+    ptr_t source = NIL;
+
+    // Set-up for Relational Product Algorithm
+    arc_file out_arcs;
+    arc_writer aw(out_arcs);
+
+    pq_t relprod_pq({levels}, pq_memory, max_pq_size, &stats_product_construction);
+
+    label_stream<> in_vars(vars);
+
+    label_t out_label = label_of(fst(t));
+    id_t out_id = 0;
+
+    nary_setup_level(in_nodes, level_nodes, 2u, out_label);
+    bool quantify = relprod_is_quantified(in_vars, out_label);
+
+    size_t max_1level_cut = 0;
+
+    // Process requests in topological order of both BDDs. The first one is the
+    // pair of roots from above.
+    while (true) {
+      const size_t n = relprod_cofactors(t, out_label, level_nodes, low, high);
+
+      // Try to quantify the variable by forwarding the disjunction of both
+      // cofactors to the children of all sources.
+      bool resolved = false;
+      if (quantify) {
+        std::copy(high, high + n, low + n);
+        const size_t out_n = relprod_simplify(low, 2u * n, out_sink);
+
+        if (out_n == 0u) {
+          // Quantification of the root collapsed into a sink
+          if (is_nil(source)) { return nary_sink(out_sink); }
+
+          aw.unsafe_push_sink({ source, out_sink });
+          while (relprod_pq.can_pull() && relprod_same_pairs(relprod_pq.top(), t)) {
+            aw.unsafe_push_sink({ relprod_pq.pull().source, out_sink });
+          }
+
+          resolved = true;
+        } else if (out_n <= RELPROD_MAX_PAIRS) {
+          const relprod_tuple r = relprod_pack(low, out_n);
+
+          relprod_pq.push({ r, source });
+          while (relprod_pq.can_pull() && relprod_same_pairs(relprod_pq.top(), t)) {
+            relprod_pq.push({ r, relprod_pq.pull().source });
+          }
+
+          resolved = true;
+        } else {
+#ifdef ADIAR_STATS
+          stats_product_construction.relprod_deferred++;
+#endif
+          deferred = true;
+
+          // Too many pairs: recompute the cofactors overwritten above and
+          // output the variable to be quantified afterwards.
+          relprod_cofactors(t, out_label, level_nodes, low, high);
+        }
+      }
+
+      // Output a node for the conjunction of the pairs.
+      if (!resolved) {
+        adiar_debug(out_id < MAX_ID, "Has run out of ids");
+        const uid_t out_uid = create_node_uid(out_label, out_id++);
+
+        relprod_recurse_out(relprod_pq, aw, out_uid, low, n);
+        relprod_recurse_out(relprod_pq, aw, flag(out_uid), high, n);
+
+        if (!is_nil(source)) {
+          aw.unsafe_push_node({ source, out_uid });
+        }
+        while (relprod_pq.can_pull() && relprod_same_pairs(relprod_pq.top(), t)) {
+          aw.unsafe_push_node({ relprod_pq.pull().source, out_uid });
+        }
+      }
+
+      if (relprod_pq.empty()) { break; }
+
+      if (relprod_pq.empty_level()) {
+        if (out_id > 0) {
+          aw.unsafe_push(create_level_info(out_label, out_id));
+        }
+
+        relprod_pq.setup_next_level();
+        out_label = relprod_pq.current_level();
+        out_id = 0;
+
+        nary_setup_level(in_nodes, level_nodes, 2u, out_label);
+        quantify = relprod_is_quantified(in_vars, out_label);
+
+        max_1level_cut = std::max(max_1level_cut, relprod_pq.size());
+      }
+
+      const relprod_request r = relprod_pq.pull();
+      t = r;
+      source = r.source;
+    }
+
+    // Push the level of the very last iteration
+    if (out_id > 0) {
+      aw.unsafe_push(create_level_info(out_label, out_id));
+    }
+
+    out_arcs._file_ptr->max_1level_cut = max_1level_cut;
+
+    return out_arcs;
+  }
+
+  size_t __bdd_relprod_max_cut_upper_bound(const bdd (&in) [2])
+  {
+    constexpr size_t max_bits = sizeof(size_t) * 8;
+
+    const size_t pairs = (in[0].file_ptr()->size() + 2) * (in[1].file_ptr()->size() + 2);
+    const size_t pair_bits = bits_approximation(in[0].file_ptr()->size() + 2).bits
+                           + bits_approximation(in[1].file_ptr()->size() + 2).bits;
+
+    if (max_bits <= pair_bits * RELPROD_MAX_PAIRS) {
+      return std::numeric_limits<size_t>::max();
+    }
+
+    size_t bound = 1u;
+    for (size_t idx = 0u; idx < RELPROD_MAX_PAIRS; idx++) { bound *= pairs; }
+    return bound + 2;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  __bdd bdd_relprod(const bdd &f, const bdd &g, const label_file &labels)
+  {
+    if (labels.size() == 0) { return bdd_and(f, g); }
+
+    // The sweep below relies on the variables being in ascending order.
+    const label_file vars = sorted_labels(labels);
+
+    const bdd in[2] = { f, g };
+
+    // Compute amount of memory available for auxiliary data structures after
+    // having opened all streams.
+    const size_t available_memory = memory::available()
+      // Input streams
+      - 2*node_stream<>::memory_usage()
+      // Quantified variables
+      - label_stream<>::memory_usage()
+      // Output stream
+      - arc_writer::memory_usage();
+
+    label_file levels;
+    const size_t levels_memory = __nary_levels(in, 2u, levels);
+
+    // Fall back to first conjoining and then quantifying, if not a single level
+    // of both BDDs can be kept in memory.
+    if (available_memory / NARY_LEVELS_MEMORY_FRACTION < levels_memory) {
+      return bdd_exists(bdd_and(f, g), vars);
+    }
+
+#ifdef ADIAR_STATS
+    stats_product_construction.relprod_runs++;
+#endif
+
+    const size_t pq_memory = available_memory - levels_memory;
+    const size_t max_pq_size = __bdd_relprod_max_cut_upper_bound(in);
+
+    const bool internal_memory =
+      max_pq_size <= relprod_priority_queue_t<internal_sorter, internal_priority_queue>::memory_fits(pq_memory);
+
+#ifdef ADIAR_STATS
+    if (internal_memory) {
+      stats_product_construction.lpq_internal++;
+    } else {
+      stats_product_construction.lpq_external++;
+    }
+#endif
+
+    bool deferred = false;
+
+    __bdd out = internal_memory
+      ? __bdd_relprod<relprod_priority_queue_t<internal_sorter, internal_priority_queue>>
+          (in, vars, levels, pq_memory, max_pq_size, deferred)
+      : __bdd_relprod<relprod_priority_queue_t<external_sorter, external_priority_queue>>
+          (in, vars, levels, pq_memory, max_pq_size, deferred);
+
+    if (!deferred) { return out; }
+
+    // Quantify the variables that had too many pairs to be quantified above.
+    // This is immediate for the variables that already are gone.
+    return bdd_exists(bdd(std::move(out)), vars);
+  }
+}
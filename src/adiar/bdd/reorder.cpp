@@ -16,10 +16,10 @@
 namespace adiar
 {
 
-  stats_t::reorder_t stats_reorder;
+  thread_local stats_t::reorder_t stats_reorder;
 
-  std::vector<label_t> perm;
-  std::vector<label_t> perm_inv;
+  thread_local std::vector<label_t> perm;
+  thread_local std::vector<label_t> perm_inv;
 
   typedef uint64_t hash_t;
 
@@ -83,22 +83,6 @@ namespace adiar
 #endif
   }
 
-  hash_t hash_of(const bdd &dd)
-  {
-    node_stream<> ns(dd);
-    hash_t hash = 0;
-    // 2^64 - 59
-    // Source: https://primes.utm.edu/lists/2small/0bit.html
-    uint64_t modulus = 18446744073709551557U;
-    uint64_t term_prime = 3689348814741910277U;
-    while (ns.can_pull())
-    {
-      node_t node = ns.pull();
-      hash = hash ^ ((5 * ((node.uid >> 1) % term_prime) + 3 * ((node.low >> 1) % term_prime) + 2 * ((node.high >> 1) % term_prime)) % modulus);
-    }
-    return hash;
-  }
-
   assignment_file reverse_path(const arc_file &af, ptr_t node_ptr)
   {
     stats_reorder.reverse_path++;
@@ -240,9 +224,9 @@ namespace adiar
           src = unflag(source_ptr);
 
           // set hash to 0, for testing non-hashing algo
-          // set hash to hash_of(F_ikb), for hashing algo
+          // set hash to bdd_hash(F_ikb), for hashing algo
 #if HASHING
-        pq.push(reorder_request{src, label, hash_of(F_ikb)});
+        pq.push(reorder_request{src, label, bdd_hash(F_ikb)});
 #else
         pq.push(reorder_request{src, label, 0});
 #endif
@@ -356,7 +340,7 @@ namespace adiar
       sfs.sort(filter);
     }
 
-    levelized_label_priority_queue<reorder_request, reorder_level, reorder_request_lt> llpq({filter}, total_available_memory_after_streams / 2, std::numeric_limits<size_t>::max());
+    levelized_label_priority_queue<reorder_request, reorder_level, reorder_request_lt> llpq({filter}, total_available_memory_after_streams / 2, std::numeric_limits<size_t>::max(), &stats_reorder);
 
     arc_file af;
     ptr_t root = create_node_ptr(0, 0);
@@ -5,7 +5,7 @@ namespace adiar {
 
   //////////////////////////////////////////////////////////////////////////////
   /// Struct to hold statistics
-  extern stats_t::reorder_t stats_reorder;
+  extern thread_local stats_t::reorder_t stats_reorder;
 
 }
 
@@ -0,0 +1,139 @@
+#include "context.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <mutex>
+
+#include <tpie/tpie.h>
+
+#include <adiar/internal/assert.h>
+#include <adiar/internal/async.h>
+#include <adiar/internal/cache.h>
+#include <adiar/internal/memory.h>
+
+namespace adiar
+{
+  //////////////////////////////////////////////////////////////////////////////
+  // TPIE is shared by all contexts (and 'adiar_init').
+  std::mutex _tpie_mutex;
+  size_t _tpie_users = 0u;
+  size_t _tpie_limit = 0u;
+
+  void adiar_context::acquire(size_t memory_limit_bytes, const std::string &temp_dir)
+  {
+    std::lock_guard<std::mutex> lock(_tpie_mutex);
+
+    if (_tpie_users++ == 0u) {
+      tpie::tpie_init();
+
+      // Memory management
+      memory::set_path(temp_dir);
+      memory::set_block_size(memory::recommended_block_size(memory_limit_bytes));
+
+      // A file no larger than a single block is kept in internal memory, which
+      // then does not use more memory than a stream on it would have.
+      memory::set_internal_file_threshold(memory::get_block_size());
+    }
+
+    _tpie_limit += memory_limit_bytes;
+    memory::set_limit(std::max(_tpie_limit, memory::MINIMUM_BYTES));
+  }
+
+  void adiar_context::release(size_t memory_limit_bytes)
+  {
+    std::lock_guard<std::mutex> lock(_tpie_mutex);
+    adiar_debug(0u < _tpie_users, "TPIE should be in use");
+
+    _tpie_limit -= memory_limit_bytes;
+
+    if (--_tpie_users == 0u) {
+      // All asynchronous operations and the cached results have to be done and
+      // released before TPIE is shut down.
+      async::shutdown();
+      cache::set_limit(0u);
+      tpie::tpie_finish();
+    } else {
+      memory::set_limit(std::max(_tpie_limit, memory::MINIMUM_BYTES));
+    }
+  }
+
+  bool adiar_context::acquired()
+  {
+    std::lock_guard<std::mutex> lock(_tpie_mutex);
+    return 0u < _tpie_users;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  adiar_context::adiar_context(size_t memory_limit_bytes, const std::string &temp_dir)
+    : _memory_limit(memory_limit_bytes), _temp_dir(temp_dir),
+      _inbox(std::make_shared<__stats_inbox>())
+  {
+    adiar_assert(0u < memory_limit_bytes, "A context requires some memory");
+
+    if (!temp_dir.empty()) {
+      std::filesystem::create_directories(temp_dir);
+    }
+    acquire(memory_limit_bytes, "");
+  }
+
+  adiar_context::~adiar_context()
+  {
+    release(_memory_limit);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  thread_local const adiar_context* _current_context = nullptr;
+
+  adiar_context::scope::scope(adiar_context &context)
+    : _context(context), _nested(_current_context == &context)
+  {
+    if (_nested) { return; }
+
+    _outer_context = _current_context;
+    _outer_limit = memory::_context_limit;
+    _outer_path = memory::_context_path;
+    _outer_stats = __stats_collect();
+    _outer_inbox = __stats_current_inbox;
+
+    memory::_context_limit = _context._memory_limit;
+    memory::_context_path = _context._temp_dir;
+    __stats_load(_context._stats);
+    __stats_current_inbox = _context._inbox;
+    __stats_sync();
+
+    _current_context = &_context;
+  }
+
+  adiar_context::scope::~scope()
+  {
+    if (_nested) { return; }
+
+    __stats_sync();
+    _context._stats = __stats_collect();
+
+    memory::_context_limit = _outer_limit;
+    memory::_context_path = _outer_path;
+    __stats_load(_outer_stats);
+    __stats_current_inbox = std::move(_outer_inbox);
+
+    _current_context = _outer_context;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  stats_t adiar_context::stats() const
+  {
+    stats_t s = _stats;
+
+    std::lock_guard<std::mutex> lock(_inbox -> mutex);
+    __stats_add(s, _inbox -> stats);
+    return s;
+  }
+
+  void adiar_context::statsreset()
+  {
+    _stats = {};
+
+    std::lock_guard<std::mutex> lock(_inbox -> mutex);
+    _inbox -> stats = {};
+  }
+}
@@ -0,0 +1,171 @@
+#ifndef ADIAR_CONTEXT_H
+#define ADIAR_CONTEXT_H
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <adiar/statistics.h>
+
+namespace adiar
+{
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   A session of Adiar with its own memory budget, directory for
+  ///          temporary files, and statistics.
+  ///
+  /// \details TPIE is initialised (once for the whole process) when the first
+  ///          context is created or <tt>adiar_init</tt> is called, and it is
+  ///          shut down again when the last of them is gone. The memory limit
+  ///          of TPIE is the sum of all their budgets (but at least 128 MiB).
+  ///          Hence, independent jobs can each run on their own thread inside
+  ///          of their own context without paying for initialising Adiar more
+  ///          than once.
+  ///
+  ///          Operations only use the budget of a context if they are called
+  ///          within <tt>run</tt>. A context may only run on a single thread at
+  ///          a time, whereas different contexts can run concurrently. Threads
+  ///          started by an operation to parallelise its work, and the
+  ///          asynchronous operations submitted from within <tt>run</tt>, use
+  ///          the same budget, directory and statistics.
+  ///
+  ///          A budget is a cap, not a reservation: an operation never plans to
+  ///          use more than the budget of its context, but the memory is only
+  ///          taken from TPIE's shared limit when it is allocated. If other
+  ///          contexts (or code outside of any) already use more than their
+  ///          share of it, then an operation sees less than its budget.
+  ///
+  /// \remark  Any <tt>bdd</tt> or <tt>zdd</tt> objects created within a context
+  ///          should be garbage collected before the context is destructed.
+  //////////////////////////////////////////////////////////////////////////////
+  class adiar_context
+  {
+    friend void adiar_init(size_t, std::string, size_t, bool);
+    friend void adiar_deinit();
+    friend bool adiar_initialized();
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Initialise TPIE (if not done yet) and add the given number of
+    ///        bytes to its memory limit.
+    ////////////////////////////////////////////////////////////////////////////
+    static void acquire(size_t memory_limit_bytes, const std::string &temp_dir);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Subtract the given number of bytes from TPIE's memory limit and
+    ///        shut it down if nothing else uses it.
+    ////////////////////////////////////////////////////////////////////////////
+    static void release(size_t memory_limit_bytes);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Whether TPIE is initialised.
+    ////////////////////////////////////////////////////////////////////////////
+    static bool acquired();
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Number of bytes of internal memory for this context.
+    ////////////////////////////////////////////////////////////////////////////
+    const size_t _memory_limit;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Directory for temporary files (empty for TPIE's default).
+    ////////////////////////////////////////////////////////////////////////////
+    const std::string _temp_dir;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Statistics of all operations that have run in this context.
+    ////////////////////////////////////////////////////////////////////////////
+    stats_t _stats;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Statistics of asynchronous operations submitted from within this
+    ///        context that are yet to be added to <tt>_stats</tt>.
+    ////////////////////////////////////////////////////////////////////////////
+    const std::shared_ptr<__stats_inbox> _inbox;
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Create a new context.
+    ///
+    /// \param memory_limit_bytes
+    /// The number of bytes of internal memory available to each operation run
+    /// within this context.
+    ///
+    /// \param temp_dir
+    /// The directory to use for the temporary files of this context. It is
+    /// created if it does not exist yet. By default, TPIE's directory is used.
+    ////////////////////////////////////////////////////////////////////////////
+    adiar_context(size_t memory_limit_bytes, const std::string &temp_dir = "");
+
+    adiar_context(const adiar_context&) = delete;
+    adiar_context& operator= (const adiar_context&) = delete;
+
+    ~adiar_context();
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Bind this context to the calling thread.
+    ///
+    /// \details The statistics of the calling thread are swapped with the ones
+    ///          of this context, such that the operations run within add to the
+    ///          latter.
+    ////////////////////////////////////////////////////////////////////////////
+    class scope
+    {
+      adiar_context &_context;
+
+      // Whether this context already was bound to the thread.
+      bool _nested;
+
+      const adiar_context *_outer_context;
+      size_t _outer_limit;
+      std::string _outer_path;
+      stats_t _outer_stats;
+      std::shared_ptr<__stats_inbox> _outer_inbox;
+
+    public:
+      scope(adiar_context &context);
+      ~scope();
+    };
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Run <tt>f</tt> on the calling thread within this context.
+    ///
+    /// \returns The result of <tt>f()</tt>.
+    ////////////////////////////////////////////////////////////////////////////
+    template<typename F>
+    auto run(F &&f)
+    {
+      scope s(*this);
+      return std::forward<F>(f)();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The number of bytes of internal memory of this context.
+    ////////////////////////////////////////////////////////////////////////////
+    size_t memory_limit() const
+    { return _memory_limit; }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The directory of the temporary files of this context.
+    ////////////////////////////////////////////////////////////////////////////
+    const std::string& temp_dir() const
+    { return _temp_dir; }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Obtain a copy of the statistics of this context, including the
+    ///        ones of its asynchronous operations that are done.
+    ///
+    /// \copydoc stats_t
+    ////////////////////////////////////////////////////////////////////////////
+    stats_t stats() const;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Resets the statistics of this context.
+    ////////////////////////////////////////////////////////////////////////////
+    void statsreset();
+  };
+}
+
+#endif // ADIAR_CONTEXT_H
@@ -303,99 +303,182 @@ namespace adiar {
   ///
   /// \remark  For each operator, we provide the truth table
   ///          [(1,1), (1,0), (0,1), (0,0)].
+  ///
+  /// \remark  Each of the operators below is also provided as its own type,
+  ///          e.g. 'and_op_t' for 'and_op'. The algorithms use these to resolve
+  ///          the operator at compile-time rather than through a bool_op. Any
+  ///          other bool_op is evaluated generically through the std::function.
   //////////////////////////////////////////////////////////////////////////////
   typedef std::function<uid_t(ptr_t,ptr_t)> bool_op;
 
   //////////////////////////////////////////////////////////////////////////////
   /// \brief Logical 'and' operator, i.e. the truth table: [1,0,0,0].
   //////////////////////////////////////////////////////////////////////////////
-  const bool_op and_op = [](ptr_t sink1, ptr_t sink2) -> ptr_t
+  struct and_op_t
   {
-    return unflag(sink1 & sink2);
+    inline ptr_t operator()(ptr_t sink1, ptr_t sink2) const
+    {
+      return unflag(sink1 & sink2);
+    }
   };
 
+  const bool_op and_op = and_op_t();
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief Logical 'not and' operator, i.e. the truth table: [0,1,1,1].
   //////////////////////////////////////////////////////////////////////////////
-  const bool_op nand_op = [](ptr_t sink1, ptr_t sink2) -> ptr_t
+  struct nand_op_t
   {
-    return negate(and_op(sink1, sink2));
+    inline ptr_t operator()(ptr_t sink1, ptr_t sink2) const
+    {
+      return negate(and_op_t()(sink1, sink2));
+    }
   };
 
+  const bool_op nand_op = nand_op_t();
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief Logical 'or' operator, i.e. the truth table: [1,1,1,0].
   //////////////////////////////////////////////////////////////////////////////
-  const bool_op or_op = [](ptr_t sink1, ptr_t sink2) -> ptr_t
+  struct or_op_t
   {
-    return unflag(sink1 | sink2);
+    inline ptr_t operator()(ptr_t sink1, ptr_t sink2) const
+    {
+      return unflag(sink1 | sink2);
+    }
   };
 
+  const bool_op or_op = or_op_t();
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief Logical 'not or' operator, i.e. the truth table: [0,0,0,1].
   //////////////////////////////////////////////////////////////////////////////
-  const bool_op nor_op = [](ptr_t sink1, ptr_t sink2) -> ptr_t
+  struct nor_op_t
   {
-    return negate(or_op(sink1, sink2));
+    inline ptr_t operator()(ptr_t sink1, ptr_t sink2) const
+    {
+      return negate(or_op_t()(sink1, sink2));
+    }
   };
 
+  const bool_op nor_op = nor_op_t();
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief Logical 'xor' operator, i.e. the truth table: [0,1,1,0].
   //////////////////////////////////////////////////////////////////////////////
-  const bool_op xor_op = [](ptr_t sink1, ptr_t sink2) -> ptr_t
+  struct xor_op_t
   {
-    return SINK_BIT | unflag(sink1 ^ sink2);
+    inline ptr_t operator()(ptr_t sink1, ptr_t sink2) const
+    {
+      return SINK_BIT | unflag(sink1 ^ sink2);
+    }
   };
 
+  const bool_op xor_op = xor_op_t();
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief Logical 'xor' operator, i.e. the truth table: [1,0,0,1].
   //////////////////////////////////////////////////////////////////////////////
-  const bool_op xnor_op  = [](ptr_t sink1, ptr_t sink2) -> ptr_t
+  struct xnor_op_t
   {
-    return negate(xor_op(sink1, sink2));
+    inline ptr_t operator()(ptr_t sink1, ptr_t sink2) const
+    {
+      return negate(xor_op_t()(sink1, sink2));
+    }
   };
 
+  const bool_op xnor_op = xnor_op_t();
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief Logical 'implication' operator, i.e. the truth table: [1,0,1,1].
   //////////////////////////////////////////////////////////////////////////////
-  const bool_op imp_op = [](ptr_t sink1, ptr_t sink2) -> ptr_t
+  struct imp_op_t
   {
-    return create_sink_ptr(unflag(sink1) <= unflag(sink2));
+    inline ptr_t operator()(ptr_t sink1, ptr_t sink2) const
+    {
+      return create_sink_ptr(unflag(sink1) <= unflag(sink2));
+    }
   };
 
+  const bool_op imp_op = imp_op_t();
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief Logical 'implication' operator, i.e. the truth table: [1,1,0,1].
   //////////////////////////////////////////////////////////////////////////////
-  const bool_op invimp_op = [](ptr_t sink1, ptr_t sink2) -> ptr_t
+  struct invimp_op_t
   {
-    return create_sink_ptr(unflag(sink2) <= unflag(sink1));
+    inline ptr_t operator()(ptr_t sink1, ptr_t sink2) const
+    {
+      return create_sink_ptr(unflag(sink2) <= unflag(sink1));
+    }
   };
 
+  const bool_op invimp_op = invimp_op_t();
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief Logical 'equivalence' operator, i.e. the 'xnor' operator
   //////////////////////////////////////////////////////////////////////////////
-  const bool_op equiv_op = xnor_op;
+  typedef xnor_op_t equiv_op_t;
+
+  const bool_op equiv_op = equiv_op_t();
 
   //////////////////////////////////////////////////////////////////////////////
   /// \brief Logical 'set difference' operator, i.e. the truth table [0,1,0,0].
   //////////////////////////////////////////////////////////////////////////////
-  const bool_op diff_op = [](ptr_t sink1, ptr_t sink2) -> ptr_t
+  struct diff_op_t
   {
-    return and_op(sink1, negate(sink2));
+    inline ptr_t operator()(ptr_t sink1, ptr_t sink2) const
+    {
+      return and_op_t()(sink1, negate(sink2));
+    }
   };
 
+  const bool_op diff_op = diff_op_t();
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief Logical 'less' operator, i.e. the truth table [0,0,1,0].
   //////////////////////////////////////////////////////////////////////////////
-  const bool_op less_op = [](ptr_t sink1, ptr_t sink2) -> ptr_t
+  struct less_op_t
   {
-    return and_op(negate(sink1), sink2);
+    inline ptr_t operator()(ptr_t sink1, ptr_t sink2) const
+    {
+      return and_op_t()(negate(sink1), sink2);
+    }
   };
 
+  const bool_op less_op = less_op_t();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Calls the given function with the operator type of one of the
+  ///          operators above, if 'op' is one of them. Otherwise, it is called
+  ///          with 'op' itself.
+  ///
+  /// \details This lets an algorithm be instantiated for every operator above,
+  ///          such that no sink has to be resolved with an indirect call.
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename callback_t>
+  inline auto bool_op_dispatch(const bool_op &op, const callback_t &f)
+  {
+    if (op.target<and_op_t>())    { return f(and_op_t()); }
+    if (op.target<or_op_t>())     { return f(or_op_t()); }
+    if (op.target<xor_op_t>())    { return f(xor_op_t()); }
+    if (op.target<xnor_op_t>())   { return f(xnor_op_t()); }
+    if (op.target<imp_op_t>())    { return f(imp_op_t()); }
+    if (op.target<diff_op_t>())   { return f(diff_op_t()); }
+    if (op.target<nand_op_t>())   { return f(nand_op_t()); }
+    if (op.target<nor_op_t>())    { return f(nor_op_t()); }
+    if (op.target<invimp_op_t>()) { return f(invimp_op_t()); }
+    if (op.target<less_op_t>())   { return f(less_op_t()); }
+
+    return f(op);
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief Whether the sink shortcuts the operator from the right,
   ///        i.e. op(T,sink) = op(F,sink).
   //////////////////////////////////////////////////////////////////////////////
-  inline bool can_right_shortcut(const bool_op &op, const ptr_t sink)
+  template<typename op_t>
+  inline bool can_right_shortcut(const op_t &op, const ptr_t sink)
   {
     return op(create_sink_ptr(false), sink) == op(create_sink_ptr(true), sink);
   }
@@ -404,7 +487,8 @@ namespace adiar {
   /// \brief Whether the sink shortcuts the operator from the left,
   ///        i.e. op(sink, T) = op(sink, F).
   //////////////////////////////////////////////////////////////////////////////
-  inline bool can_left_shortcut(const bool_op &op, const ptr_t sink)
+  template<typename op_t>
+  inline bool can_left_shortcut(const op_t &op, const ptr_t sink)
   {
     return op(sink, create_sink_ptr(false)) == op(sink, create_sink_ptr(true));
   }
@@ -413,7 +497,8 @@ namespace adiar {
   /// \brief Whether the sink is irrelevant for the operator from the right,
   ///        i.e. op(X, sink) = X.
   //////////////////////////////////////////////////////////////////////////////
-  inline bool is_right_irrelevant(const bool_op &op, const ptr_t sink)
+  template<typename op_t>
+  inline bool is_right_irrelevant(const op_t &op, const ptr_t sink)
   {
     return op(create_sink_ptr(false), sink) == create_sink_ptr(false)
       && op(create_sink_ptr(true), sink) == create_sink_ptr(true);
@@ -423,7 +508,8 @@ namespace adiar {
   /// \brief Whether the sink is irrelevant for the operator from the left,
   ///        i.e. op(sink, X) = X.
   //////////////////////////////////////////////////////////////////////////////
-  inline bool is_left_irrelevant(const bool_op &op, const ptr_t sink)
+  template<typename op_t>
+  inline bool is_left_irrelevant(const op_t &op, const ptr_t sink)
   {
     return op(sink, create_sink_ptr(false)) == create_sink_ptr(false)
       && op(sink, create_sink_ptr(true)) == create_sink_ptr(true);
@@ -433,7 +519,8 @@ namespace adiar {
   /// \brief Whether the sink for this operator negates the value of the other
   ///        from the right, i.e. op(X, sink) = ~X.
   //////////////////////////////////////////////////////////////////////////////
-  inline bool is_right_negating(const bool_op &op, const ptr_t sink)
+  template<typename op_t>
+  inline bool is_right_negating(const op_t &op, const ptr_t sink)
   {
     return op(sink, create_sink_ptr(false)) == create_sink_ptr(true)
       && op(sink, create_sink_ptr(true)) == create_sink_ptr(false);
@@ -443,7 +530,8 @@ namespace adiar {
   /// \brief Whether the sink for this operator negates the value of the other
   ///        from the left, i.e. op(sink, X) = ~X
   //////////////////////////////////////////////////////////////////////////////
-  inline bool is_left_negating(const bool_op &op, const ptr_t sink)
+  template<typename op_t>
+  inline bool is_left_negating(const op_t &op, const ptr_t sink)
   {
     return op(sink, create_sink_ptr(false)) == create_sink_ptr(true)
       && op(sink, create_sink_ptr(true)) == create_sink_ptr(false);
@@ -452,7 +540,8 @@ namespace adiar {
   //////////////////////////////////////////////////////////////////////////////
   /// \brief Whether an operator is commutative, op(X, Y) = op(Y, X).
   //////////////////////////////////////////////////////////////////////////////
-  inline bool is_commutative(const bool_op &op)
+  template<typename op_t>
+  inline bool is_commutative(const op_t &op)
   {
     ptr_t sink_T = create_sink_ptr(true);
     ptr_t sink_F = create_sink_ptr(false);
@@ -3,27 +3,74 @@
 
 // STD imports for memory management, strings etc.
 #include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
 #include <memory>
+#include <mutex>
 #include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 // TPIE imports
 #include <tpie/tpie.h>
 #include <tpie/file_stream.h>
 #include <tpie/file.h>
+#include <tpie/memory.h>
 #include <tpie/sort.h>
+#include <tpie/tempname.h>
 
 // ADIAR imports
 #include <adiar/data.h>
 #include <adiar/internal/assert.h>
+#include <adiar/internal/memory.h>
+#include <adiar/internal/node_codec.h>
 
 namespace adiar
 {
   constexpr tpie::access_type ADIAR_READ_ACCESS  = tpie::access_type::access_read;
   constexpr tpie::access_type ADIAR_WRITE_ACCESS = tpie::access_type::access_write;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief The stream to read and write the content of a file on disk.
+  //////////////////////////////////////////////////////////////////////////////
+  template <typename T>
+  struct __disk_stream
+  {
+    typedef tpie::file_stream<T> type;
+
+    template <typename pred_t>
+    static void sort(type &fs, pred_t pred)
+    {
+      tpie::progress_indicator_null pi;
+      tpie::sort(fs, pred, pi);
+    }
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Nodes are stored compactly on disk (see <tt>node_codec</tt>).
+  //////////////////////////////////////////////////////////////////////////////
+  template <>
+  struct __disk_stream<node_t>
+  {
+    typedef __encoded_node_stream type;
+
+    template <typename pred_t>
+    static void sort(type &fs, pred_t pred)
+    {
+      fs.sort(pred);
+    }
+  };
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief   Wrapper for TPIE's <tt>temp_file</tt>.
   ///
+  /// \details A temporary file starts out with its content in internal memory.
+  ///          Only when it grows larger than the threshold given by
+  ///          <tt>memory::get_internal_file_threshold()</tt> is its content
+  ///          spilled to a file on disk.
+  ///
   /// \param T Type of the file's content
   //////////////////////////////////////////////////////////////////////////////
   template <typename T>
@@ -37,6 +84,16 @@ namespace adiar
     ////////////////////////////////////////////////////////////////////////////
     typedef T elem_t;
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Type of the file's content, when kept in internal memory.
+    ////////////////////////////////////////////////////////////////////////////
+    typedef std::vector<T, tpie::allocator<T>> memory_t;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Type of the stream to the file's content on disk.
+    ////////////////////////////////////////////////////////////////////////////
+    typedef typename __disk_stream<T>::type stream_t;
+
   private:
     ////////////////////////////////////////////////////////////////////////////
     // The variables above are 'mutable' to allow them to be used with
@@ -44,39 +101,107 @@ namespace adiar
 
     ////////////////////////////////////////////////////////////////////////////
     /// \brief Whether the file has been read (and hence should not be further)
+    ///
+    /// \remark This is set by every stream that is attached, which may happen
+    ///         from multiple threads at once.
     ////////////////////////////////////////////////////////////////////////////
-    mutable bool _is_read_only = false;
+    mutable std::atomic<bool> _is_read_only { false };
 
     ////////////////////////////////////////////////////////////////////////////
     /// \brief The underlying TPIE file
     ////////////////////////////////////////////////////////////////////////////
     mutable tpie::temp_file _tpie_file;
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Whether the content is stored in <tt>_tpie_file</tt> on disk.
+    ///
+    /// \remark This may be read from multiple threads at once.
+    ////////////////////////////////////////////////////////////////////////////
+    mutable std::atomic<bool> _on_disk { false };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The file's content in internal memory, which is shared by all
+    ///        streams attached to it. If the file is not on disk, then this is
+    ///        its only copy. Otherwise, this is a copy of the content of a small
+    ///        read-only file (if any).
+    ////////////////////////////////////////////////////////////////////////////
+    mutable std::shared_ptr<memory_t> _memory;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Whether the file on disk was too large to be copied into
+    ///        <tt>_memory</tt>.
+    ////////////////////////////////////////////////////////////////////////////
+    mutable std::atomic<bool> _view_rejected { false };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Guards every access to <tt>_memory</tt> that may happen while
+    ///        streams are attached to a read-only file from multiple threads,
+    ///        e.g. its lazy setup in <tt>view()</tt> and reading its size.
+    ///
+    /// \remark A writer has exclusive access to the (writeable) file and so
+    ///         does not need to take this lock for every element it appends.
+    ////////////////////////////////////////////////////////////////////////////
+    mutable std::mutex _view_mutex;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Number of bytes the content may grow to in internal memory before
+    ///        it is spilled to disk.
+    ////////////////////////////////////////////////////////////////////////////
+    mutable size_t _internal_capacity = 0u;
+
     ////////////////////////////////////////////////////////////////////////////
     /// Befriend the few places that need direct access to these variables.
     template <typename elem_t, typename pred_t>
     friend class simple_file_sorter;
 
-    template <typename elem_t, typename Comp>
-    friend class simple_file_writer;
-
     template <typename elem_t>
-    friend class meta_file_writer;
+    friend class __file_appender;
 
     template <typename elem_t, bool REVERSE, typename SharedPtr_T>
     friend class file_stream;
 
   private:
-    void touch_file()
+    void touch_file() const
     {
       // Opening the file with 'access_read_write' automatically creates the
       // file with header on disk.
-      tpie::file_stream<elem_t> fs;
+      stream_t fs;
       fs.open(_tpie_file, tpie::access_type::access_read_write);
+
+      _on_disk = true;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Move the content in internal memory (if any) to the file on disk.
+    ////////////////////////////////////////////////////////////////////////////
+    void spill() const
+    {
+      std::lock_guard<std::mutex> lock(_view_mutex);
+      if (!_on_disk) {
+        stream_t fs;
+        fs.open(_tpie_file, tpie::access_type::access_read_write);
+
+        for (const elem_t &e : *_memory) { fs.write(e); }
+
+        _on_disk = true;
+      }
+      _memory.reset();
+      _view_rejected = false;
     }
 
   public:
-    file() : _tpie_file() { touch_file(); }
+    file() : _tpie_file(), _internal_capacity(memory::get_internal_file_threshold())
+    {
+      if (!memory::_context_path.empty()) {
+        _tpie_file.set_path(tpie::tempname::tpie_name("", memory::_context_path), false);
+      }
+
+      if (0u < _internal_capacity) {
+        _memory = std::make_shared<memory_t>();
+      } else {
+        touch_file();
+      }
+    }
 
     file(const std::string &filename) : _tpie_file(filename, true) {
       touch_file();
@@ -94,13 +219,95 @@ namespace adiar
     void make_writeable() const 
     {
       _is_read_only = false;
+
+      std::lock_guard<std::mutex> lock(_view_mutex);
+      if (_on_disk) {
+        _memory.reset();
+        _view_rejected = false;
+      }
     }
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief   The underlying TPIE file.
+    ///
+    /// \details The content is first moved to disk, if it is still in internal
+    ///          memory. Any later change to the TPIE file is visible to all
+    ///          streams that are attached afterwards.
+    ////////////////////////////////////////////////////////////////////////////
     tpie::temp_file get_tpie_file() const 
     {
+      spill();
       return _tpie_file;
     }
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Whether the file's content has been moved to disk.
+    ////////////////////////////////////////////////////////////////////////////
+    bool is_on_disk() const
+    {
+      return _on_disk;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief   Allow the content to grow to the given number of bytes in
+    ///          internal memory before it is spilled to disk.
+    ///
+    /// \details This only has an effect on an empty temporary file or on one
+    ///          whose content still is in internal memory. It has to be set
+    ///          before any writer is attached.
+    ////////////////////////////////////////////////////////////////////////////
+    void set_internal_capacity(size_t bytes) const
+    {
+      adiar_debug(!is_read_only(), "Cannot change the capacity of a read-only file");
+
+      if (_on_disk) {
+        if (_tpie_file.is_persistent() || !empty()) { return; }
+        _on_disk = false;
+      }
+
+      std::lock_guard<std::mutex> lock(_view_mutex);
+      if (!_memory) { _memory = std::make_shared<memory_t>(); }
+
+      _internal_capacity = bytes;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief   The content of a read-only file in internal memory.
+    ///
+    /// \details If the file is on disk, then its content is loaded on the first
+    ///          call, if it is at most
+    ///          <tt>memory::get_internal_file_threshold()</tt> bytes large. This
+    ///          copy is kept until the file is garbage collected or made
+    ///          writeable.
+    ///
+    /// \returns Shared pointer to the content or a <tt>nullptr</tt> if the file
+    ///          is too large.
+    ////////////////////////////////////////////////////////////////////////////
+    std::shared_ptr<const memory_t> view() const
+    {
+      adiar_debug(is_read_only(), "Only the content of a read-only file can be shared");
+
+      std::lock_guard<std::mutex> lock(_view_mutex);
+      if (!_memory && !_view_rejected) {
+        stream_t fs;
+        fs.open(_tpie_file, ADIAR_READ_ACCESS);
+
+        const size_t elems = fs.size();
+        const size_t bytes = elems * sizeof(elem_t);
+
+        if (bytes <= memory::get_internal_file_threshold() && bytes < memory::available()) {
+          _memory = std::make_shared<memory_t>();
+          _memory -> reserve(elems);
+          for (size_t idx = 0u; idx < elems; idx++) {
+            _memory -> push_back(fs.read());
+          }
+        } else {
+          _view_rejected = true;
+        }
+      }
+      return _memory;
+    }
+
     ////////////////////////////////////////////////////////////////////////////
     /// \brief Whether the file is currently in read-only mode, i.e. some
     /// adiar::file_stream has been attached to it and has marked it.
@@ -115,7 +322,12 @@ namespace adiar
     ////////////////////////////////////////////////////////////////////////////
     size_t size() const
     {
-      tpie::file_stream<elem_t> fs;
+      {
+        std::lock_guard<std::mutex> lock(_view_mutex);
+        if (_memory) { return _memory -> size(); }
+      }
+
+      stream_t fs;
       fs.open(_tpie_file, ADIAR_READ_ACCESS);
       return fs.size();
     }
@@ -165,6 +377,39 @@ namespace adiar
       ///        check.
       //////////////////////////////////////////////////////////////////////////
       bool canonical = false;
+
+      //////////////////////////////////////////////////////////////////////////
+      /// \brief Merkle hash of the root, where index 1 is the hash of the same
+      ///        nodes with negated sinks.
+      ///
+      /// \details The hash is derived bottom-up by the node_writer (and by
+      ///          Reduce) while the nodes are written. It does not depend on
+      ///          the identifiers of nodes, so two reduced diagrams that are
+      ///          isomorphic also have the same hash.
+      ///
+      /// \sa node_hash
+      //////////////////////////////////////////////////////////////////////////
+      uint64_t hash[2] = { 0u, 0u };
+
+      //////////////////////////////////////////////////////////////////////////
+      /// \brief Number of 64-bit words needed to store these statistics in the
+      ///        header of a persistent file.
+      //////////////////////////////////////////////////////////////////////////
+      static constexpr size_t WORDS = 3u;
+
+      void save(uint64_t *words) const
+      {
+        words[0] = canonical ? 1u : 0u;
+        words[1] = hash[0];
+        words[2] = hash[1];
+      }
+
+      void load(const uint64_t *words)
+      {
+        canonical = words[0] != 0u;
+        hash[0] = words[1];
+        hash[1] = words[2];
+      }
     };
   };
 
@@ -184,9 +429,78 @@ namespace adiar
     {
       // TODO: move max_1level_cut up here when node files need four different
       //       types of cuts.
+
+      static constexpr size_t WORDS = 0u;
+
+      void save(uint64_t * /*words*/) const
+      { }
+
+      void load(const uint64_t * /*words*/)
+      { }
     };
   };
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Header of a persistent file with meta information.
+  ///
+  /// \details The header is stored as a single element at the path given to a
+  ///          persistent <tt>__meta_file</tt>. The level information and the
+  ///          content files are stored next to it with the suffixes
+  ///          <tt>.levels</tt>, <tt>.0</tt>, <tt>.1</tt>, and so on.
+  ///
+  ///          Every field is a fixed-width 64-bit word, such that the header
+  ///          has no padding. The statistics of the file are not written as
+  ///          their in-memory struct, but each is converted into the words of
+  ///          <tt>stats</tt> with <tt>FILE_CONSTANTS<T>::stats::save</tt>.
+  ///
+  /// \param T Type of the meta file's content
+  //////////////////////////////////////////////////////////////////////////////
+  template <typename T>
+  struct __meta_file_header
+  {
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Identifier of an Adiar file, i.e. "ADIAR" in ASCII.
+    ////////////////////////////////////////////////////////////////////////////
+    static constexpr uint64_t MAGIC = 0x0000005241494441u;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Version of the on-disk format. Increment this, whenever the
+    ///        layout of this header or of any of the files changes.
+    ////////////////////////////////////////////////////////////////////////////
+    static constexpr uint64_t VERSION = 7u;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Number of words reserved for the statistics of any type of file.
+    ////////////////////////////////////////////////////////////////////////////
+    static constexpr size_t STATS_WORDS = 4u;
+
+    static_assert(FILE_CONSTANTS<T>::stats::WORDS <= STATS_WORDS,
+                  "The statistics must fit into the words reserved for them");
+
+    uint64_t magic;
+    uint64_t version;
+    uint64_t files;
+    uint64_t elem_size;
+
+    uint64_t level_info_size;
+    uint64_t sizes[FILE_CONSTANTS<T>::files];
+
+    uint64_t max_1level_cut;
+    uint64_t number_of_sinks[2];
+
+    uint64_t stats[STATS_WORDS];
+  };
+
+  static_assert(sizeof(__meta_file_header<node_t>)
+                == (8u + FILE_CONSTANTS<node_t>::files + __meta_file_header<node_t>::STATS_WORDS)
+                   * sizeof(uint64_t),
+                "The header of a node file must not have any padding");
+
+  static_assert(sizeof(__meta_file_header<arc_t>)
+                == (8u + FILE_CONSTANTS<arc_t>::files + __meta_file_header<arc_t>::STATS_WORDS)
+                   * sizeof(uint64_t),
+                "The header of an arc file must not have any padding");
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief       File(s) with meta information.
   ///
@@ -235,13 +549,135 @@ namespace adiar
     ////////////////////////////////////////////////////////////////////////////
     file<T> _files [FILES];
 
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Path of the header of a persistent file (empty if temporary).
+    ////////////////////////////////////////////////////////////////////////////
+    const std::string _path;
+
   public:
     __meta_file() {
       adiar_debug(!is_read_only(), "Should be writable on creation");
     }
 
-    // TODO: Opening a persistent file with meta information given a path.
-    // __meta_file(const std::string& filename) : ? { ? }
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Open a persistent file with meta information given a path.
+    ///
+    /// \details If the file already exists on disk, then its meta information
+    ///          is restored from its header and the file is read-only.
+    ///          Otherwise, a new (empty) persistent file is created. Its header
+    ///          is written to disk when it is made read-only.
+    ///
+    /// \throws std::runtime_error If an existing file is not a valid Adiar
+    ///         file of this type (see <tt>load_header</tt>).
+    ////////////////////////////////////////////////////////////////////////////
+    __meta_file(const std::string &filename)
+      : __meta_file(filename, std::make_index_sequence<FILES>())
+    { }
+
+  private:
+    template <size_t... Idxs>
+    __meta_file(const std::string &filename, std::index_sequence<Idxs...>)
+      : _level_info_file(filename + ".levels"),
+        _files { file<T>(filename + "." + std::to_string(Idxs))... },
+        _path(filename)
+    {
+      if (std::filesystem::exists(_path)) {
+        load_header();
+        make_read_only();
+      }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Write the meta information into the header of a persistent file.
+    ////////////////////////////////////////////////////////////////////////////
+    void save_header() const
+    {
+      adiar_debug(is_persistent(), "Only persistent files have a header");
+
+      // Zero-initialise, such that unused words are deterministic on disk.
+      __meta_file_header<T> header {};
+      header.magic = __meta_file_header<T>::MAGIC;
+      header.version = __meta_file_header<T>::VERSION;
+      header.files = FILES;
+      header.elem_size = sizeof(T);
+      header.level_info_size = _level_info_file.size();
+      for (size_t idx = 0u; idx < FILES; idx++) {
+        header.sizes[idx] = _files[idx].size();
+      }
+      header.max_1level_cut = max_1level_cut;
+      header.number_of_sinks[false] = number_of_sinks[false];
+      header.number_of_sinks[true] = number_of_sinks[true];
+      FILE_CONSTANTS<T>::stats::save(header.stats);
+
+      tpie::file_stream<__meta_file_header<T>> fs;
+      fs.open(_path, tpie::access_type::access_read_write);
+      fs.seek(0);
+      fs.write(header);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Restore the meta information from the header of a persistent
+    ///        file.
+    ///
+    /// \throws std::runtime_error If the header is missing, is not of an Adiar
+    ///         file of this type and version, or if the content files next to
+    ///         it do not have the sizes recorded in the header.
+    ////////////////////////////////////////////////////////////////////////////
+    void load_header()
+    {
+      tpie::file_stream<__meta_file_header<T>> fs;
+      fs.open(_path, ADIAR_READ_ACCESS);
+
+      if (!fs.can_read()) {
+        throw std::runtime_error("'" + _path + "' is not an Adiar file: header is missing");
+      }
+      const __meta_file_header<T> header = fs.read();
+
+      if (header.magic != __meta_file_header<T>::MAGIC) {
+        throw std::runtime_error("'" + _path + "' is not an Adiar file");
+      }
+      if (header.version != __meta_file_header<T>::VERSION) {
+        throw std::runtime_error("'" + _path + "' is of an unsupported version ("
+                                 + std::to_string(header.version) + ")");
+      }
+      if (header.files != FILES || header.elem_size != sizeof(T)) {
+        throw std::runtime_error("'" + _path + "' has content of another type");
+      }
+
+      if (header.level_info_size != _level_info_file.size()) {
+        throw std::runtime_error("'" + _path + ".levels' does not match its header");
+      }
+      for (size_t idx = 0u; idx < FILES; idx++) {
+        if (header.sizes[idx] != _files[idx].size()) {
+          throw std::runtime_error("'" + _path + "." + std::to_string(idx)
+                                   + "' does not match its header");
+        }
+      }
+
+      max_1level_cut = header.max_1level_cut;
+      number_of_sinks[false] = header.number_of_sinks[false];
+      number_of_sinks[true] = header.number_of_sinks[true];
+      FILE_CONSTANTS<T>::stats::load(header.stats);
+    }
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Whether the file(s) are stored persistently on disk.
+    ////////////////////////////////////////////////////////////////////////////
+    bool is_persistent() const
+    {
+      return !_path.empty();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Path of a persistent file's header (empty if temporary).
+    ////////////////////////////////////////////////////////////////////////////
+    const std::string& path() const
+    {
+      return _path;
+    }
+
   public:
     ////////////////////////////////////////////////////////////////////////////
     /// \brief  Make the file read-only. This disallows use of any writers but
@@ -249,9 +685,14 @@ namespace adiar
     ///
     /// \remark Any writer should be detached from this object before making it
     ///         read only.
+    ///
+    /// \remark If the file is persistent, then this also stores its current
+    ///         meta information in its header on disk.
     ////////////////////////////////////////////////////////////////////////////
     void make_read_only() const
     {
+      if (is_persistent() && !is_read_only()) { save_header(); }
+
       _level_info_file.make_read_only();
       for (size_t idx = 0u; idx < FILES; idx++) {
         _files[idx].make_read_only();
@@ -279,6 +720,46 @@ namespace adiar
       return _level_info_file.is_read_only();
     }
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Whether the content of any of the file(s) has been moved to disk.
+    ////////////////////////////////////////////////////////////////////////////
+    bool is_on_disk() const
+    {
+      for (size_t idx = 0u; idx < FILES; idx++) {
+        if (_files[idx].is_on_disk()) {
+          return true;
+        };
+      }
+      return _level_info_file.is_on_disk();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Allow the file(s) to grow to (a total of) the given number of
+    ///        bytes in internal memory before being spilled to disk.
+    ///
+    /// \param levels An upper bound on the number of levels. The level
+    ///               information is only given room for these, and the rest is
+    ///               split equally between the content files. If unknown, then
+    ///               all files get an equal share.
+    ///
+    /// \sa file::set_internal_capacity
+    ////////////////////////////////////////////////////////////////////////////
+    void set_internal_capacity(size_t bytes,
+                               size_t levels = std::numeric_limits<size_t>::max()) const
+    {
+      const size_t level_info_bytes =
+        levels < bytes / (FILES + 1u) / sizeof(level_info_t)
+        ? levels * sizeof(level_info_t)
+        : bytes / (FILES + 1u);
+
+      _level_info_file.set_internal_capacity(level_info_bytes);
+
+      const size_t bytes_per_file = (bytes - level_info_bytes) / FILES;
+      for (size_t idx = 0u; idx < FILES; idx++) {
+        _files[idx].set_internal_capacity(bytes_per_file);
+      }
+    }
+
     ////////////////////////////////////////////////////////////////////////////
     /// \brief The number of elements in the file(s)
     ////////////////////////////////////////////////////////////////////////////
@@ -436,6 +917,18 @@ namespace adiar
   ////////////////////////////////////////////////////////////////////////////
   typedef simple_file<label_t> label_file;
 
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief A file of weights (e.g. probabilities or costs), where the i'th
+  ///        element is the weight of the variable with label i.
+  ////////////////////////////////////////////////////////////////////////////
+  typedef simple_file<double> weight_file;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief A file of bit-packed booleans, where the i'th boolean is bit
+  ///        (i mod 64) of the (i / 64)'th word.
+  ////////////////////////////////////////////////////////////////////////////
+  typedef simple_file<uint64_t> bitvector_file;
+
   ////////////////////////////////////////////////////////////////////////////
   /// \brief Provides sorting for <tt>simple_file</tt>.
   ///
@@ -449,11 +942,15 @@ namespace adiar
     {
       adiar_assert(!f.is_read_only(), "Cannot sort file after read-access");
 
-      tpie::file_stream<elem_t> fs;
-      fs.open(f._file_ptr -> _tpie_file);
+      if (!f._file_ptr -> _on_disk) {
+        std::sort(f._file_ptr -> _memory -> begin(), f._file_ptr -> _memory -> end(), pred);
+        return;
+      }
+
+      typename file<elem_t>::stream_t fs;
+      fs.open(f._file_ptr -> _tpie_file, tpie::access_type::access_read_write);
 
-      tpie::progress_indicator_null pi;
-      tpie::sort(fs, pred, pi);
+      __disk_stream<elem_t>::sort(fs, pred);
     }
   };
 
@@ -482,8 +979,8 @@ namespace adiar
     // Temporary node_file constructor
     node_file() = default;
 
-    // TODO: Persistent files with a filename
-    // node_file(const std::string &filename) : __shared_file(filename) { }
+    // Persistent node_file constructor
+    node_file(const std::string &filename) : __shared_file(filename) { }
 
     //////////////////////////////////////////////////////////////////////////////
     /// \brief Size of the meta file
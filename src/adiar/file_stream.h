@@ -36,7 +36,15 @@ namespace adiar
     T _peeked;
     bool _negate = false;
 
-    typename tpie::file_stream<T> _stream;
+    typename file<T>::stream_t _stream;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// The content of a small file is read from internal memory instead of
+    /// through <tt>_stream</tt>, which saves opening the file, allocating a
+    /// block, and reading its header.
+    ////////////////////////////////////////////////////////////////////////////
+    std::shared_ptr<const typename file<T>::memory_t> _view;
+    size_t _view_idx = 0u;
 
     ////////////////////////////////////////////////////////////////////////////
     /// The file stream includes a shared pointer to hook into the reference
@@ -63,7 +71,10 @@ namespace adiar
       _file_ptr = shared_ptr;
       _file_ptr -> make_read_only();
 
-      _stream.open(f._tpie_file, ADIAR_READ_ACCESS);
+      _view = f.view();
+      if (!_view) {
+        _stream.open(f._tpie_file, ADIAR_READ_ACCESS);
+      }
       _negate = negate;
 
       reset();
@@ -88,6 +99,11 @@ namespace adiar
     ////////////////////////////////////////////////////////////////////////////
     void reset()
     {
+      if (_view) {
+        _view_idx = REVERSE ? _view -> size() : 0u;
+        return;
+      }
+
       if constexpr (REVERSE) {
         _stream.seek(0, tpie::file_stream_base::end);
       } else {
@@ -95,13 +111,34 @@ namespace adiar
       }
     }
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Move the read head to the given position in the file, i.e. in
+    ///        front of the <tt>idx</tt>th element. When reading in reverse,
+    ///        the next element pulled is the one prior to that position.
+    ////////////////////////////////////////////////////////////////////////////
+    void seek(size_t idx)
+    {
+      _has_peeked = false;
+
+      if (_view) {
+        adiar_debug(idx <= _view -> size(), "Cannot seek past the end of the file");
+        _view_idx = idx;
+        return;
+      }
+      _stream.seek(idx);
+    }
+
     ////////////////////////////////////////////////////////////////////////////
     /// \brief Whether the stream contains more elements.
     ////////////////////////////////////////////////////////////////////////////
     bool can_pull()
     {
-      return _has_peeked
-        || (REVERSE ? _stream.can_read_back() : _stream.can_read());
+      if (_has_peeked) { return true; }
+
+      if (_view) {
+        return REVERSE ? 0u < _view_idx : _view_idx < _view -> size();
+      }
+      return REVERSE ? _stream.can_read_back() : _stream.can_read();
     }
 
     ////////////////////////////////////////////////////////////////////////////
@@ -113,7 +150,9 @@ namespace adiar
         _has_peeked = false;
         return _peeked;
       }
-      T t = REVERSE ? _stream.read_back() : _stream.read();
+      T t = _view
+        ? (*_view)[REVERSE ? --_view_idx : _view_idx++]
+        : (REVERSE ? _stream.read_back() : _stream.read());
       return _negate ? !t : t;
     }
 
@@ -142,7 +181,7 @@ namespace adiar
     ////////////////////////////////////////////////////////////////////////////
     bool attached()
     {
-      return _stream.is_open();
+      return _view || _stream.is_open();
     }
 
     ////////////////////////////////////////////////////////////////////////////
@@ -150,7 +189,8 @@ namespace adiar
     ////////////////////////////////////////////////////////////////////////////
     void detach()
     {
-      _stream.close();
+      if (_stream.is_open()) { _stream.close(); }
+      _view.reset();
       // if (_file_ptr) { _file_ptr.reset(); }
     }
   };
@@ -171,6 +211,14 @@ namespace adiar
   template<bool REVERSE = false>
   using label_stream = file_stream<label_t, REVERSE>;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief File streams for the words of bit-packed booleans.
+  ///
+  /// \param REVERSE Whether the reading direction should be reversed
+  //////////////////////////////////////////////////////////////////////////////
+  template<bool REVERSE = false>
+  using bitvector_stream = file_stream<uint64_t, REVERSE>;
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief         File stream of files with meta information.
   ///
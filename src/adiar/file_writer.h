@@ -1,7 +1,11 @@
 #ifndef ADIAR_FILE_WRITER_H
 #define ADIAR_FILE_WRITER_H
 
+#include <algorithm>
+#include <unordered_map>
+
 #include <tpie/file_stream.h>
+#include <tpie/sort.h>
 
 #include <adiar/data.h>
 #include <adiar/file.h>
@@ -10,6 +14,121 @@
 #include <adiar/internal/memory.h>
 
 namespace adiar {
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Append-only access to a single file, regardless of whether its
+  ///          content is in internal memory or on disk.
+  ///
+  /// \details Elements are appended in internal memory until the content would
+  ///          outgrow the file's internal capacity. Then it is spilled to disk
+  ///          and all further elements are written to disk.
+  ///
+  /// \param T Type of the file's content
+  //////////////////////////////////////////////////////////////////////////////
+  template <typename T>
+  class __file_appender
+  {
+  private:
+    file<T> *_file = nullptr;
+
+    typename file<T>::stream_t _stream;
+
+  private:
+    void open_stream()
+    {
+      _stream.open(_file -> _tpie_file, tpie::access_type::access_read_write);
+      _stream.seek(0, tpie::file_stream_base::end);
+    }
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Open the file for appending elements to it.
+    ////////////////////////////////////////////////////////////////////////////
+    void open(file<T> &f)
+    {
+      _file = &f;
+      if (_file -> _on_disk) { open_stream(); }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Whether the appender is attached to a file.
+    ////////////////////////////////////////////////////////////////////////////
+    bool is_open() const
+    {
+      return _file != nullptr;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Detach from the file.
+    ////////////////////////////////////////////////////////////////////////////
+    void close()
+    {
+      if (_stream.is_open()) { _stream.close(); }
+      _file = nullptr;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Append an element to the end of the file.
+    ////////////////////////////////////////////////////////////////////////////
+    void write(const T &t)
+    {
+      if (!_stream.is_open()) {
+        typename file<T>::memory_t &memory = *_file -> _memory;
+
+        const size_t max_elems = _file -> _internal_capacity / sizeof(T);
+        if (memory.size() < max_elems) {
+          // Grow geometrically (as push_back would), but never allocate more
+          // than the internal capacity.
+          if (memory.size() == memory.capacity()) {
+            memory.reserve(std::min(max_elems, std::max<size_t>(2u * memory.capacity(), 16u)));
+          }
+          memory.push_back(t);
+          return;
+        }
+
+        _file -> spill();
+        open_stream();
+      }
+      _stream.write(t);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Number of elements in the file.
+    ////////////////////////////////////////////////////////////////////////////
+    size_t size()
+    {
+      return _stream.is_open() ? _stream.size() : _file -> _memory -> size();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The last element of a non-empty file.
+    ////////////////////////////////////////////////////////////////////////////
+    T back()
+    {
+      adiar_debug(size() > 0, "Cannot obtain the last element of an empty file");
+
+      if (!_stream.is_open()) { return _file -> _memory -> back(); }
+
+      const T t = _stream.read_back();
+      _stream.read();
+      return t;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Sort the content of the file.
+    ////////////////////////////////////////////////////////////////////////////
+    template<typename pred_t>
+    void sort(pred_t pred)
+    {
+      if (!_stream.is_open()) {
+        std::sort(_file -> _memory -> begin(), _file -> _memory -> end(), pred);
+        return;
+      }
+
+      __disk_stream<T>::sort(_stream, pred);
+      _stream.seek(0, tpie::file_stream_base::end);
+    }
+  };
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief   Write-only access to a simple file including a consistency check
   ///          on the given input.
@@ -53,7 +172,7 @@ namespace adiar {
     ////////////////////////////////////////////////////////////////////////////
     std::shared_ptr<file<T>> _file_ptr;
 
-    tpie::file_stream<T> _stream;
+    __file_appender<T> _stream;
 
     Comp _comp = Comp();
 
@@ -66,8 +185,6 @@ namespace adiar {
 
     ~simple_file_writer() { detach(); }
 
-    void seek_end() { _stream.seek(0, tpie::file_stream_base::end); }
-
     ////////////////////////////////////////////////////////////////////////////
     /// \brief Attach to a file
     ////////////////////////////////////////////////////////////////////////////
@@ -78,14 +195,12 @@ namespace adiar {
 
       adiar_assert(!(_file_ptr -> is_read_only()), "Cannot attach a writer onto a read-only file");
 
-      _stream.open(_file_ptr -> _tpie_file, ADIAR_WRITE_ACCESS);
-      _stream.seek(0, tpie::file_stream_base::end);
+      _stream.open(*_file_ptr);
 
       // Set up tracker of latest element added
-      _has_latest = _stream.can_read_back();
+      _has_latest = _stream.size() > 0;
       if (_has_latest) {
-        _latest = _stream.read_back();
-        _stream.read();
+        _latest = _stream.back();
       }
     }
 
@@ -125,14 +240,11 @@ namespace adiar {
     {
       adiar_debug(attached(), "Cannot sort no content");
 
-      tpie::progress_indicator_null pi;
-      tpie::sort(_stream, pred, pi);
+      _stream.sort(pred);
 
       // Reset the _latest value.
-      _stream.seek(0, tpie::file_stream_base::end);
       if (_has_latest) {
-        _latest = _stream.read_back();
-        _stream.read();
+        _latest = _stream.back();
       }
     }
 
@@ -168,6 +280,8 @@ namespace adiar {
 
   typedef simple_file_writer<assignment_t, std::less<assignment_t>> assignment_writer;
   typedef simple_file_writer<label_t, no_ordering<label_t>> label_writer;
+  typedef simple_file_writer<double, no_ordering<double>> weight_writer;
+  typedef simple_file_writer<uint64_t, no_ordering<uint64_t>> bitvector_writer;
 
 
   //////////////////////////////////////////////////////////////////////////////
@@ -192,8 +306,8 @@ namespace adiar {
     ////////////////////////////////////////////////////////////////////////////
     std::shared_ptr<__meta_file<T>> _file_ptr;
 
-    tpie::file_stream<level_info_t> _meta_stream;
-    tpie::file_stream<T> _streams [FILE_CONSTANTS<T>::files];
+    __file_appender<level_info_t> _meta_stream;
+    __file_appender<T> _streams [FILE_CONSTANTS<T>::files];
 
   public:
     meta_file_writer() { }
@@ -216,15 +330,13 @@ namespace adiar {
       adiar_assert(!(_file_ptr -> _level_info_file.is_read_only()),
                    "Cannot attach a writer onto a read-only meta file");
 
-      _meta_stream.open(f._file_ptr -> _level_info_file._tpie_file);
-      _meta_stream.seek(0, tpie::file_stream_base::end);
+      _meta_stream.open(f._file_ptr -> _level_info_file);
 
       for (size_t idx = 0; idx < FILE_CONSTANTS<T>::files; idx++) {
         adiar_assert(!(_file_ptr -> _files[idx].is_read_only()),
                      "Cannot attach a writer onto a read-only content file");
 
-        _streams[idx].open(f._file_ptr -> _files[idx]._tpie_file);
-        _streams[idx].seek(0, tpie::file_stream_base::end);
+        _streams[idx].open(f._file_ptr -> _files[idx]);
       }
     }
 
@@ -306,10 +418,60 @@ namespace adiar {
     }
   };
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Finalizer of SplitMix64 to spread the bits of a single word.
+  //////////////////////////////////////////////////////////////////////////////
+  inline uint64_t __hash_mix(uint64_t x)
+  {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9u;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBu;
+    return x ^ (x >> 31);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Merkle hash of the (sub)diagram below a node, where index 1 is
+  ///          the hash of the same nodes with negated sinks.
+  ///
+  /// \details The hash of a node only depends on its label and the hashes of
+  ///          its children, and the hash of a sink only on its value. So, it
+  ///          does not depend on the identifiers of nodes and two isomorphic
+  ///          diagrams have the same hash. Both sinks have their own seed, so
+  ///          the hash of a negated diagram is obtained by swapping the seeds.
+  //////////////////////////////////////////////////////////////////////////////
+  struct node_hash
+  {
+    uint64_t value[2];
+  };
+
+  constexpr uint64_t __HASH_SINK_SEED[2] = { 0x9E3779B97F4A7C15u, 0xC2B2AE3D27D4EB4Fu };
+
+  inline node_hash hash_of_sink(const bool value)
+  {
+    return {{ __HASH_SINK_SEED[value], __HASH_SINK_SEED[!value] }};
+  }
+
+  inline node_hash hash_of_node(const label_t label, const node_hash &low, const node_hash &high)
+  {
+    node_hash h;
+    for (const bool negate : { false, true }) {
+      // Not symmetric in 'low' and 'high'
+      const uint64_t h_label = __hash_mix(static_cast<uint64_t>(label) + 1u);
+      h.value[negate] = __hash_mix(__hash_mix(h_label ^ low.value[negate]) + high.value[negate]);
+    }
+    return h;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief Writer for nodes, hiding derivation of all meta information and
   /// applying sanity checks on the validity of the input.
   ///
+  /// \details The hash of the last node pushed, i.e. the root, is the hash of
+  ///          the node_file. Algorithms that write many nodes, e.g. Reduce,
+  ///          provide the hash of each node themselves. Otherwise, the hash of
+  ///          a node is derived from the hashes of its children, which are
+  ///          looked up among the nodes pushed before. These are kept in
+  ///          internal memory until the writer is detached.
+  ///
   /// \sa node_file
   //////////////////////////////////////////////////////////////////////////////
   class node_writer: public meta_file_writer<node_t>
@@ -320,6 +482,42 @@ namespace adiar {
 
     size_t _level_size = 0u;
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Hashes of the nodes pushed without a hash.
+    ////////////////////////////////////////////////////////////////////////////
+    std::unordered_map<uid_t, node_hash> _hashes;
+
+  private:
+    node_hash __hash_of_child(const ptr_t p) const
+    {
+      if (is_sink(p)) { return hash_of_sink(value_of(p)); }
+
+      const auto it = _hashes.find(p);
+      adiar_debug(it != _hashes.end(), "Child must have been pushed before");
+      return it == _hashes.end() ? node_hash {{ 0u, 0u }} : it -> second;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Derive the hash of a node and make it the hash of the file.
+    ////////////////////////////////////////////////////////////////////////////
+    void __hash_push(const node_t &n)
+    {
+      if (is_sink(n)) {
+        __hash_set(hash_of_sink(value_of(n)));
+        return;
+      }
+
+      const node_hash h = hash_of_node(label_of(n), __hash_of_child(n.low), __hash_of_child(n.high));
+      _hashes[n.uid] = h;
+      __hash_set(h);
+    }
+
+    void __hash_set(const node_hash &h)
+    {
+      _file_ptr->hash[false] = h.value[false];
+      _file_ptr->hash[true] = h.value[true];
+    }
+
   public:
     node_writer() : meta_file_writer() { }
     node_writer(const node_file &nf) : meta_file_writer(nf),
@@ -386,6 +584,8 @@ namespace adiar {
       if (is_sink(n.high)) { _file_ptr->number_of_sinks[value_of(n.high)]++; }
       if (is_sink(n.uid)) { _file_ptr->number_of_sinks[value_of(n.uid)]++; }
 
+      __hash_push(n);
+
       // Write node to file
       _latest_node = n;
       _level_size++;
@@ -413,6 +613,22 @@ namespace adiar {
 
       if (is_sink(n.low)) { _file_ptr->number_of_sinks[value_of(n.low)]++; }
       if (is_sink(n.high)) { _file_ptr->number_of_sinks[value_of(n.high)]++; }
+
+      __hash_push(n);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Write directly to the underlying node file without any checks,
+    ///        where <tt>h</tt> is the hash of the given node.
+    ////////////////////////////////////////////////////////////////////////////
+    void unsafe_push(const node_t &n, const node_hash &h)
+    {
+      meta_file_writer::unsafe_push(n, 0);
+
+      if (is_sink(n.low)) { _file_ptr->number_of_sinks[value_of(n.low)]++; }
+      if (is_sink(n.high)) { _file_ptr->number_of_sinks[value_of(n.high)]++; }
+
+      __hash_set(h);
     }
 
     ////////////////////////////////////////////////////////////////////////////
@@ -440,6 +656,7 @@ namespace adiar {
                                                         _level_size));
         _level_size = 0u; // move to attach...
       }
+      _hashes.clear();
       return meta_file_writer::detach();
     }
 
@@ -547,8 +764,7 @@ namespace adiar {
     //////////////////////////////////////////////////////////////////////////////
     void detach() {
       if (attached() && _streams[2].size() > 0) {
-        tpie::progress_indicator_null pi;
-        tpie::sort(_streams[2], arc_source_lt(), pi);
+        _streams[2].sort(arc_source_lt());
       }
 
       return meta_file_writer::detach();
@@ -0,0 +1,147 @@
+#include "async.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <adiar/internal/assert.h>
+#include <adiar/internal/memory.h>
+
+namespace adiar
+{
+  namespace async
+  {
+    // Set by 'adiar_set_async_workers' while tasks may be submitted.
+    std::atomic<size_t> _workers { 0u };
+
+    void set_workers(size_t workers)
+    {
+      _workers = workers;
+    }
+
+    size_t get_workers()
+    {
+      const size_t workers = _workers;
+      if (workers != 0u) { return workers; }
+      return std::max<size_t>(1u, std::thread::hardware_concurrency());
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // State of the pool (guarded by '_mutex')
+    std::mutex _mutex;
+    std::condition_variable _cv;
+
+    std::vector<std::thread> _threads;
+    bool _stop = false;
+
+    // Tasks with all their dependencies done.
+    std::deque<std::shared_ptr<task>> _ready;
+
+    // Tasks submitted, but not yet done.
+    size_t _pending = 0u;
+
+    // Tasks currently running on a worker.
+    size_t _running = 0u;
+
+    void __run()
+    {
+      while (true) {
+        std::shared_ptr<task> t;
+        {
+          std::unique_lock<std::mutex> lock(_mutex);
+          _cv.wait(lock, []() {
+            return (_stop && _ready.empty())
+              || (!_ready.empty() && _running < _ready.front() -> concurrency);
+          });
+          if (_ready.empty()) { return; }
+
+          t = std::move(_ready.front());
+          _ready.pop_front();
+          _running++;
+        }
+
+        memory::_context_limit = t -> memory;
+        memory::_context_path = t -> path;
+        adiar_statsreset();
+
+        t -> work();
+        t -> work = nullptr;
+
+        {
+          std::lock_guard<std::mutex> lock(t -> stats -> mutex);
+          __stats_add(t -> stats -> stats, __stats_collect());
+        }
+        t -> stats = nullptr;
+
+        {
+          std::lock_guard<std::mutex> lock(_mutex);
+          t -> done = true;
+          _pending--;
+          _running--;
+
+          for (std::shared_ptr<task> &d : t -> dependents) {
+            if (--(d -> waiting) == 0u) { _ready.push_back(std::move(d)); }
+          }
+          t -> dependents.clear();
+        }
+        _cv.notify_all();
+      }
+    }
+
+    std::shared_ptr<task> submit(std::function<void()> &&work,
+                                 const std::vector<std::shared_ptr<task>> &deps)
+    {
+      std::shared_ptr<task> t = std::make_shared<task>();
+      t -> work = std::move(work);
+      t -> path = memory::_context_path;
+      t -> stats = __stats_get_inbox();
+
+      std::unique_lock<std::mutex> lock(_mutex);
+
+      if (_threads.empty()) {
+        _stop = false;
+
+        const size_t workers = get_workers();
+        for (size_t i = 0u; i < workers; i++) {
+          _threads.emplace_back(__run);
+        }
+      }
+      const size_t available = memory::available();
+      t -> concurrency = std::max<size_t>(1u, std::min(_threads.size(), available / MINIMUM_TASK_BYTES));
+      t -> memory = available / t -> concurrency;
+
+      for (const std::shared_ptr<task> &d : deps) {
+        if (!d || d -> done) { continue; }
+
+        t -> waiting++;
+        d -> dependents.push_back(t);
+      }
+
+      _pending++;
+      if (t -> waiting == 0u) {
+        _ready.push_back(t);
+        lock.unlock();
+        _cv.notify_all();
+      }
+      return t;
+    }
+
+    void shutdown()
+    {
+      std::vector<std::thread> threads;
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cv.wait(lock, []() { return _pending == 0u; });
+
+        _stop = true;
+        threads.swap(_threads);
+      }
+      _cv.notify_all();
+
+      for (std::thread &w : threads) { w.join(); }
+    }
+  }
+}
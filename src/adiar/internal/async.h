@@ -0,0 +1,119 @@
+#ifndef ADIAR_INTERNAL_ASYNC_H
+#define ADIAR_INTERNAL_ASYNC_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <adiar/statistics.h>
+
+namespace adiar
+{
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   A pool of worker threads on which operations are run
+  ///          asynchronously once all the operations they depend on are done.
+  ///
+  /// \details The internal memory available to the submitting thread is split
+  ///          equally between the operations that may run concurrently. To not
+  ///          starve them, at most as many run concurrently as each can get
+  ///          <tt>MINIMUM_TASK_BYTES</tt> of memory (but always at least one).
+  ///
+  ///          The statistics of an operation are added to the ones of the
+  ///          thread (or the <tt>adiar_context</tt>) that submitted it, when it
+  ///          is done.
+  //////////////////////////////////////////////////////////////////////////////
+  namespace async
+  {
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Sets the number of worker threads. The default of 0 uses as
+    ///        many as the hardware supports.
+    ///
+    /// \remark This only has an effect on the next start of the pool, i.e. when
+    ///         it was not yet used or after <tt>shutdown()</tt>.
+    ////////////////////////////////////////////////////////////////////////////
+    void set_workers(size_t workers = 0u);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The number of worker threads.
+    ////////////////////////////////////////////////////////////////////////////
+    size_t get_workers();
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The least amount of memory (bytes) that an operation is split
+    ///        into, if more is available to the submitting thread.
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr size_t MINIMUM_TASK_BYTES = 32 * 1024 * 1024;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief An operation that is scheduled on the pool.
+    ////////////////////////////////////////////////////////////////////////////
+    struct task
+    {
+      //////////////////////////////////////////////////////////////////////////
+      /// \brief The work to be done. It is released as soon as it is done, such
+      ///        that its inputs can be garbage collected.
+      //////////////////////////////////////////////////////////////////////////
+      std::function<void()> work;
+
+      //////////////////////////////////////////////////////////////////////////
+      /// \brief The internal memory (bytes) available to <tt>work</tt>.
+      //////////////////////////////////////////////////////////////////////////
+      size_t memory = 0u;
+
+      //////////////////////////////////////////////////////////////////////////
+      /// \brief The number of tasks (including this one) that <tt>memory</tt>
+      ///        has been split between, i.e. this task only starts when fewer
+      ///        than that many tasks are running.
+      //////////////////////////////////////////////////////////////////////////
+      size_t concurrency = 1u;
+
+      //////////////////////////////////////////////////////////////////////////
+      /// \brief The directory of temporary files for <tt>work</tt>.
+      //////////////////////////////////////////////////////////////////////////
+      std::string path;
+
+      //////////////////////////////////////////////////////////////////////////
+      /// \brief Where the statistics of <tt>work</tt> are added to.
+      //////////////////////////////////////////////////////////////////////////
+      std::shared_ptr<__stats_inbox> stats;
+
+      //////////////////////////////////////////////////////////////////////////
+      /// \brief Number of dependencies that are not yet done.
+      //////////////////////////////////////////////////////////////////////////
+      size_t waiting = 0u;
+
+      //////////////////////////////////////////////////////////////////////////
+      /// \brief Whether <tt>work</tt> has been done.
+      //////////////////////////////////////////////////////////////////////////
+      bool done = false;
+
+      //////////////////////////////////////////////////////////////////////////
+      /// \brief Tasks waiting for this one.
+      //////////////////////////////////////////////////////////////////////////
+      std::vector<std::shared_ptr<task>> dependents;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief   Schedule <tt>work</tt> to be run on the pool once all of its
+    ///          dependencies are done.
+    ///
+    /// \details The pool is started, if it is not running yet. The work itself
+    ///          should not throw, but rather pass on any exception in its
+    ///          result.
+    ///
+    /// \param deps The tasks that have to be done first (<tt>nullptr</tt> for
+    ///             any input that is not computed asynchronously).
+    ////////////////////////////////////////////////////////////////////////////
+    std::shared_ptr<task> submit(std::function<void()> &&work,
+                                 const std::vector<std::shared_ptr<task>> &deps);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Wait for all tasks to be done and stop the workers.
+    ////////////////////////////////////////////////////////////////////////////
+    void shutdown();
+  }
+}
+
+#endif // ADIAR_INTERNAL_ASYNC_H
@@ -0,0 +1,120 @@
+#ifndef ADIAR_INTERNAL_BIG_UINT_H
+#define ADIAR_INTERNAL_BIG_UINT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+namespace adiar
+{
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Unsigned integer of a fixed number of 64-bit words.
+  ///
+  /// \details This is a POD, such that it can be placed inside of the elements
+  ///          of (external memory) priority queues and sorters. Only the
+  ///          operations needed to count paths and assignments are provided.
+  ///          All operations are modulo 2^(64 * WORDS).
+  ///
+  /// \param WORDS Number of 64-bit words (least significant first)
+  //////////////////////////////////////////////////////////////////////////////
+  template<size_t WORDS>
+  struct big_uint
+  {
+    static_assert(0 < WORDS, "Must consist of at least one word");
+
+    static constexpr size_t BITS = 64u * WORDS;
+
+    uint64_t words[WORDS];
+
+    static big_uint from(uint64_t x)
+    {
+      big_uint res;
+      std::fill(res.words, res.words + WORDS, 0u);
+      res.words[0] = x;
+      return res;
+    }
+
+    bool is_zero() const
+    {
+      return std::all_of(words, words + WORDS, [](uint64_t w) { return w == 0u; });
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The sum of this and the given number.
+    ////////////////////////////////////////////////////////////////////////////
+    big_uint operator+ (const big_uint &o) const
+    {
+      big_uint res;
+      uint64_t carry = 0u;
+      for (size_t i = 0u; i < WORDS; i++) {
+        const uint64_t s = words[i] + carry;
+        carry = s < carry;
+        res.words[i] = s + o.words[i];
+        carry += res.words[i] < s;
+      }
+      return res;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief This number multiplied by 2^k.
+    ////////////////////////////////////////////////////////////////////////////
+    big_uint operator<< (size_t k) const
+    {
+      big_uint res = from(0u);
+      if (BITS <= k) { return res; }
+
+      const size_t word_shift = k / 64u;
+      const size_t bit_shift  = k % 64u;
+
+      for (size_t i = WORDS; word_shift < i--; ) {
+        const size_t j = i - word_shift;
+        res.words[i] = words[j] << bit_shift;
+        if (bit_shift != 0u && 0u < j) {
+          res.words[i] |= words[j-1u] >> (64u - bit_shift);
+        }
+      }
+      return res;
+    }
+
+    bool operator== (const big_uint &o) const
+    {
+      return std::equal(words, words + WORDS, o.words);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Decimal representation of the number.
+    ////////////////////////////////////////////////////////////////////////////
+    std::string to_string() const
+    {
+      // Repeatedly divide by 10^9, such that the remainder (< 2^30) followed by
+      // 32 bits of the dividend fits into a single 64-bit word.
+      constexpr uint64_t base = 1000000000u;
+
+      big_uint x = *this;
+      std::string res;
+
+      do {
+        uint64_t rem = 0u;
+        for (size_t i = WORDS; 0u < i--; ) {
+          const uint64_t hi = (rem << 32) | (x.words[i] >> 32);
+          const uint64_t q_hi = hi / base;
+          rem = hi % base;
+
+          const uint64_t lo = (rem << 32) | (x.words[i] & 0xFFFFFFFFu);
+          const uint64_t q_lo = lo / base;
+          rem = lo % base;
+
+          x.words[i] = (q_hi << 32) | q_lo;
+        }
+
+        std::string digits = std::to_string(rem);
+        if (!x.is_zero()) { digits.insert(0u, 9u - digits.size(), '0'); }
+        res.insert(0u, digits);
+      } while (!x.is_zero());
+
+      return res;
+    }
+  };
+}
+
+#endif // ADIAR_INTERNAL_BIG_UINT_H
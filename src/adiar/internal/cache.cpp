@@ -0,0 +1,168 @@
+#include "cache.h"
+
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include <adiar/internal/assert.h>
+
+namespace adiar
+{
+  thread_local stats_t::cache_t stats_cache;
+
+  namespace cache
+  {
+    struct entry
+    {
+      key k;
+      result r;
+      size_t bytes;
+    };
+
+    typedef std::list<entry>::iterator entry_it;
+
+    size_t _limit = 0u;
+    size_t _size = 0u;
+
+    // Entries from the most to the least recently used together with an index
+    // on the hash of their key.
+    std::list<entry> _entries;
+    std::unordered_multimap<size_t, entry_it> _index;
+
+    std::mutex _mutex;
+
+    size_t __hash(const key &k)
+    {
+      size_t h = std::hash<size_t>()(k.arg);
+      h = h * 31u + static_cast<size_t>(k.op);
+      h = h * 31u + std::hash<const void*>()(k.in_ptr[0]);
+      h = h * 31u + std::hash<const void*>()(k.in_ptr[1]);
+      h = h * 31u + (k.negate[0] << 1u) + k.negate[1];
+      return h;
+    }
+
+    bool __same_key(const key &a, const key &b)
+    {
+      return a.op == b.op && a.arg == b.arg
+        && a.in_ptr[0] == b.in_ptr[0] && a.in_ptr[1] == b.in_ptr[1]
+        && a.negate[0] == b.negate[0] && a.negate[1] == b.negate[1];
+    }
+
+    // Whether an input of the entry has been garbage collected, in which case
+    // the same address may by now be used for another file.
+    bool __is_stale(const entry &e)
+    {
+      return e.k.in[0].expired() || e.k.in[1].expired();
+    }
+
+    void __erase(const entry_it it)
+    {
+      const auto range = _index.equal_range(__hash(it -> k));
+      for (auto idx = range.first; idx != range.second; idx++) {
+        if (idx -> second == it) {
+          _index.erase(idx);
+          break;
+        }
+      }
+
+      _size -= it -> bytes;
+      _entries.erase(it);
+    }
+
+    void __evict(const size_t limit)
+    {
+      if (_size <= limit) { return; }
+
+      // Drop all entries of which an input is gone
+      for (auto it = _entries.begin(); it != _entries.end();) {
+        const entry_it curr = it++;
+        if (__is_stale(*curr)) { __erase(curr); }
+      }
+
+      // Drop the least recently used until the limit is met
+      while (_size > limit) {
+#ifdef ADIAR_STATS
+        stats_cache.evictions++;
+#endif
+        __erase(std::prev(_entries.end()));
+      }
+    }
+
+    void set_limit(size_t bytes)
+    {
+      std::lock_guard<std::mutex> guard(_mutex);
+
+      _limit = bytes;
+      __evict(_limit);
+    }
+
+    size_t get_limit()
+    {
+      std::lock_guard<std::mutex> guard(_mutex);
+      return _limit;
+    }
+
+    size_t size()
+    {
+      std::lock_guard<std::mutex> guard(_mutex);
+      return _size;
+    }
+
+    void clear()
+    {
+      std::lock_guard<std::mutex> guard(_mutex);
+
+      _index.clear();
+      _entries.clear();
+      _size = 0u;
+    }
+
+    std::optional<result> lookup(const key &k)
+    {
+      std::lock_guard<std::mutex> guard(_mutex);
+
+      const auto range = _index.equal_range(__hash(k));
+      for (auto idx = range.first; idx != range.second; idx++) {
+        const entry_it it = idx -> second;
+        if (!__same_key(it -> k, k)) { continue; }
+
+        if (__is_stale(*it)) {
+          __erase(it);
+          break;
+        }
+
+#ifdef ADIAR_STATS
+        stats_cache.hits++;
+#endif
+        // Move it to the front as the most recently used
+        _entries.splice(_entries.begin(), _entries, it);
+        return it -> r;
+      }
+
+#ifdef ADIAR_STATS
+      stats_cache.misses++;
+#endif
+      return std::nullopt;
+    }
+
+    void insert(const key &k, const __decision_diagram &out)
+    {
+      adiar_debug(out.has<node_file>(), "Only reduced results are cached");
+
+      const node_file &f = out.get<node_file>();
+      const size_t bytes = f.file_size();
+
+      std::lock_guard<std::mutex> guard(_mutex);
+
+      // A result larger than the entire cache is not worth evicting for
+      if (_limit < bytes) { return; }
+
+      _entries.push_front({ k, { f, out.negate }, bytes });
+      _index.insert({ __hash(k), _entries.begin() });
+      _size += bytes;
+
+      __evict(_limit);
+    }
+  }
+}
@@ -0,0 +1,176 @@
+#ifndef ADIAR_INTERNAL_CACHE_H
+#define ADIAR_INTERNAL_CACHE_H
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <typeinfo>
+
+#include <adiar/data.h>
+#include <adiar/file.h>
+#include <adiar/statistics.h>
+
+#include <adiar/internal/decision_diagram.h>
+
+namespace adiar
+{
+  //////////////////////////////////////////////////////////////////////////////
+  /// Struct to hold statistics
+  extern thread_local stats_t::cache_t stats_cache;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief A process-wide cache of the (reduced) results of top-level
+  ///        operations, such as <tt>bdd_apply</tt> and <tt>bdd_exists</tt>.
+  ///
+  /// \details The inputs are identified by their underlying files, i.e. two
+  ///          decision diagrams share a result if they share a file (and the
+  ///          negation flag). The cache does not keep the inputs alive and an
+  ///          entry is dropped as soon as one of its inputs is gone. The
+  ///          results are evicted in least-recently-used order as soon as the
+  ///          size of their files exceeds the limit.
+  //////////////////////////////////////////////////////////////////////////////
+  namespace cache
+  {
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The operations with a cached result.
+    ////////////////////////////////////////////////////////////////////////////
+    enum class operation : unsigned char
+    {
+      BDD_APPLY,
+      BDD_EXISTS,
+      BDD_FORALL,
+      ZDD_BINOP,
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Identity of an operation on one or two inputs.
+    ////////////////////////////////////////////////////////////////////////////
+    struct key
+    {
+      operation op;
+
+      // Identity of the operator, e.g. the hash of its type, or any other
+      // argument of the operation.
+      size_t arg;
+
+      std::weak_ptr<const void> in [2];
+      const void* in_ptr [2];
+      bool negate [2];
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief A cached (reduced) result.
+    ////////////////////////////////////////////////////////////////////////////
+    struct result
+    {
+      node_file file;
+      bool negate;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Sets the maximum number of bytes of the results kept in the
+    ///        cache. Setting this to 0 disables (and clears) the cache.
+    ////////////////////////////////////////////////////////////////////////////
+    void set_limit(size_t bytes);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of bytes of results kept in the cache.
+    ////////////////////////////////////////////////////////////////////////////
+    size_t get_limit();
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Number of bytes of the results currently kept in the cache.
+    ////////////////////////////////////////////////////////////////////////////
+    size_t size();
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Drop all entries, e.g. before the files are closed by TPIE.
+    ////////////////////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Look up the result for the given key.
+    ////////////////////////////////////////////////////////////////////////////
+    std::optional<result> lookup(const key &k);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Add the result for the given key, evicting the least-recently
+    ///        used entries if the limit is exceeded.
+    ////////////////////////////////////////////////////////////////////////////
+    void insert(const key &k, const __decision_diagram &out);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Key for a binary operation with the given operator. There is
+    ///        none, if the cache is disabled or the operator is not one of the
+    ///        predefined ones in <tt>data.h</tt>.
+    ////////////////////////////////////////////////////////////////////////////
+    inline std::optional<key> key_of(const operation op,
+                                     const decision_diagram &in_1,
+                                     const decision_diagram &in_2,
+                                     const bool_op &bin_op)
+    {
+      if (get_limit() == 0u) { return std::nullopt; }
+
+      // A generic bool_op cannot be told apart from another one.
+      const size_t op_type = bool_op_dispatch(bin_op, [](const auto &static_op) {
+        return typeid(static_op).hash_code();
+      });
+      if (op_type == typeid(bool_op).hash_code()) { return std::nullopt; }
+
+      const __decision_diagram dd_1(in_1);
+      const __decision_diagram dd_2(in_2);
+
+      const node_file &f_1 = dd_1.get<node_file>();
+      const node_file &f_2 = dd_2.get<node_file>();
+
+      return key { op, op_type,
+                   { f_1._file_ptr, f_2._file_ptr },
+                   { f_1._file_ptr.get(), f_2._file_ptr.get() },
+                   { dd_1.negate, dd_2.negate } };
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Key for an operation with a list of labels. There is none, if
+    ///        the cache is disabled.
+    ///
+    /// \remark A label_file may still be extended after it has been used, so
+    ///         its size is part of the key.
+    ////////////////////////////////////////////////////////////////////////////
+    inline std::optional<key> key_of(const operation op,
+                                     const decision_diagram &in,
+                                     const label_file &labels)
+    {
+      if (get_limit() == 0u) { return std::nullopt; }
+
+      const __decision_diagram dd(in);
+      const node_file &f = dd.get<node_file>();
+
+      return key { op, labels.size(),
+                   { f._file_ptr, labels._file_ptr },
+                   { f._file_ptr.get(), labels._file_ptr.get() },
+                   { dd.negate, false } };
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Obtain the result of 'compute' from the cache, if possible, and
+    ///        otherwise add it to the cache.
+    ///
+    /// \details Without a key, the (possibly unreduced) result of 'compute' is
+    ///          returned as is.
+    ////////////////////////////////////////////////////////////////////////////
+    template<typename dd_t, typename __dd_t, typename compute_f>
+    __dd_t memoize(const std::optional<key> &k, const compute_f &compute)
+    {
+      if (!k) { return compute(); }
+
+      const std::optional<result> r = lookup(*k);
+      if (r) { return dd_t(r->file, r->negate); }
+
+      dd_t out = compute();
+      insert(*k, out);
+      return out;
+    }
+  }
+}
+
+#endif // ADIAR_INTERNAL_CACHE_H
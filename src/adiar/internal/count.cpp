@@ -1,5 +1,5 @@
 #include "count.h"
 
 namespace adiar {
-  stats_t::count_t stats_count;
+  thread_local stats_t::count_t stats_count;
 }
@@ -1,10 +1,18 @@
 #ifndef ADIAR_INTERNAL_COUNT_H
 #define ADIAR_INTERNAL_COUNT_H
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
 #include <adiar/data.h>
 #include <adiar/file_stream.h>
+#include <adiar/file_writer.h>
 
 #include <adiar/internal/assert.h>
+#include <adiar/internal/big_uint.h>
 #include <adiar/internal/levelized_priority_queue.h>
 #include <adiar/internal/util.h>
 
@@ -12,14 +20,167 @@ namespace adiar
 {
   //////////////////////////////////////////////////////////////////////////////
   /// Struct to hold statistics
-  extern stats_t::count_t stats_count;
+  extern thread_local stats_t::count_t stats_count;
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Arithmetic
+  //
+  // The sweep only adds numbers and multiplies them with powers of two. How
+  // this is done is given by an arithmetic object with a 'value_t' and the
+  // (const) functions 'zero()', 'one()', 'add(a,b)', and 'shift(a,k)' for a *
+  // 2^k. Each value_t has a fixed size, such that a request is still a POD that
+  // can be spilled to disk.
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Native 64-bit arithmetic, i.e. modulo 2^64.
+  //////////////////////////////////////////////////////////////////////////////
+  struct uint64_arithmetic
+  {
+    typedef uint64_t value_t;
+
+    value_t zero() const { return 0u; }
+    value_t one() const { return 1u; }
+
+    value_t add(const value_t a, const value_t b) const
+    { return a + b; }
+
+    value_t shift(const value_t a, const label_t k) const
+    { return k < 64u ? a << k : 0u; }
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Arithmetic modulo a given (64-bit) number.
+  //////////////////////////////////////////////////////////////////////////////
+  struct modular_arithmetic
+  {
+    typedef uint64_t value_t;
+
+    const uint64_t modulus;
+
+    value_t zero() const { return 0u; }
+    value_t one() const { return 1u % modulus; }
+
+    value_t add(const value_t a, const value_t b) const
+    { return modulus - b <= a ? a - (modulus - b) : a + b; }
+
+    value_t shift(value_t a, label_t k) const
+    {
+      // Multiply with 2^k by repeated squaring of 2
+      for (uint64_t p = 2u % modulus; 0u < k; k >>= 1) {
+        if (k & 1u) { a = mul(a, p); }
+        p = mul(p, p);
+      }
+      return a;
+    }
+
+  private:
+    value_t mul(value_t a, value_t b) const
+    {
+      // Double-and-add, unless the product fits into 64 bits
+      if (a < (1ull << 32) && b < (1ull << 32)) { return (a * b) % modulus; }
+
+      value_t res = 0u;
+      for (; 0u < b; b >>= 1) {
+        if (b & 1u) { res = add(res, a); }
+        a = add(a, a);
+      }
+      return res;
+    }
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Arithmetic on the base 2 logarithm of (non-negative) numbers, such
+  ///        that (very) large counts can be approximated.
+  //////////////////////////////////////////////////////////////////////////////
+  struct log2_arithmetic
+  {
+    typedef double value_t;
+
+    value_t zero() const { return -std::numeric_limits<double>::infinity(); }
+    value_t one() const { return 0.0; }
+
+    value_t add(const value_t a, const value_t b) const
+    {
+      const value_t max = std::max(a, b);
+      const value_t min = std::min(a, b);
+
+      if (min == zero()) { return max; }
+      return max + std::log1p(std::exp2(min - max)) / std::log(2.0);
+    }
+
+    value_t shift(const value_t a, const label_t k) const
+    { return a + k; }
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Exact arithmetic on unsigned integers with the given number of
+  ///        64-bit words.
+  //////////////////////////////////////////////////////////////////////////////
+  template<size_t WORDS>
+  struct big_uint_arithmetic
+  {
+    typedef big_uint<WORDS> value_t;
+
+    value_t zero() const { return value_t::from(0u); }
+    value_t one() const { return value_t::from(1u); }
+
+    value_t add(const value_t &a, const value_t &b) const
+    { return a + b; }
+
+    value_t shift(const value_t &a, const label_t k) const
+    { return a << k; }
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief The largest number of words used for exact counting, i.e. up to
+  ///        65535 variables.
+  //////////////////////////////////////////////////////////////////////////////
+  constexpr size_t BIG_UINT_MAX_WORDS = 1024u;
+
+  template<size_t WORDS, typename big_uint_f>
+  inline auto __big_uint_dispatch(const size_t bits, const big_uint_f &f)
+  {
+    if constexpr (WORDS < BIG_UINT_MAX_WORDS) {
+      if (big_uint<WORDS>::BITS < bits) {
+        return __big_uint_dispatch<2u * WORDS>(bits, f);
+      }
+    }
+    return f(big_uint_arithmetic<WORDS>());
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Call <tt>f</tt> with the big_uint_arithmetic (with the fewest
+  ///          words) that can represent all numbers of the given number of
+  ///          bits. Larger numbers make the requests larger, which makes the
+  ///          priority queue spill to disk sooner.
+  ///
+  /// \details The number of words is doubled from one up to
+  ///          <tt>BIG_UINT_MAX_WORDS</tt>, such that at most half of each
+  ///          number is wasted.
+  ///
+  /// \throws std::overflow_error If more than
+  ///         <tt>big_uint<BIG_UINT_MAX_WORDS>::BITS</tt> bits are needed (or if
+  ///         the external memory priority queue of such large numbers does not
+  ///         fit into memory when <tt>f</tt> counts with it).
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename big_uint_f>
+  inline auto big_uint_dispatch(const size_t bits, const big_uint_f &f)
+  {
+    if (big_uint<BIG_UINT_MAX_WORDS>::BITS < bits) {
+      throw std::overflow_error("Exact counts are only supported for up to "
+                                + std::to_string(big_uint<BIG_UINT_MAX_WORDS>::BITS - 1u)
+                                + " variables");
+    }
+    return __big_uint_dispatch<1u>(bits, f);
+  }
 
   //////////////////////////////////////////////////////////////////////////////
   // Data structures
+  template<typename value_t>
   struct path_sum
   {
     uid_t uid;
-    uint64_t sum;
+    value_t sum;
   };
 
   //////////////////////////////////////////////////////////////////////////////
@@ -29,16 +190,17 @@ namespace adiar
 
   struct count_queue_label
   {
-    inline static label_t label_of(const path_sum &s)
+    template<typename T>
+    inline static label_t label_of(const T &s)
     {
       return adiar::label_of(s.uid);
     }
   };
 
-  template<>
-  struct count_queue_lt<path_sum>
+  template<typename value_t>
+  struct count_queue_lt<path_sum<value_t>>
   {
-    bool operator()(const path_sum &a, const path_sum &b)
+    bool operator()(const path_sum<value_t> &a, const path_sum<value_t> &b)
     {
       return a.uid < b.uid;
     }
@@ -53,33 +215,37 @@ namespace adiar
 
   //////////////////////////////////////////////////////////////////////////////
   // Variadic behaviour
+  template<typename arithmetic_t = uint64_arithmetic>
   class path_count_policy
   {
   public:
-    typedef path_sum queue_t;
+    typedef arithmetic_t arith_t;
+    typedef typename arith_t::value_t value_t;
+    typedef path_sum<value_t> queue_t;
 
     template<typename count_pq_t>
-    inline static uint64_t forward_request(count_pq_t &count_pq,
-                                           const label_t /* varcount */,
-                                           const ptr_t child_to_resolve,
-                                           const queue_t &request)
+    inline static value_t forward_request(count_pq_t &count_pq,
+                                          const arith_t &arith,
+                                          const label_t /* varcount */,
+                                          const ptr_t child_to_resolve,
+                                          const queue_t &request)
     {
-      adiar_debug(request.sum > 0, "No 'empty' request should be created");
-
       if (is_sink(child_to_resolve)) {
-        return value_of(child_to_resolve) ? request.sum : 0u;
+        return value_of(child_to_resolve) ? request.sum : arith.zero();
       } else {
         count_pq.push({ child_to_resolve, request.sum });
-        return 0u;
+        return arith.zero();
       }
     }
 
-    inline static queue_t combine_requests(const queue_t &acc, const queue_t &next)
+    inline static queue_t combine_requests(const arith_t &arith,
+                                           const queue_t &acc,
+                                           const queue_t &next)
     {
       adiar_debug(acc.uid == next.uid,
                   "Requests should be for the same node");
 
-      return { acc.uid, acc.sum + next.sum };
+      return { acc.uid, arith.add(acc.sum, next.sum) };
     }
   };
 
@@ -101,23 +267,24 @@ namespace adiar
 
   //////////////////////////////////////////////////////////////////////////////
   template<typename count_policy, typename count_pq_t>
-  uint64_t __count(const decision_diagram &dd,
-                   const label_t varcount,
-                   const size_t pq_max_memory,
-                   const size_t pq_max_size)
+  typename count_policy::value_t __count(const decision_diagram &dd,
+                                         const label_t varcount,
+                                         const typename count_policy::arith_t &arith,
+                                         const size_t pq_max_memory,
+                                         const size_t pq_max_size)
   {
     node_stream<> ns(dd);
 
-    count_pq_t count_pq({dd}, pq_max_memory, pq_max_size);
+    count_pq_t count_pq({dd}, pq_max_memory, pq_max_size, &stats_count);
 
-    uint64_t result = 0u;
+    typename count_policy::value_t result = arith.zero();
 
     {
       node_t root = ns.pull();
-      typename count_policy::queue_t request = { root.uid, 1u };
+      typename count_policy::queue_t request = { root.uid, arith.one() };
 
-      result += count_policy::forward_request(count_pq, varcount, root.low, request);
-      result += count_policy::forward_request(count_pq, varcount, root.high, request);
+      result = arith.add(result, count_policy::forward_request(count_pq, arith, varcount, root.low, request));
+      result = arith.add(result, count_policy::forward_request(count_pq, arith, varcount, root.high, request));
     }
 
     // Take out the rest of the nodes and process them one by one
@@ -136,18 +303,20 @@ namespace adiar
       typename count_policy::queue_t request = count_pq.pull();
 
       while (count_pq.can_pull() && count_pq.top().uid == n.uid) {
-        request = count_policy::combine_requests(request, count_pq.pull());
+        request = count_policy::combine_requests(arith, request, count_pq.pull());
       }
 
-      result += count_policy::forward_request(count_pq, varcount, n.low, request);
-      result += count_policy::forward_request(count_pq, varcount, n.high, request);
+      result = arith.add(result, count_policy::forward_request(count_pq, arith, varcount, n.low, request));
+      result = arith.add(result, count_policy::forward_request(count_pq, arith, varcount, n.high, request));
     }
 
     return result;
   }
 
   template<typename count_policy>
-  uint64_t count(const decision_diagram &dd, const label_t varcount)
+  typename count_policy::value_t count(const decision_diagram &dd,
+                                       const label_t varcount,
+                                       const typename count_policy::arith_t &arith = {})
   {
     adiar_debug(!is_sink(dd),
                 "Count algorithm does not work on sink-only edge case");
@@ -157,10 +326,14 @@ namespace adiar
     //
     // We then may derive an upper bound on the size of auxiliary data
     // structures and check whether we can run them with a faster internal
-    // memory variant.
+    // memory variant. Since the size of a request depends on the arithmetic,
+    // large numbers make the priority queue spill to disk.
     const size_t max_pq_size = __count_max_cut_upper_bound(dd);
 
-    const size_t aux_available_memory = memory::available() - node_stream<>::memory_usage();
+    const size_t stream_memory = node_stream<>::memory_usage();
+    const size_t aux_available_memory = stream_memory < memory::available()
+      ? memory::available() - stream_memory
+      : 0u;
 
     const size_t pq_memory_fits =
       count_priority_queue_t<typename count_policy::queue_t>::memory_fits(aux_available_memory);
@@ -172,16 +345,416 @@ namespace adiar
       return __count<count_policy, count_priority_queue_t<typename count_policy::queue_t,
                                                           internal_sorter,
                                                           internal_priority_queue>>
-        (dd, varcount, aux_available_memory, max_pq_size);
+        (dd, varcount, arith, aux_available_memory, max_pq_size);
     } else {
+      typedef count_priority_queue_t<typename count_policy::queue_t,
+                                     external_sorter,
+                                     external_priority_queue>
+        external_pq_t;
+
+      // The sorters of the external memory priority queue need memory
+      // proportional to the size of a request. This may be too much, if the
+      // requests carry (very) large numbers.
+      if (aux_available_memory < external_pq_t::memory_minimum()) {
+        throw std::overflow_error("Not enough memory to count with numbers of "
+                                  + std::to_string(sizeof(typename count_policy::value_t))
+                                  + " bytes");
+      }
+
 #ifdef ADIAR_STATS
       stats_count.lpq_external++;
 #endif
-      return __count<count_policy, count_priority_queue_t<typename count_policy::queue_t,
-                                                          external_sorter,
-                                                          external_priority_queue>>
-        (dd, varcount, aux_available_memory, max_pq_size);
+      return __count<count_policy, external_pq_t>
+        (dd, varcount, arith, aux_available_memory, max_pq_size);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Semirings
+  //
+  // Weighted model counting and linear optimisation is the same top-down sweep
+  // as above, but where the values of paths are combined with the 'plus' and
+  // 'times' of a semiring on doubles. The weight w of a variable is turned
+  // into the value 'low(w)' and 'high(w)' of its two arcs, whereas a level that
+  // is skipped by a path contributes with 'plus(low(w), high(w))'. The inverse
+  // of 'times' is 'divide(a,b)'. If 'is_selective' then 'plus' always picks one
+  // of its arguments, i.e. an optimal path exists, and 'better(a,b)' is whether
+  // it picks a over b.
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Sum of the product of the probabilities along each path, where the
+  ///        weight of a variable is the probability of it being true.
+  //////////////////////////////////////////////////////////////////////////////
+  struct sum_product_semiring
+  {
+    static constexpr bool is_selective = false;
+
+    double zero() const { return 0.0; }
+    double one() const { return 1.0; }
+
+    double plus(const double a, const double b) const { return a + b; }
+    double times(const double a, const double b) const { return a * b; }
+    double divide(const double a, const double b) const { return a / b; }
+
+    double low(const double w) const { return 1.0 - w; }
+    double high(const double w) const { return w; }
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Minimum of the sum of costs along each path, where the weight of a
+  ///        variable is the cost of it being true.
+  //////////////////////////////////////////////////////////////////////////////
+  struct min_plus_semiring
+  {
+    static constexpr bool is_selective = true;
+
+    double zero() const { return std::numeric_limits<double>::infinity(); }
+    double one() const { return 0.0; }
+
+    double plus(const double a, const double b) const { return std::min(a, b); }
+    double times(const double a, const double b) const { return a + b; }
+    double divide(const double a, const double b) const { return a - b; }
+
+    double low(const double /* w */) const { return 0.0; }
+    double high(const double w) const { return w; }
+
+    bool better(const double a, const double b) const { return a < b; }
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Maximum of the sum of costs along each path, where the weight of a
+  ///        variable is the cost of it being true.
+  //////////////////////////////////////////////////////////////////////////////
+  struct max_plus_semiring
+  {
+    static constexpr bool is_selective = true;
+
+    double zero() const { return -std::numeric_limits<double>::infinity(); }
+    double one() const { return 0.0; }
+
+    double plus(const double a, const double b) const { return std::max(a, b); }
+    double times(const double a, const double b) const { return a + b; }
+    double divide(const double a, const double b) const { return a - b; }
+
+    double low(const double /* w */) const { return 0.0; }
+    double high(const double w) const { return w; }
+
+    bool better(const double a, const double b) const { return a > b; }
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Stream of the weights in a <tt>weight_file</tt> that also
+  ///        accumulates the value of skipping all prior levels.
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename semiring_t>
+  class weight_stream
+  {
+  public:
+    static constexpr size_t memory_usage()
+    {
+      return file_stream<double>::memory_usage();
+    }
+
+  private:
+    file_stream<double> _stream;
+    const semiring_t &_sr;
+
+    label_t _pulled = 0u;
+    double _weight;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Value of skipping all levels prior to the one of '_weight'.
+    ////////////////////////////////////////////////////////////////////////////
+    double _prefix;
+
+  public:
+    weight_stream(const weight_file &weights, const semiring_t &sr)
+      : _stream(weights), _sr(sr), _prefix(sr.one())
+    { }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Move forward to the weight of the given label.
+    ////////////////////////////////////////////////////////////////////////////
+    void seek(const label_t label)
+    {
+      adiar_debug(_pulled <= label + 1u, "Labels should be given in increasing order");
+      while (_pulled <= label) { pull(); }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The weight of the current label.
+    ////////////////////////////////////////////////////////////////////////////
+    double weight() const
+    { return _weight; }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Value of skipping all levels above the current label.
+    ////////////////////////////////////////////////////////////////////////////
+    double prefix() const
+    { return _prefix; }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Value of skipping all levels above and at the current label.
+    ////////////////////////////////////////////////////////////////////////////
+    double next_prefix() const
+    { return _sr.times(_prefix, _sr.plus(_sr.low(_weight), _sr.high(_weight))); }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Value of skipping all levels (consumes the rest of the stream).
+    ////////////////////////////////////////////////////////////////////////////
+    double total()
+    {
+      while (_stream.can_pull()) { pull(); }
+      return _pulled == 0u ? _sr.one() : next_prefix();
+    }
+
+  private:
+    void pull()
+    {
+      adiar_assert(_stream.can_pull(),
+                   "A weight should be given for every variable in the decision diagram");
+
+      if (0u < _pulled) { _prefix = next_prefix(); }
+      _weight = _stream.pull();
+      _pulled++;
+    }
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Data structures
+  struct semiring_request
+  {
+    uid_t uid;
+    double value;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Source of the arc, flagged if it is a high arc, such that the optimal
+    /// path can be traced back.
+    ////////////////////////////////////////////////////////////////////////////
+    ptr_t source;
+  };
+
+  template<>
+  struct count_queue_lt<semiring_request>
+  {
+    bool operator()(const semiring_request &a, const semiring_request &b)
+    {
+      return a.uid < b.uid;
+    }
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename semiring_t, typename semiring_pq_t>
+  double __semiring_sweep(const decision_diagram &dd,
+                          const weight_file &weights,
+                          const semiring_t &sr,
+                          simple_file_writer<arc_t> &arcs,
+                          arc_t &best_arc,
+                          const size_t pq_max_memory,
+                          const size_t pq_max_size)
+  {
+    node_stream<> ns(dd);
+    weight_stream<semiring_t> ws(weights, sr);
+
+    semiring_pq_t semiring_pq({dd}, pq_max_memory, pq_max_size, &stats_count);
+
+    // The value of a request (and of the result) is divided by the value of
+    // skipping all levels down to and including the one of its source. Hence,
+    // the levels skipped by an arc are accounted for by multiplying with the
+    // prefix of the level where it ends.
+    double result = sr.zero();
+
+    const auto forward_request = [&](const node_t &n, const double value, const bool high) {
+      const ptr_t child = high ? n.high : n.low;
+      const ptr_t source = high ? flag(n.uid) : n.uid;
+
+      const double w = ws.weight();
+      const double v = sr.divide(sr.times(value, high ? sr.high(w) : sr.low(w)),
+                                 ws.next_prefix());
+
+      if (!is_sink(child)) {
+        semiring_pq.push({ child, v, source });
+      } else if (value_of(child)) {
+        if constexpr (semiring_t::is_selective) {
+          if (is_nil(best_arc.target) || sr.better(v, result)) {
+            result = v;
+            best_arc = { source, child };
+          }
+        } else {
+          result = sr.plus(result, v);
+        }
+      }
+    };
+
+    {
+      node_t root = ns.pull();
+      ws.seek(label_of(root));
+
+      if (arcs.attached()) { arcs.unsafe_push({ NIL, root.uid }); }
+
+      forward_request(root, ws.prefix(), false);
+      forward_request(root, ws.prefix(), true);
     }
+
+    // Take out the rest of the nodes and process them one by one
+    while (ns.can_pull()) {
+      node_t n = ns.pull();
+
+      if (!semiring_pq.has_current_level() || semiring_pq.current_level() != label_of(n)) {
+        semiring_pq.setup_next_level();
+      }
+      adiar_debug(semiring_pq.current_level() == label_of(n),
+                  "Priority queue is out-of-sync with node stream");
+      adiar_debug(semiring_pq.can_pull() && semiring_pq.top().uid == n.uid,
+                  "Priority queue is out-of-sync with node stream");
+
+      ws.seek(label_of(n));
+
+      // Resolve requests
+      semiring_request request = semiring_pq.pull();
+
+      while (semiring_pq.can_pull() && semiring_pq.top().uid == n.uid) {
+        const semiring_request next = semiring_pq.pull();
+
+        if constexpr (semiring_t::is_selective) {
+          if (sr.better(next.value, request.value)) { request = next; }
+        } else {
+          request.value = sr.plus(request.value, next.value);
+        }
+      }
+
+      if (arcs.attached()) { arcs.unsafe_push({ request.source, n.uid }); }
+
+      const double value = sr.times(request.value, ws.prefix());
+
+      forward_request(n, value, false);
+      forward_request(n, value, true);
+    }
+
+    return sr.times(result, ws.total());
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Accumulate the value of all paths to the true sink in the given
+  ///          semiring with the weights of the variables.
+  ///
+  /// \details If the semiring is selective and <tt>arcs</tt> is attached, then
+  ///          the best incoming arc of each node is written to it (in the order
+  ///          of the sweep) and <tt>best_arc</tt> is the best arc to the true
+  ///          sink (its target is NIL if there is none). Together, these
+  ///          describe the optimal path in O(N) space.
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename semiring_t>
+  double semiring_sweep(const decision_diagram &dd,
+                        const weight_file &weights,
+                        const semiring_t &sr,
+                        simple_file_writer<arc_t> &arcs,
+                        arc_t &best_arc)
+  {
+    best_arc = { NIL, NIL };
+
+    if (is_sink(dd)) {
+      if (!value_of(dd)) { return sr.zero(); }
+
+      best_arc = { NIL, create_sink_ptr(true) };
+      return weight_stream<semiring_t>(weights, sr).total();
+    }
+
+    const size_t max_pq_size = __count_max_cut_upper_bound(dd);
+
+    const size_t aux_available_memory = memory::available()
+      - node_stream<>::memory_usage()
+      - weight_stream<semiring_t>::memory_usage()
+      - (arcs.attached() ? simple_file_writer<arc_t>::memory_usage() : 0u);
+
+    const size_t pq_memory_fits =
+      count_priority_queue_t<semiring_request>::memory_fits(aux_available_memory);
+
+    if (max_pq_size <= pq_memory_fits) {
+#ifdef ADIAR_STATS
+      stats_count.lpq_internal++;
+#endif
+      return __semiring_sweep<semiring_t, count_priority_queue_t<semiring_request,
+                                                                 internal_sorter,
+                                                                 internal_priority_queue>>
+        (dd, weights, sr, arcs, best_arc, aux_available_memory, max_pq_size);
+    } else {
+#ifdef ADIAR_STATS
+      stats_count.lpq_external++;
+#endif
+      return __semiring_sweep<semiring_t, count_priority_queue_t<semiring_request,
+                                                                 external_sorter,
+                                                                 external_priority_queue>>
+        (dd, weights, sr, arcs, best_arc, aux_available_memory, max_pq_size);
+    }
+  }
+
+  template<typename semiring_t>
+  double semiring_sweep(const decision_diagram &dd,
+                        const weight_file &weights,
+                        const semiring_t &sr = {})
+  {
+    simple_file_writer<arc_t> arcs;
+    arc_t best_arc;
+    return semiring_sweep(dd, weights, sr, arcs, best_arc);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Reconstruct the optimal assignment from the output of a selective
+  ///          <tt>semiring_sweep</tt>.
+  ///
+  /// \details The arcs are read once backwards to trace the optimal path from
+  ///          the true sink up to the root. Every variable not on that path is
+  ///          set to its best value on its own.
+  ///
+  /// \returns An <tt>assignment_file</tt> with an assignment to every variable
+  ///          with a weight or an empty file if there is no path to true.
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename semiring_t>
+  assignment_file semiring_reconstruct(const simple_file<arc_t> &arcs,
+                                       arc_t best_arc,
+                                       const weight_file &weights,
+                                       const semiring_t &sr = {})
+  {
+    static_assert(semiring_t::is_selective, "Only selective semirings have an optimal path");
+
+    assignment_file out;
+    if (is_nil(best_arc.target)) { return out; }
+
+    // Trace the path backwards, i.e. its labels are in decreasing order
+    assignment_file path;
+    {
+      assignment_writer pw(path);
+      file_stream<arc_t, true> as(arcs);
+
+      while (!is_nil(best_arc.source)) {
+        const uid_t source = unflag(best_arc.source);
+        pw.unsafe_push(create_assignment(label_of(source), is_high(best_arc)));
+
+        do {
+          adiar_debug(as.can_pull(), "The best incoming arc of every node should be given");
+          best_arc = as.pull();
+        } while (best_arc.target != source);
+      }
+    }
+
+    // Merge with the best choice for every variable not on the path
+    assignment_writer ow(out);
+    assignment_stream<true> ps(path);
+    file_stream<double> ws(weights);
+
+    for (label_t label = 0u; ws.can_pull(); label++) {
+      const double w = ws.pull();
+
+      if (ps.can_pull() && ps.peek().label == label) {
+        ow << ps.pull();
+      } else {
+        ow << create_assignment(label, sr.better(sr.high(w), sr.low(w)));
+      }
+    }
+    adiar_debug(!ps.can_pull(), "A weight should be given for every variable on the path");
+
+    return out;
   }
 }
 
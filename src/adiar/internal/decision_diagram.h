@@ -101,6 +101,7 @@ namespace adiar
     template<typename comp_policy>
     friend bool comparison_check(const decision_diagram &in_1, const decision_diagram &in_2);
 
+    friend uint64_t hash_of(const decision_diagram &dd);
     friend bool is_sink(const decision_diagram &dd);
     friend bool value_of(const decision_diagram &dd);
     friend label_t min_label(const decision_diagram &dd);
@@ -171,6 +172,20 @@ namespace adiar
     return dd.file_ptr() -> canonical;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Structural hash of a decision diagram, taking its negation flag
+  /// into account.
+  ///
+  /// Two reduced decision diagrams that represent the same function have the
+  /// same hash, regardless of the identifiers of their nodes. The hash is
+  /// derived bottom-up while writing its nodes, so this is an O(1) lookup in
+  /// its meta information.
+  //////////////////////////////////////////////////////////////////////////////
+  inline uint64_t hash_of(const decision_diagram &dd)
+  {
+    return dd.file._file_ptr -> hash[dd.negate];
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief Whether a given decision diagram represents a sink.
   //////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,257 @@
+#ifndef ADIAR_INTERNAL_ENUMERATE_H
+#define ADIAR_INTERNAL_ENUMERATE_H
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include <adiar/data.h>
+#include <adiar/file.h>
+#include <adiar/file_stream.h>
+
+#include <adiar/internal/assert.h>
+#include <adiar/internal/decision_diagram.h>
+
+namespace adiar
+{
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Random access to the nodes of a decision diagram by their uid.
+  ///
+  /// \details The level information is kept in internal memory as an index of
+  ///          where each level begins in the node file. Within a level, the
+  ///          nodes are sorted by decreasing id, which (if reduced) are the
+  ///          consecutive ids from MAX_ID and downwards. Hence, a node usually
+  ///          is found with a single seek and otherwise with a binary search.
+  //////////////////////////////////////////////////////////////////////////////
+  class node_random_access
+  {
+  public:
+    static constexpr size_t memory_usage()
+    {
+      return node_stream<>::memory_usage() + level_info_stream<node_t>::memory_usage();
+    }
+
+  private:
+    struct level_index
+    {
+      label_t label;
+      size_t offset;
+      size_t width;
+    };
+
+    node_stream<true> _nodes;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Levels in increasing order of their label.
+    ////////////////////////////////////////////////////////////////////////////
+    std::vector<level_index> _levels;
+
+  public:
+    node_random_access(const decision_diagram &dd) : _nodes(dd)
+    {
+      adiar_debug(!is_sink(dd), "Random access is not needed for a sink");
+
+      level_info_stream<node_t, true> in_meta(dd);
+
+      size_t offset = 0u;
+      while (in_meta.can_pull()) {
+        const level_info_t li = in_meta.pull();
+        _levels.push_back({ label_of(li), offset, width_of(li) });
+        offset += width_of(li);
+      }
+
+      // The node file starts with the deepest level
+      std::reverse(_levels.begin(), _levels.end());
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Number of levels.
+    ////////////////////////////////////////////////////////////////////////////
+    size_t levels() const
+    { return _levels.size(); }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Label of the k'th level (from the top).
+    ////////////////////////////////////////////////////////////////////////////
+    label_t label(const size_t k) const
+    { return _levels[k].label; }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The root of the decision diagram.
+    ////////////////////////////////////////////////////////////////////////////
+    node_t root()
+    {
+      const level_index &l = _levels.front();
+      return read(l.offset + l.width - 1u);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The node with the given uid on the k'th level.
+    ////////////////////////////////////////////////////////////////////////////
+    node_t at(const uid_t u, const size_t k)
+    {
+      adiar_debug(k < levels() && label(k) == label_of(u),
+                  "The node should be on the given level");
+
+      const level_index &l = _levels[k];
+
+      const size_t guess = MAX_ID - id_of(u);
+      if (guess < l.width) {
+        const node_t n = read(l.offset + guess);
+        if (n.uid == u) { return n; }
+      }
+
+      size_t begin = 0u;
+      size_t end = l.width;
+      while (begin < end) {
+        const size_t mid = begin + (end - begin) / 2u;
+        const node_t n = read(l.offset + mid);
+
+        if (n.uid == u) { return n; }
+        if (u < n.uid) { begin = mid + 1u; } else { end = mid; }
+      }
+      adiar_unreachable(); // LCOV_EXCL_LINE
+    }
+
+  private:
+    node_t read(const size_t idx)
+    {
+      _nodes.seek(idx);
+      return _nodes.pull();
+    }
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Call <tt>callback</tt> with the trace of every path to the true
+  ///          sink.
+  ///
+  /// \details The paths are visited depth-first with an explicit stack of at
+  ///          most one entry per level, such that only O(L) internal memory is
+  ///          used. The trace of a path is given as the (label, value) of every
+  ///          arc taken in increasing order of the labels.
+  ///
+  /// \param expand_skipped Whether to also enumerate both values for every
+  ///                       level skipped by a path, i.e. to enumerate all
+  ///                       assignments to the levels of the diagram rather than
+  ///                       all cubes.
+  //////////////////////////////////////////////////////////////////////////////
+  template<bool expand_skipped, typename callback_t>
+  void enumerate_paths(const decision_diagram &dd, callback_t &&callback)
+  {
+    std::vector<assignment_t> path;
+
+    if (is_sink(dd)) {
+      if (value_of(dd)) { callback(path); }
+      return;
+    }
+
+    node_random_access nodes(dd);
+
+    // For each entry on the path, the arc to follow when it is set to true and
+    // the index of its level.
+    struct stack_entry
+    {
+      ptr_t high;
+      size_t level;
+    };
+
+    std::vector<stack_entry> stack;
+    stack.reserve(nodes.levels());
+    path.reserve(nodes.levels());
+
+    ptr_t next = nodes.root().uid;
+    size_t level = 0u;
+
+    while (true) {
+      // Follow the low arcs down to a sink
+      while (!is_false(next)) {
+        if constexpr (expand_skipped) {
+          while (level < nodes.levels() && (is_sink(next) || nodes.label(level) < label_of(next))) {
+            stack.push_back({ next, level });
+            path.push_back(create_assignment(nodes.label(level), false));
+            level++;
+          }
+        } else if (is_node(next)) {
+          while (nodes.label(level) < label_of(next)) { level++; }
+        }
+
+        if (is_sink(next)) {
+          callback(path);
+          break;
+        }
+
+        const node_t n = nodes.at(next, level);
+        stack.push_back({ n.high, level });
+        path.push_back(create_assignment(label_of(n), false));
+
+        next = n.low;
+        level++;
+      }
+
+      // Backtrack to the deepest entry that has not yet been set to true
+      while (!path.empty() && path.back().value) {
+        stack.pop_back();
+        path.pop_back();
+      }
+      if (path.empty()) { return; }
+
+      path.back().value = true;
+      next = stack.back().high;
+      level = stack.back().level + 1u;
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Collects the results of an enumeration into batches of a bounded
+  ///        size, which are passed on to the callback when full.
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename elem_t>
+  class enumerate_batch
+  {
+  public:
+    typedef std::vector<std::vector<elem_t>> batch_t;
+
+  private:
+    const std::function<void(const batch_t&)> &_callback;
+
+    batch_t _batch;
+    size_t _size = 0u;
+
+  public:
+    enumerate_batch(const std::function<void(const batch_t&)> &callback,
+                    const size_t batch_size)
+      : _callback(callback), _batch(batch_size)
+    {
+      adiar_assert(0u < batch_size, "A batch should have room for at least one element");
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The (cleared) entry for the next result.
+    ////////////////////////////////////////////////////////////////////////////
+    std::vector<elem_t>& next()
+    {
+      if (_size == _batch.size()) {
+        _callback(_batch);
+        _size = 0u;
+      }
+
+      std::vector<elem_t> &res = _batch[_size++];
+      res.clear();
+      return res;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Pass on the remaining results (if any).
+    ////////////////////////////////////////////////////////////////////////////
+    void flush()
+    {
+      if (_size == 0u) { return; }
+
+      _batch.resize(_size);
+      _callback(_batch);
+      _size = 0u;
+    }
+  };
+}
+
+#endif // ADIAR_INTERNAL_ENUMERATE_H
@@ -1,5 +1,5 @@
 #include "intercut.h"
 
 namespace adiar {
-  stats_t::intercut_t stats_intercut;
+  thread_local stats_t::intercut_t stats_intercut;
 }
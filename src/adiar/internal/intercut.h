@@ -15,7 +15,7 @@ namespace adiar
 {
   //////////////////////////////////////////////////////////////////////////////
   /// Struct to hold statistics
-  extern stats_t::intercut_t stats_intercut;
+  extern thread_local stats_t::intercut_t stats_intercut;
 
   //////////////////////////////////////////////////////////////////////////////
   // Priority queues
@@ -196,8 +196,8 @@ namespace adiar
     arc_file out_arcs;
     arc_writer aw(out_arcs);
 
-    pq_1_t intercut_pq_1({dd}, pq_1_memory, max_pq_size);
-    pq_2_t intercut_pq_2({labels}, pq_2_memory, max_pq_size);
+    pq_1_t intercut_pq_1({dd}, pq_1_memory, max_pq_size, &stats_intercut);
+    pq_2_t intercut_pq_2({labels}, pq_2_memory, max_pq_size, &stats_intercut);
 
     // Add request for root in the relevant queue
     label_t out_label = std::min(l, label_of(n));
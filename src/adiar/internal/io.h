@@ -0,0 +1,68 @@
+#ifndef ADIAR_INTERNAL_IO_H
+#define ADIAR_INTERNAL_IO_H
+
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+#include <adiar/data.h>
+
+#include <adiar/file.h>
+#include <adiar/file_stream.h>
+#include <adiar/file_writer.h>
+
+#include <adiar/internal/decision_diagram.h>
+
+namespace adiar
+{
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Store a copy of a decision diagram in a persistent node_file.
+  ///
+  /// \details The negation flag of the decision diagram is applied to the
+  ///          copied nodes, such that the stored file describes the decision
+  ///          diagram on its own. The meta information is derived anew by the
+  ///          node_writer and is stored in the file's header.
+  ///
+  /// \throws std::invalid_argument If <tt>filename</tt> already exists.
+  //////////////////////////////////////////////////////////////////////////////
+  inline void save(const decision_diagram &dd, const std::string &filename)
+  {
+    if (std::filesystem::exists(filename)) {
+      throw std::invalid_argument("Cannot overwrite already existing file '" + filename + "'");
+    }
+
+    node_file out_nodes(filename);
+
+    { // Garbage collect the writer to detach it before making it read-only
+      node_writer out_writer(out_nodes);
+      node_stream<true> in_nodes(dd);
+
+      while (in_nodes.can_pull()) {
+        out_writer.push(in_nodes.pull());
+      }
+    }
+
+    out_nodes._file_ptr -> max_1level_cut = dd.file_ptr() -> max_1level_cut;
+    out_nodes.make_read_only();
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Reopen a node_file previously stored with <tt>save</tt>. The
+  ///        content is not copied but read directly from the given path.
+  ///
+  /// \throws std::invalid_argument If <tt>filename</tt> does not exist.
+  ///
+  /// \throws std::runtime_error    If <tt>filename</tt> is not a valid file
+  ///                               stored with <tt>save</tt>.
+  //////////////////////////////////////////////////////////////////////////////
+  inline node_file load(const std::string &filename)
+  {
+    if (!std::filesystem::exists(filename)) {
+      throw std::invalid_argument("Cannot load non-existing file '" + filename + "'");
+    }
+
+    return node_file(filename);
+  }
+}
+
+#endif // ADIAR_INTERNAL_IO_H
@@ -1,5 +1,42 @@
 #include "levelized_priority_queue.h"
 
+#include <algorithm>
+#include <atomic>
+
 namespace adiar {
-  stats_t::priority_queue_t stats_priority_queue;
+  thread_local stats_t::priority_queue_t stats_priority_queue;
+
+  namespace lpq
+  {
+    // Set by 'adiar_set_lpq_lookahead' while operations on other threads may
+    // read it.
+    std::atomic<size_t> _lookahead { 0u };
+
+    void set_lookahead(size_t lookahead)
+    {
+      _lookahead = lookahead;
+    }
+
+    size_t get_lookahead()
+    {
+      return _lookahead;
+    }
+
+    void record(const stats_t::priority_queue_t::queue_t &q, memory_t *algorithm_stats)
+    {
+      const size_t idx = std::min(q.lookahead, stats_t::priority_queue_t::MAX_LOOKAHEAD);
+      stats_t::priority_queue_t::lookahead_t &l = stats_priority_queue.lookahead[idx];
+
+      l.queues++;
+      l.push_bucket += q.push_bucket;
+      l.push_overflow += q.push_overflow;
+
+      if (algorithm_stats) {
+        algorithm_stats -> lpq_queues++;
+        algorithm_stats -> lpq_lookahead += q.lookahead;
+        algorithm_stats -> lpq_push_bucket += q.push_bucket;
+        algorithm_stats -> lpq_push_overflow += q.push_overflow;
+      }
+    }
+  }
 }
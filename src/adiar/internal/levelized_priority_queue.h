@@ -1,6 +1,7 @@
 #ifndef ADIAR_INTERNAL_LEVELIZED_PRIORITY_QUEUE_H
 #define ADIAR_INTERNAL_LEVELIZED_PRIORITY_QUEUE_H
 
+#include <algorithm>
 #include <limits>
 
 #include <tpie/tpie.h>
@@ -127,17 +128,118 @@ namespace adiar {
   };
 
   //////////////////////////////////////////////////////////////////////////////
-  /// The preprocessor variable ADIAR_PQ_LOOKAHEAD can be used to change the
-  /// number of buckets used by the levelized priority queue.
+  /// The preprocessor variable ADIAR_LPQ_LOOKAHEAD can be used to change the
+  /// maximum number of levels ahead of the current one that the levelized
+  /// priority queue may have buckets for. The actual look-ahead is chosen for
+  /// each priority queue at runtime, see <tt>lpq::set_lookahead</tt>.
   //////////////////////////////////////////////////////////////////////////////
 #ifndef ADIAR_LPQ_LOOKAHEAD
-#define ADIAR_LPQ_LOOKAHEAD 1u
+#define ADIAR_LPQ_LOOKAHEAD 8u
 #endif
 
+  namespace lpq
+  {
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Fixes the look-ahead of all levelized priority queues (up to
+    ///        their maximum and what fits into their memory). The default of 0
+    ///        instead lets each queue choose its look-ahead based on its input
+    ///        and the memory it is given.
+    ////////////////////////////////////////////////////////////////////////////
+    void set_lookahead(size_t lookahead = 0u);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The fixed look-ahead (or 0 if it is chosen adaptively).
+    ////////////////////////////////////////////////////////////////////////////
+    size_t get_lookahead();
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Add the statistics of a single levelized priority queue to the
+    ///        aggregate histogram and to the statistics of the algorithm that
+    ///        used it (if any).
+    ////////////////////////////////////////////////////////////////////////////
+    void record(const stats_t::priority_queue_t::queue_t &q, memory_t *algorithm_stats);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   The shape of the input of a levelized priority queue: its number
+  ///          of levels, the sum of its level widths, and an upper bound on its
+  ///          maximum 1-level cut (<tt>size_t</tt>'s maximum if unknown).
+  //////////////////////////////////////////////////////////////////////////////
+  struct lpq_shape
+  {
+    size_t levels;
+    size_t elements;
+    size_t max_1level_cut;
+  };
+
+  template <typename T>
+  inline lpq_shape lpq_shape_of(const __meta_file<T> &f)
+  {
+    return { f.meta_size(), f.size(), f.max_1level_cut };
+  }
+
+  template <typename T>
+  inline lpq_shape lpq_shape_of(const meta_file<T> &f)
+  {
+    return lpq_shape_of(*f._file_ptr);
+  }
+
+  inline lpq_shape lpq_shape_of(const label_file &f)
+  {
+    // The width of each level is unknown.
+    return { f.size(), 0u, std::numeric_limits<size_t>::max() };
+  }
+
+  inline lpq_shape lpq_shape_of(const decision_diagram &dd)
+  {
+    return lpq_shape_of(*dd.file_ptr());
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Choose the look-ahead for a levelized priority queue.
+  ///
+  /// \details A shallow and wide input, i.e. one where the width of its levels
+  ///          is at least the number of levels, has many elements pushed across
+  ///          each level. Buckets for later levels then mostly take memory away
+  ///          from the overflow priority queue, so only a single level is
+  ///          looked ahead. Otherwise, the look-ahead is as many buckets as the
+  ///          memory allows for.
+  ///
+  ///          The width is the maximum 1-level cut (if known) and otherwise the
+  ///          average width of the levels.
+  ///
+  /// \param shape         The shape of the input(s)
+  ///
+  /// \param max_buckets   The number of buckets that fit into memory
+  ///
+  /// \param max_lookahead The compile-time limit on the look-ahead
+  //////////////////////////////////////////////////////////////////////////////
+  inline label_t lpq_choose_lookahead(const lpq_shape &shape,
+                                      const size_t max_buckets,
+                                      const label_t max_lookahead)
+  {
+    const size_t memory_lookahead = max_buckets < 2u ? 1u : max_buckets - 1u;
+
+    const size_t fixed = lpq::get_lookahead();
+    if (fixed != 0u) {
+      return std::min<size_t>({ fixed, memory_lookahead, max_lookahead });
+    }
+
+    const size_t width = shape.max_1level_cut != std::numeric_limits<size_t>::max()
+      ? shape.max_1level_cut
+      : shape.elements / std::max<size_t>(shape.levels, 1u);
+
+    if (shape.levels <= width) {
+      return 1u;
+    }
+
+    return std::min<size_t>(memory_lookahead, max_lookahead);
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief Struct holding statistics on the levelized priority queue
   //////////////////////////////////////////////////////////////////////////////
-  extern stats_t::priority_queue_t stats_priority_queue;
+  extern thread_local stats_t::priority_queue_t stats_priority_queue;
 
   //////////////////////////////////////////////////////////////////////////////
   /// \brief   Levelized Priority Queue with a finite circular array of sorters
@@ -174,8 +276,10 @@ namespace adiar {
   /// \param INIT_LEVEL   The index for the first level one can push to. In other
   ///                     words, the number of levels to 'skip'.
   ///
-  /// \param LOOK_AHEAD   The number of levels (ahead of the current)
-  ///                     explicitly handle with a sorting algorithm
+  /// \param LOOK_AHEAD   The maximum number of levels (ahead of the current)
+  ///                     explicitly handle with a sorting algorithm. The
+  ///                     number used is chosen at runtime, see
+  ///                     <tt>lpq_choose_lookahead</tt>.
   //////////////////////////////////////////////////////////////////////////////
   template <typename elem_t,
             typename elem_level_t,
@@ -219,21 +323,38 @@ namespace adiar {
     typedef priority_queue_template<elem_t, elem_comp_t> priority_queue_t;
 
     ////////////////////////////////////////////////////////////////////////////
-    /// \brief Number of buckets.
+    /// \brief Maximum number of buckets.
+    ////////////////////////////////////////////////////////////////////////////
+    static constexpr size_t MAX_BUCKETS = LOOK_AHEAD + 1;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Minimum number of buckets, i.e. with a look-ahead of one level.
+    ///        Any more are only used if they fit within the given memory.
     ////////////////////////////////////////////////////////////////////////////
-    static constexpr size_t BUCKETS = LOOK_AHEAD + 1;
+    static constexpr size_t MIN_BUCKETS = 2u;
 
     ////////////////////////////////////////////////////////////////////////////
-    /// \brief Total number of data structures in Levelized Priority Queue.
+    /// \brief Total number of data structures in Levelized Priority Queue (with
+    ///        the minimum number of buckets).
     ////////////////////////////////////////////////////////////////////////////
     static constexpr size_t DATA_STRUCTURES =
-      BUCKETS * sorter_t::DATA_STRUCTURES + priority_queue_t::DATA_STRUCTURES;
+      MIN_BUCKETS * sorter_t::DATA_STRUCTURES + priority_queue_t::DATA_STRUCTURES;
 
   public:
     static constexpr tpie::memory_size_type memory_usage(tpie::memory_size_type no_elements)
     {
       return internal_priority_queue<elem_t, elem_comp_t>::memory_usage(no_elements)
-        + BUCKETS * internal_sorter<elem_t, elem_comp_t>::memory_usage(no_elements)
+        + MIN_BUCKETS * internal_sorter<elem_t, elem_comp_t>::memory_usage(no_elements)
+        + label_merger<file_t, level_comp_t, FILES>::memory_usage();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Minimum amount of memory needed (with the minimum number of
+    ///        buckets).
+    ////////////////////////////////////////////////////////////////////////////
+    static constexpr tpie::memory_size_type memory_minimum()
+    {
+      return MIN_BUCKETS * sorter_t::memory_minimum()
         + label_merger<file_t, level_comp_t, FILES>::memory_usage();
     }
 
@@ -319,12 +440,17 @@ namespace adiar {
     ////////////////////////////////////////////////////////////////////////////
     /// \brief Level of each bucket.
     ////////////////////////////////////////////////////////////////////////////
-    label_t _buckets_level [BUCKETS];
+    label_t _buckets_level [MAX_BUCKETS];
 
     ////////////////////////////////////////////////////////////////////////////
     /// \brief Sorter for each bucket.
     ////////////////////////////////////////////////////////////////////////////
-    std::unique_ptr<sorter_t> _buckets_sorter [BUCKETS];
+    std::unique_ptr<sorter_t> _buckets_sorter [MAX_BUCKETS];
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Number of buckets in use, i.e. the look-ahead plus one.
+    ////////////////////////////////////////////////////////////////////////////
+    label_t _buckets = MIN_BUCKETS;
 
     ////////////////////////////////////////////////////////////////////////////
     /// \brief Index of the currently read-from bucket (if any).
@@ -354,21 +480,37 @@ namespace adiar {
     ////////////////////////////////////////////////////////////////////////////
     priority_queue_t _overflow_queue;
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Statistics of this very priority queue, which are recorded when
+    ///        it is destructed (if compiled with ADIAR_STATS_EXTRA).
+    ////////////////////////////////////////////////////////////////////////////
+    stats_t::priority_queue_t::queue_t _stats;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Statistics of the algorithm using this priority queue (if any),
+    ///        to which <tt>_stats</tt> also is added.
+    ////////////////////////////////////////////////////////////////////////////
+    memory_t *_algorithm_stats;
+
   private:
     static tpie::memory_size_type m_overflow_queue(tpie::memory_size_type memory_given)
     {
+      // The share of the overflow queue is independent of the look-ahead, such
+      // that additional buckets only use what is left over.
       const tpie::memory_size_type eight_MiB = 8 * 1024;
-      const tpie::memory_size_type weighted_share = memory_given / (4 * BUCKETS + 1);
+      const tpie::memory_size_type weighted_share = memory_given / (4 * MIN_BUCKETS + 1);
 
       return std::max(eight_MiB, weighted_share);
     }
 
-    levelized_priority_queue(tpie::memory_size_type memory_given, size_t max_size)
+    levelized_priority_queue(tpie::memory_size_type memory_given, size_t max_size,
+                             memory_t *algorithm_stats)
       : _max_size(max_size),
         _memory_given(memory_given),
         _memory_occupied_by_merger(memory::available()),
         _memory_occupied_by_overflow(m_overflow_queue(memory_given)),
-        _overflow_queue(m_overflow_queue(memory_given), max_size)
+        _overflow_queue(m_overflow_queue(memory_given), max_size),
+        _algorithm_stats(algorithm_stats)
     { }
 
 
@@ -379,14 +521,23 @@ namespace adiar {
     /// \param files        Files to follow the levels of
     ///
     /// \param memory_given Total amount of memory to use
+    ///
+    /// \param algorithm_stats Statistics of the algorithm using it, to which its
+    ///                        look-ahead and pushes are added.
     ////////////////////////////////////////////////////////////////////////////
     levelized_priority_queue(const file_t (& files) [FILES],
                              tpie::memory_size_type memory_given,
-                             size_t max_size)
-      : levelized_priority_queue(memory_given, max_size)
+                             size_t max_size,
+                             memory_t *algorithm_stats = nullptr)
+      : levelized_priority_queue(memory_given, max_size, algorithm_stats)
     {
+      lpq_shape shape = { 0u, 0u, 0u };
+      for (size_t idx = 0u; idx < FILES; idx++) {
+        add_shape(shape, lpq_shape_of(files[idx]));
+      }
+
       _level_merger.hook(files);
-      init_buckets();
+      init_buckets(shape);
     }
 
     ////////////////////////////////////////////////////////////////////////////
@@ -395,17 +546,49 @@ namespace adiar {
     /// \param dds          Decision Diagrams to follow the levels of
     ///
     /// \param memory_given Total amount of memory to use
+    ///
+    /// \param algorithm_stats Statistics of the algorithm using it, to which its
+    ///                        look-ahead and pushes are added.
     ////////////////////////////////////////////////////////////////////////////
     levelized_priority_queue(const decision_diagram (& dds) [FILES],
                              tpie::memory_size_type memory_given,
-                             size_t max_size)
-      : levelized_priority_queue(memory_given, max_size)
+                             size_t max_size,
+                             memory_t *algorithm_stats = nullptr)
+      : levelized_priority_queue(memory_given, max_size, algorithm_stats)
     {
+      lpq_shape shape = { 0u, 0u, 0u };
+      for (size_t idx = 0u; idx < FILES; idx++) {
+        add_shape(shape, lpq_shape_of(dds[idx]));
+      }
+
       _level_merger.hook(dds);
-      init_buckets();
+      init_buckets(shape);
+    }
+
+    ~levelized_priority_queue()
+    {
+#ifdef ADIAR_STATS_EXTRA
+      lpq::record(_stats, _algorithm_stats);
+#endif
     }
 
   private:
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Combine the shape of multiple inputs. The levels of a product of
+    ///        inputs is (at most) their sum, as is the sum of all level widths
+    ///        and (as an estimate) the 1-level cut.
+    ////////////////////////////////////////////////////////////////////////////
+    static void add_shape(lpq_shape &shape, const lpq_shape &s)
+    {
+      constexpr size_t max_value = std::numeric_limits<size_t>::max();
+
+      shape.levels += s.levels;
+      shape.elements += s.elements;
+      shape.max_1level_cut = max_value - shape.max_1level_cut < s.max_1level_cut
+        ? max_value
+        : shape.max_1level_cut + s.max_1level_cut;
+    }
+
     ////////////////////////////////////////////////////////////////////////////
     /// \brief  Computes final memory usage of internal data structures to then
     ///         distribute the remaining memory when initialising the buckets.
@@ -413,7 +596,7 @@ namespace adiar {
     /// \remark Call this function at the end of the constructor after the
     ///         level_merger has hooked into the input.
     ////////////////////////////////////////////////////////////////////////////
-    void init_buckets()
+    void init_buckets(const lpq_shape &shape)
     {
       // This was set in the private constructor above to be the total amount of
       // memory. This was done before the _level_merger had created all of its
@@ -425,6 +608,14 @@ namespace adiar {
       adiar_debug(_memory_occupied_by_merger + _memory_occupied_by_overflow <= _memory_given,
                   "the amount of memory used should be within the given bounds");
 
+      // Choose the look-ahead based on the input and how many buckets fit into
+      // the remaining memory.
+      const size_t max_buckets = sorter_t::max_sorters(_memory_for_buckets, _max_size);
+
+      _buckets = lpq_choose_lookahead(shape, max_buckets, LOOK_AHEAD) + 1u;
+
+      _stats.lookahead = _buckets - 1u;
+
       // Initially skip the number of levels
       for (label_t idx = 0; _level_merger.can_pull() && idx < INIT_LEVEL; idx++) {
         _level_merger.pull();
@@ -432,7 +623,7 @@ namespace adiar {
 
       // Set up buckets until no levels are left or all buckets have been
       // instantiated. Notice, that _back_bucket_idx was initialised to -1.
-      while (_back_bucket_idx + 1 < BUCKETS && _level_merger.can_pull()) {
+      while (_back_bucket_idx + 1 < _buckets && _level_merger.can_pull()) {
         const label_t level = _level_merger.pull();
 
         adiar_invariant(_front_bucket_idx == OUT_OF_BUCKETS_IDX,
@@ -441,7 +632,7 @@ namespace adiar {
         _back_bucket_idx++;
 
         _buckets_level[_back_bucket_idx] = level;
-        _buckets_sorter[_back_bucket_idx] = sorter_t::make_unique(_memory_for_buckets, _max_size, BUCKETS);
+        _buckets_sorter[_back_bucket_idx] = sorter_t::make_unique(_memory_for_buckets, _max_size, _buckets);
       }
     }
 
@@ -512,12 +703,13 @@ namespace adiar {
 
       label_t bucket_offset = 1u;
       do {
-        const label_t bucket_idx = (_front_bucket_idx + bucket_offset++) % BUCKETS;
+        const label_t bucket_idx = (_front_bucket_idx + bucket_offset++) % _buckets;
 
         if (_buckets_level[bucket_idx] == level) {
           _buckets_sorter[bucket_idx] -> push(e);
 #ifdef ADIAR_STATS_EXTRA
           stats_priority_queue.push_bucket++;
+          _stats.push_bucket++;
 #endif
           return;
         }
@@ -525,6 +717,7 @@ namespace adiar {
 
 #ifdef ADIAR_STATS_EXTRA
       stats_priority_queue.push_overflow++;
+      _stats.push_overflow++;
 #endif
       _overflow_queue.push(e);
     }
@@ -743,7 +936,7 @@ namespace adiar {
 
       return _front_bucket_idx <= _back_bucket_idx
         ? (_back_bucket_idx - _front_bucket_idx) + 1
-        : (BUCKETS - _front_bucket_idx) + _back_bucket_idx + 1;
+        : (_buckets - _front_bucket_idx) + _back_bucket_idx + 1;
     }
 
     ////////////////////////////////////////////////////////////////////////////
@@ -762,7 +955,7 @@ namespace adiar {
       adiar_debug(has_next_bucket(),
                   "Cannot obtain level of non-existing next bucket");
 
-      const label_t next_idx   = (_front_bucket_idx + 1) % BUCKETS;
+      const label_t next_idx   = (_front_bucket_idx + 1) % _buckets;
       const label_t next_level = _buckets_level[next_idx];
       return next_level;
     }
@@ -825,11 +1018,11 @@ namespace adiar {
 
           _buckets_level[_front_bucket_idx] = next_level;
           sorter_t::reset_unique(_buckets_sorter[_front_bucket_idx],
-                                 _memory_for_buckets, _max_size, BUCKETS);
+                                 _memory_for_buckets, _max_size, _buckets);
 
           _back_bucket_idx = _front_bucket_idx;
         }
-        _front_bucket_idx = (_front_bucket_idx + 1) % BUCKETS;
+        _front_bucket_idx = (_front_bucket_idx + 1) % _buckets;
 
         adiar_debug(!has_next_bucket() || !has_front_bucket()
                     || level_cmp_lt(front_bucket_level(), back_bucket_level()),
@@ -879,12 +1072,12 @@ namespace adiar {
       const size_t old_back_bucket_idx = _back_bucket_idx;
 
       // Create a list of the new levels
-      label_t new_levels[BUCKETS];
+      label_t new_levels[MAX_BUCKETS];
       _back_bucket_idx = OUT_OF_BUCKETS_IDX;
 
       // Copy over still relevant levels from current buckets
       do {
-        _front_bucket_idx = (_front_bucket_idx + 1) % BUCKETS;
+        _front_bucket_idx = (_front_bucket_idx + 1) % _buckets;
 
         adiar_debug(has_front_bucket(), "After increment the front bucket will 'exist'");
 
@@ -902,11 +1095,11 @@ namespace adiar {
         _current_level = _level_merger.pull();
       }
 
-      while (_back_bucket_idx + 1 < BUCKETS && _level_merger.can_pull()) {
+      while (_back_bucket_idx + 1 < _buckets && _level_merger.can_pull()) {
         new_levels[++_back_bucket_idx] = _level_merger.pull();
       }
 
-      adiar_debug(_back_bucket_idx == OUT_OF_BUCKETS_IDX || _back_bucket_idx < BUCKETS,
+      adiar_debug(_back_bucket_idx == OUT_OF_BUCKETS_IDX || _back_bucket_idx < _buckets,
                   "_back_bucket_idx is a valid index");
 
       // Relabel all buckets
@@ -918,7 +1111,7 @@ namespace adiar {
         // Reset the prior read-only bucket, if relevant
         if (old_front_bucket_idx <= _back_bucket_idx) {
           sorter_t::reset_unique(_buckets_sorter[old_front_bucket_idx],
-                                 _memory_for_buckets, _max_size, BUCKETS);
+                                 _memory_for_buckets, _max_size, _buckets);
         }
 
         // We can clean up all the dead buckets with a '.reset()' on the
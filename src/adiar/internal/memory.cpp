@@ -1,5 +1,7 @@
 #include "memory.h"
 
+#include <atomic>
+
 #include <tpie/tpie.h>
 
 #include <tpie/memory.h>
@@ -11,6 +13,12 @@ namespace adiar
 {
   namespace memory
   {
+    // Read by every file that is created, which may happen on any thread.
+    std::atomic<size_t> _internal_file_threshold { 0u };
+
+    thread_local size_t _context_limit = 0u;
+    thread_local std::string _context_path;
+
     void set_path(const std::string &temp_dir)
     {
       // Naming scheme and path for temporary files
@@ -45,5 +53,15 @@ namespace adiar
     {
       return tpie::get_block_size();
     }
+
+    void set_internal_file_threshold(size_t threshold_bytes)
+    {
+      _internal_file_threshold = threshold_bytes;
+    }
+
+    size_t get_internal_file_threshold()
+    {
+      return _internal_file_threshold;
+    }
   }
 }
@@ -1,6 +1,7 @@
 #ifndef ADIAR_INTERNAL_MEMORY_H
 #define ADIAR_INTERNAL_MEMORY_H
 
+#include <algorithm>
 #include <string>
 
 #include <tpie/tpie.h>
@@ -32,6 +33,22 @@ namespace adiar
     //////////////////////////////////////////////////////////////////////////////
     size_t get_block_size();
 
+    //////////////////////////////////////////////////////////////////////////////
+    /// \brief   Sets the maximum size (in bytes) of a file kept in internal
+    ///          memory.
+    ///
+    /// \details A temporary file is only moved to disk when it grows beyond this
+    ///          size. Furthermore, all streams of a read-only file on disk of at
+    ///          most this size read from a single copy of it in internal memory.
+    ///          Setting this to 0 places all files on disk.
+    //////////////////////////////////////////////////////////////////////////////
+    void set_internal_file_threshold(size_t threshold_bytes);
+
+    //////////////////////////////////////////////////////////////////////////////
+    /// \brief Get the maximum size (in bytes) of a file kept in internal memory.
+    //////////////////////////////////////////////////////////////////////////////
+    size_t get_internal_file_threshold();
+
     //////////////////////////////////////////////////////////////////////////////
     /// \brief Computes a recommended block size to be used with a specific
     ///        amount of available internal memory.
@@ -39,11 +56,25 @@ namespace adiar
     size_t recommended_block_size(size_t memory_limit_bytes);
 
     //////////////////////////////////////////////////////////////////////////////
-    /// \brief Obtain from TPIE the amount of available memory.
+    /// \brief The memory budget of the <tt>adiar_context</tt> the calling thread
+    ///        currently runs in (0 if none).
+    //////////////////////////////////////////////////////////////////////////////
+    extern thread_local size_t _context_limit;
+
+    //////////////////////////////////////////////////////////////////////////////
+    /// \brief The directory for temporary files of the <tt>adiar_context</tt> the
+    ///        calling thread currently runs in (empty if none or the default).
+    //////////////////////////////////////////////////////////////////////////////
+    extern thread_local std::string _context_path;
+
+    //////////////////////////////////////////////////////////////////////////////
+    /// \brief Obtain from TPIE the amount of available memory. Within an
+    ///        <tt>adiar_context</tt> this is at most its memory budget.
     //////////////////////////////////////////////////////////////////////////////
     inline size_t available()
     {
-      return tpie::get_memory_manager().available();
+      const size_t tpie_available = tpie::get_memory_manager().available();
+      return _context_limit == 0u ? tpie_available : std::min(tpie_available, _context_limit);
     }
   }
 
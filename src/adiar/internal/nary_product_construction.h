@@ -0,0 +1,547 @@
+#ifndef ADIAR_INTERNAL_NARY_PRODUCT_CONSTRUCTION_H
+#define ADIAR_INTERNAL_NARY_PRODUCT_CONSTRUCTION_H
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include <adiar/data.h>
+
+#include <adiar/file.h>
+#include <adiar/file_stream.h>
+#include <adiar/file_writer.h>
+
+#include <adiar/internal/assert.h>
+#include <adiar/internal/decision_diagram.h>
+#include <adiar/internal/levelized_priority_queue.h>
+#include <adiar/internal/memory.h>
+#include <adiar/internal/product_construction.h>
+#include <adiar/internal/util.h>
+
+namespace adiar
+{
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Maximum number of operands combined in a single sweep, i.e. the
+  ///        widest tuple instantiated. Any more are first split into a
+  ///        balanced tree of smaller products.
+  //////////////////////////////////////////////////////////////////////////////
+  constexpr size_t NARY_MAX_OPERANDS = 64u;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Narrowest tuple instantiated. Wider ones double in size up to
+  ///        NARY_MAX_OPERANDS.
+  //////////////////////////////////////////////////////////////////////////////
+  constexpr size_t NARY_MIN_OPERANDS = 4u;
+
+  static_assert(NARY_MIN_OPERANDS <= NARY_MAX_OPERANDS
+                && NARY_MAX_OPERANDS % NARY_MIN_OPERANDS == 0u
+                && ((NARY_MAX_OPERANDS / NARY_MIN_OPERANDS)
+                    & (NARY_MAX_OPERANDS / NARY_MIN_OPERANDS - 1u)) == 0u,
+                "NARY_MAX_OPERANDS must be NARY_MIN_OPERANDS times a power of two");
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Fraction (as 1/x) of the available memory that at most may be used
+  ///        to hold a single level of every operand.
+  //////////////////////////////////////////////////////////////////////////////
+  constexpr size_t NARY_LEVELS_MEMORY_FRACTION = 2u;
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Data structures
+  //
+  // The i'th pointer in a tuple is to a node (or sink) of the i'th operand.
+  // Unused positions, e.g. operands that have become irrelevant, are NIL. The
+  // width K is the smallest instantiated one that fits all operands, such that
+  // a product of few operands does not carry the pointers of many.
+  template<size_t K>
+  struct nary_tuple
+  {
+    ptr_t t[K];
+  };
+
+  template<size_t K>
+  inline ptr_t fst(const nary_tuple<K> &t)
+  {
+    return *std::min_element(t.t, t.t + K);
+  }
+
+  template<size_t K>
+  inline bool operator== (const nary_tuple<K> &a, const nary_tuple<K> &b)
+  {
+    return std::equal(a.t, a.t + K, b.t);
+  }
+
+  template<size_t K>
+  inline bool operator!= (const nary_tuple<K> &a, const nary_tuple<K> &b)
+  {
+    return !(a == b);
+  }
+
+  template<size_t K>
+  struct nary_tuple_label
+  {
+    static inline label_t label_of(const nary_tuple<K> &t)
+    {
+      return adiar::label_of(fst(t));
+    }
+  };
+
+  template<size_t K>
+  struct nary_request : nary_tuple<K>
+  {
+    ptr_t source;
+  };
+
+  template<size_t K>
+  struct nary_request_lt : public std::binary_function<nary_request<K>, nary_request<K>, bool>
+  {
+    bool operator()(const nary_request<K> &a, const nary_request<K> &b)
+    {
+      const ptr_t fst_a = fst(a);
+      const ptr_t fst_b = fst(b);
+
+      // Sort primarily by the element to be encountered first
+      if (fst_a != fst_b) { return fst_a < fst_b; }
+
+      // Group requests to the same tuple together by sorting on the coordinates
+      for (size_t idx = 0u; idx < K; idx++) {
+        if (a.t[idx] != b.t[idx]) { return a.t[idx] < b.t[idx]; }
+      }
+#ifndef NDEBUG
+      return a.source < b.source;
+#else
+      return false;
+#endif
+    }
+  };
+
+  template<size_t K,
+           template<typename, typename> typename sorter_template,
+           template<typename, typename> typename priority_queue_template>
+  using nary_priority_queue_t =
+    levelized_label_priority_queue<nary_request<K>, nary_tuple_label<K>, nary_request_lt<K>,
+                                   sorter_template, priority_queue_template>;
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Helper functions
+  template<typename nary_policy, size_t K>
+  inline bool nary_resolve(const bool_op &op, const size_t operands,
+                           nary_tuple<K> &t, ptr_t &out_sink)
+  {
+    bool has_node = false;
+
+    bool has_neutral = false;
+    ptr_t neutral = NIL;
+
+    bool has_sinks = false;
+    ptr_t sinks = NIL;
+
+    for (size_t idx = 0u; idx < operands; idx++) {
+      if (is_nil(t.t[idx])) { continue; }
+
+      if (is_node(t.t[idx])) {
+        has_node = true;
+      } else if (nary_policy::is_absorbing(op, t.t[idx])) {
+        out_sink = t.t[idx];
+        return true;
+      } else if (nary_policy::is_neutral(op, t.t[idx])) {
+        has_neutral = true;
+        neutral = t.t[idx];
+        t.t[idx] = NIL;
+      } else {
+        sinks = has_sinks ? op(sinks, t.t[idx]) : t.t[idx];
+        has_sinks = true;
+      }
+    }
+
+    if (has_node) { return false; }
+
+    adiar_debug(has_sinks || has_neutral, "A tuple cannot be entirely NIL");
+    out_sink = has_sinks ? sinks : neutral;
+    return true;
+  }
+
+  template<typename nary_policy, size_t K, typename pq_t>
+  inline void nary_recurse_out(pq_t &nary_pq, arc_writer &aw,
+                               const bool_op &op, const size_t operands,
+                               ptr_t source, nary_tuple<K> target)
+  {
+    ptr_t out_sink;
+    if (nary_resolve<nary_policy>(op, operands, target, out_sink)) {
+      aw.unsafe_push_sink({ source, out_sink });
+    } else {
+      adiar_debug(label_of(source) < label_of(fst(target)),
+                  "should always push recursion for 'later' level");
+
+      nary_pq.push({ target, source });
+    }
+  }
+
+  template<size_t N>
+  inline void nary_setup_level(std::unique_ptr<node_stream<>> (&in_nodes) [N],
+                               std::vector<node_t> (&level_nodes) [N],
+                               const size_t operands, const label_t level)
+  {
+    adiar_debug(operands <= N, "Cannot set up more operands than there are streams");
+
+    for (size_t idx = 0u; idx < operands; idx++) {
+      level_nodes[idx].clear();
+
+      // Skip levels without any requests
+      while (in_nodes[idx] -> can_pull()
+             && is_node(in_nodes[idx] -> peek()) && label_of(in_nodes[idx] -> peek()) < level) {
+        in_nodes[idx] -> pull();
+      }
+
+      while (in_nodes[idx] -> can_pull()
+             && is_node(in_nodes[idx] -> peek()) && label_of(in_nodes[idx] -> peek()) == level) {
+        level_nodes[idx].push_back(in_nodes[idx] -> pull());
+      }
+    }
+  }
+
+  inline const node_t& nary_find(const std::vector<node_t> &level_nodes, const ptr_t t)
+  {
+    const auto n = std::lower_bound(level_nodes.begin(), level_nodes.end(), t,
+                                    [](const node_t &n, const ptr_t t) { return n.uid < t; });
+
+    adiar_debug(n != level_nodes.end() && n -> uid == t,
+                "Node should be on the current level of its operand");
+    return *n;
+  }
+
+  inline node_file nary_sink(ptr_t sink)
+  {
+    node_file sink_file;
+    node_writer sink_writer(sink_file);
+
+    sink_writer.push(create_sink(value_of(sink)));
+
+    return sink_file;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Collect the levels of all operands into one file and obtain the
+  ///        number of bytes needed to hold the widest level of every operand.
+  ///
+  /// \param out_widths If given, then the width of the widest level of the
+  ///                   i'th operand is placed at its i'th position.
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename iter_t>
+  size_t __nary_levels(iter_t begin, const size_t operands, label_file &out_levels,
+                       size_t *out_widths = nullptr)
+  {
+    std::vector<label_t> levels;
+    size_t levels_memory = 0u;
+
+    for (size_t idx = 0u; idx < operands; idx++) {
+      level_info_stream<node_t> in_levels(*(begin + idx));
+
+      size_t max_width = 0u;
+      while (in_levels.can_pull()) {
+        const level_info_t li = in_levels.pull();
+
+        levels.push_back(label_of(li));
+        max_width = std::max(max_width, width_of(li));
+      }
+      levels_memory += max_width * sizeof(node_t);
+
+      if (out_widths) { out_widths[idx] = max_width; }
+    }
+
+    std::sort(levels.begin(), levels.end());
+    levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+
+    label_writer lw(out_levels);
+    for (const label_t l : levels) { lw << l; }
+
+    return levels_memory;
+  }
+
+  template<typename iter_t>
+  size_t __nary_max_cut_upper_bound(iter_t begin, const size_t operands)
+  {
+    constexpr size_t max_bits = sizeof(size_t) * 8;
+
+    size_t bound_bits = 0u;
+    size_t bound = 1u;
+
+    for (size_t idx = 0u; idx < operands; idx++) {
+      const size_t nodes = (begin + idx) -> file_ptr() -> size();
+
+      bound_bits += bits_approximation(nodes + 2).bits;
+      if (max_bits <= bound_bits) {
+        return std::numeric_limits<size_t>::max();
+      }
+      bound *= nodes + 2;
+    }
+    return bound + 2;
+  }
+
+  template<typename nary_policy, size_t K, typename pq_t, typename iter_t>
+  typename nary_policy::unreduced_t
+  __nary_product_construction(iter_t begin, const size_t operands,
+                              const bool_op &op,
+                              const label_file &levels,
+                              const std::vector<size_t> &widths,
+                              const size_t pq_memory,
+                              const size_t max_pq_size)
+  {
+    adiar_debug(operands <= K, "Too many operands for a single sweep");
+
+    std::unique_ptr<node_stream<>> in_nodes [K];
+    std::vector<node_t> level_nodes [K];
+
+    // Resolve the tuple of all roots
+    nary_tuple<K> t;
+    std::fill(t.t, t.t + K, NIL);
+
+    for (size_t idx = 0u; idx < operands; idx++) {
+      in_nodes[idx] = std::make_unique<node_stream<>>(*(begin + idx));
+      t.t[idx] = in_nodes[idx] -> peek().uid;
+    }
+
+    {
+      ptr_t out_sink;
+      if (nary_resolve<nary_policy>(op, operands, t, out_sink)) {
+        return nary_sink(out_sink);
+      }
+    }
+
+    // Reserve exactly the widest level of each operand, such that the levels
+    // never take up more memory than was set aside for them.
+    for (size_t idx = 0u; idx < operands; idx++) {
+      level_nodes[idx].reserve(widths[idx]);
+    }
+
+    // Set-up for N-ary Product Construction Algorithm
+    arc_file out_arcs;
+    arc_writer aw(out_arcs);
+
+    pq_t nary_pq({levels}, pq_memory, max_pq_size, &stats_product_construction);
+
+    label_t out_label = label_of(fst(t));
+    id_t out_id = 0;
+
+    nary_setup_level(in_nodes, level_nodes, operands, out_label);
+
+    size_t max_1level_cut = 0;
+
+    // Process requests in topological order of all operands. The first one is
+    // the tuple of all roots from above.
+    while (true) {
+      nary_tuple<K> low, high;
+      std::fill(low.t, low.t + K, NIL);
+      std::fill(high.t, high.t + K, NIL);
+
+      for (size_t idx = 0u; idx < operands; idx++) {
+        if (is_nil(t.t[idx])) { continue; }
+
+        const bool on_level = is_node(t.t[idx]) && label_of(t.t[idx]) == out_label;
+
+        if (on_level) {
+          const node_t &v = nary_find(level_nodes[idx], t.t[idx]);
+          low.t[idx] = v.low;
+          high.t[idx] = v.high;
+        } else {
+          low.t[idx] = t.t[idx];
+          high.t[idx] = t.t[idx];
+        }
+
+        nary_policy::compute_cofactor(on_level, low.t[idx], high.t[idx]);
+      }
+
+      adiar_debug(out_id < MAX_ID, "Has run out of ids");
+      const uid_t out_uid = create_node_uid(out_label, out_id++);
+
+      nary_recurse_out<nary_policy>(nary_pq, aw, op, operands, out_uid, low);
+      nary_recurse_out<nary_policy>(nary_pq, aw, op, operands, flag(out_uid), high);
+
+      while (nary_pq.can_pull() && static_cast<const nary_tuple<K>&>(nary_pq.top()) == t) {
+        aw.unsafe_push_node({ nary_pq.pull().source, out_uid });
+      }
+
+      if (nary_pq.empty()) { break; }
+
+      if (nary_pq.empty_level()) {
+        aw.unsafe_push(create_level_info(out_label, out_id));
+
+        nary_pq.setup_next_level();
+        out_label = nary_pq.current_level();
+        out_id = 0;
+
+        nary_setup_level(in_nodes, level_nodes, operands, out_label);
+
+        max_1level_cut = std::max(max_1level_cut, nary_pq.size());
+      }
+
+      t = nary_pq.top();
+    }
+
+    // Push the level of the very last iteration
+    aw.unsafe_push(create_level_info(out_label, out_id));
+
+    out_arcs._file_ptr->max_1level_cut = max_1level_cut;
+
+    return out_arcs;
+  }
+
+  template<typename nary_policy, typename iter_t>
+  typename nary_policy::unreduced_t
+  __nary_tree(iter_t begin, iter_t end, const bool_op &op);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Combine the operands in a balanced tree of smaller products.
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename nary_policy, typename iter_t>
+  typename nary_policy::unreduced_t
+  __nary_split(iter_t begin, iter_t end, const bool_op &op)
+  {
+    typedef typename nary_policy::reduced_t reduced_t;
+
+#ifdef ADIAR_STATS
+    stats_product_construction.nary_fallbacks++;
+#endif
+    const iter_t mid = begin + std::distance(begin, end) / 2;
+
+    const reduced_t lhs = __nary_tree<nary_policy>(begin, mid, op);
+    const reduced_t rhs = __nary_tree<nary_policy>(mid, end, op);
+
+    return nary_policy::resolve_binary(lhs, rhs, op);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Combine all operands in a single sweep with the narrowest tuple
+  ///        (of width at least K) that fits all of them, unless not even the
+  ///        smallest priority queue of such tuples fits into memory.
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename nary_policy, size_t K, typename iter_t>
+  typename nary_policy::unreduced_t
+  __nary_sweep(iter_t begin, iter_t end, const bool_op &op,
+               const label_file &levels,
+               const std::vector<size_t> &widths,
+               const size_t pq_memory)
+  {
+    const size_t operands = std::distance(begin, end);
+
+    if constexpr (K < NARY_MAX_OPERANDS) {
+      if (K < operands) {
+        return __nary_sweep<nary_policy, 2u * K>(begin, end, op, levels, widths, pq_memory);
+      }
+    }
+    adiar_debug(operands <= K, "Too many operands for a single sweep");
+
+    typedef nary_priority_queue_t<K, internal_sorter, internal_priority_queue> internal_pq_t;
+    typedef nary_priority_queue_t<K, external_sorter, external_priority_queue> external_pq_t;
+
+    const size_t max_pq_size = __nary_max_cut_upper_bound(begin, operands);
+
+    if(max_pq_size <= internal_pq_t::memory_fits(pq_memory)) {
+#ifdef ADIAR_STATS
+      stats_product_construction.nary_sweeps++;
+      stats_product_construction.lpq_internal++;
+#endif
+      return __nary_product_construction<nary_policy, K, internal_pq_t>
+        (begin, operands, op, levels, widths, pq_memory, max_pq_size);
+    }
+
+    if (pq_memory < external_pq_t::memory_minimum()) {
+      return __nary_split<nary_policy>(begin, end, op);
+    }
+
+#ifdef ADIAR_STATS
+    stats_product_construction.nary_sweeps++;
+    stats_product_construction.lpq_external++;
+#endif
+    return __nary_product_construction<nary_policy, K, external_pq_t>
+      (begin, operands, op, levels, widths, pq_memory, max_pq_size);
+  }
+
+  template<typename nary_policy, typename iter_t>
+  typename nary_policy::unreduced_t
+  __nary_tree(iter_t begin, iter_t end, const bool_op &op)
+  {
+    const size_t operands = std::distance(begin, end);
+
+    if (operands == 0u) { return nary_policy::resolve_empty(op); }
+    if (operands == 1u) { return *begin; }
+    if (operands == 2u) { return nary_policy::resolve_binary(*begin, *(begin+1), op); }
+
+    // Memory needed for the streams: one for each input and one for the output.
+    const size_t streams_memory = operands * node_stream<>::memory_usage()
+      + arc_writer::memory_usage();
+
+    // Fall back to a balanced tree of smaller products, if the operands do not
+    // fit into the widest tuple or not even their streams fit into memory.
+    if (NARY_MAX_OPERANDS < operands || memory::available() < streams_memory) {
+      return __nary_split<nary_policy>(begin, end, op);
+    }
+
+    // Compute amount of memory available for auxiliary data structures after
+    // having opened all streams.
+    const size_t available_memory = memory::available() - streams_memory;
+
+    label_file levels;
+    std::vector<size_t> widths(operands);
+    const size_t levels_memory = __nary_levels(begin, operands, levels, widths.data());
+
+    // Fall back to a balanced tree of smaller products, if not a single level
+    // of every operand can be kept in memory.
+    if (available_memory / NARY_LEVELS_MEMORY_FRACTION < levels_memory) {
+      return __nary_split<nary_policy>(begin, end, op);
+    }
+
+    // The levels of all operands are kept in memory next to the priority queue.
+    const size_t pq_memory = available_memory - levels_memory;
+
+    return __nary_sweep<nary_policy, NARY_MIN_OPERANDS>(begin, end, op, levels, widths, pq_memory);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// Creates the product construction of many DAGs with an associative and
+  /// commutative operator in a single sweep.
+  ///
+  /// Behaviour is controlled with the 'nary_policy' class, which exposes the
+  /// following static functions:
+  ///
+  /// - is_absorbing:
+  ///   Whether a sink makes the result of the entire (sub)product be that sink.
+  ///
+  /// - is_neutral:
+  ///   Whether a sink can be ignored for the rest of the (sub)product.
+  ///
+  /// - resolve_empty:
+  ///   The result of combining no operands at all.
+  ///
+  /// - resolve_binary:
+  ///   Combines two operands, e.g. with the binary product construction.
+  ///
+  /// This 'nary_policy' also should inherit the general policy for the
+  /// decision_diagram used (i.e. bdd_policy in bdd/bdd.h, zdd_policy in
+  /// zdd/zdd.h and so on) to provide 'compute_cofactor'.
+  ///
+  /// Up to NARY_MAX_OPERANDS many operands are combined in a single top-down
+  /// sweep with a levelized priority queue of tuples, each only as wide as is
+  /// needed for the given number of operands. If there are more operands, or
+  /// if their streams, a single level of every operand, and the priority queue
+  /// do not fit together into memory, then the operands are instead split into
+  /// a balanced tree of smaller products.
+  ///
+  /// \param dds   DAGs to combine into one.
+  ///
+  /// \param op    Associative and commutative binary boolean operator to be
+  ///              applied.
+  ///
+  /// \return      A class that inherits from __decision_diagram and describes
+  ///              the product of all the given DAGs.
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename nary_policy>
+  typename nary_policy::unreduced_t
+  nary_product_construction(const std::vector<typename nary_policy::reduced_t> &dds,
+                            const bool_op &op)
+  {
+    return __nary_tree<nary_policy>(dds.begin(), dds.end(), op);
+  }
+}
+
+#endif // ADIAR_INTERNAL_NARY_PRODUCT_CONSTRUCTION_H
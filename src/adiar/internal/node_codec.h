@@ -0,0 +1,661 @@
+#ifndef ADIAR_INTERNAL_NODE_CODEC_H
+#define ADIAR_INTERNAL_NODE_CODEC_H
+
+#include <string.h>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <tpie/tpie.h>
+#include <tpie/file_stream.h>
+#include <tpie/progress_indicator_null.h>
+#include <tpie/sort.h>
+
+#include <adiar/data.h>
+
+#include <adiar/internal/assert.h>
+#include <adiar/internal/memory.h>
+
+namespace adiar
+{
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Compact encoding of nodes on disk.
+  ///
+  /// \details Nodes are stored in frames of <tt>FRAME_WORDS</tt> 64-bit words.
+  ///          A frame starts with the index of its first node and the number
+  ///          of nodes and bytes it contains, followed by the nodes encoded as
+  ///          a sequence of variable-length integers (7 bits per byte):
+  ///
+  ///          - The uid is given relative to the prior node in the frame: the
+  ///            difference of their ids if they are on the same level, and
+  ///            otherwise the difference of their labels and the distance of
+  ///            the id from <tt>MAX_ID</tt>.
+  ///
+  ///          - A child is given by its distance in levels and the distance of
+  ///            its id from <tt>MAX_ID</tt>, or by the value of a sink.
+  ///
+  ///          Since ids within a level are dense from <tt>MAX_ID</tt> and
+  ///          downwards and children mostly are on one of the next few
+  ///          levels, most nodes only take 6 to 8 bytes rather than 24 bytes.
+  ///          Anything else, e.g. NIL, is stored as is.
+  ///
+  ///          If the uid of the i'th node on a level is <tt>MAX_ID - i</tt>,
+  ///          as it is in a canonical node file, then the frame is
+  ///          <i>uid-less</i>: only its first node is stored with its uid. The
+  ///          uid of any other node is regenerated from the prior one, where a
+  ///          single bit (and the distance to the next level) marks the start
+  ///          of a new level.
+  ///
+  ///          Every frame can be decoded on its own, which allows reading the
+  ///          nodes in both directions and seeking to any node.
+  //////////////////////////////////////////////////////////////////////////////
+  namespace node_codec
+  {
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Number of words of a frame.
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr size_t FRAME_WORDS = 512u;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Number of words of the header of a frame.
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr size_t HEADER_WORDS = 2u;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Number of bytes for the encoded nodes of a frame.
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr size_t PAYLOAD_BYTES = (FRAME_WORDS - HEADER_WORDS) * sizeof(uint64_t);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Upper bound on the bytes of a single node, i.e. a tag and a raw
+    ///        64-bit word for each of its three values.
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr size_t MAX_NODE_BYTES = 3u * (10u + 10u);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Upper bound on the number of nodes in a frame (each node takes
+    ///        at least two bytes).
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr size_t MAX_FRAME_NODES = PAYLOAD_BYTES / 2u;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Bit of the second header word that marks a uid-less frame.
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr uint64_t UIDLESS_BIT = 1ull << 31;
+
+    inline void put_varint(uint8_t *&out, uint64_t x)
+    {
+      while (x >= 0x80u) {
+        *out++ = static_cast<uint8_t>(x | 0x80u);
+        x >>= 7;
+      }
+      *out++ = static_cast<uint8_t>(x);
+    }
+
+    inline uint64_t get_varint(const uint8_t *&in)
+    {
+      uint64_t x = 0u;
+      for (uint8_t shift = 0u;; shift += 7u) {
+        const uint8_t b = *in++;
+        x |= static_cast<uint64_t>(b & 0x7Fu) << shift;
+        if (b < 0x80u) { return x; }
+      }
+    }
+
+    inline uint64_t zigzag(int64_t x)
+    {
+      return (static_cast<uint64_t>(x) << 1) ^ static_cast<uint64_t>(x >> 63);
+    }
+
+    inline int64_t unzigzag(uint64_t x)
+    {
+      return static_cast<int64_t>(x >> 1) ^ -static_cast<int64_t>(x & 1u);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Tags of a child, stored in the two lowest bits of its first varint.
+    enum ptr_tag : uint64_t { TAG_SINK = 0u, TAG_NODE = 1u, TAG_RAW = 2u, TAG_NIL = 3u };
+
+    //
+    // The first varint is kept below 2^63, such that a uid-less frame can add
+    // one more bit to it.
+    inline uint64_t __ptr_head(const ptr_t p, const label_t label)
+    {
+      if (is_nil(p)) {
+        return ((p - NIL) << 2) | TAG_NIL;
+      } else if (is_sink(p) && p - SINK_BIT < (1ull << 61)) {
+        return ((p - SINK_BIT) << 2) | TAG_SINK;
+      } else if (is_node(p) && label <= label_of(p)) {
+        const uint64_t label_diff = label_of(p) - label;
+        return (((label_diff << 1) | is_flagged(p)) << 2) | TAG_NODE;
+      } else {
+        return TAG_RAW;
+      }
+    }
+
+    inline void __put_ptr_tail(uint8_t *&out, const ptr_t p, const uint64_t head)
+    {
+      switch (head & 3u) {
+      case TAG_NODE: put_varint(out, MAX_ID - id_of(p)); return;
+      case TAG_RAW:  put_varint(out, p); return;
+      default:       return;
+      }
+    }
+
+    inline void put_ptr(uint8_t *&out, const ptr_t p, const label_t label)
+    {
+      const uint64_t head = __ptr_head(p, label);
+      put_varint(out, head);
+      __put_ptr_tail(out, p, head);
+    }
+
+    inline ptr_t __get_ptr_tail(const uint8_t *&in, const uint64_t v, const label_t label)
+    {
+      switch (v & 3u) {
+      case TAG_NIL:  return NIL + (v >> 2);
+      case TAG_SINK: return SINK_BIT + (v >> 2);
+      case TAG_NODE: {
+        const label_t l = label + static_cast<label_t>(v >> 3);
+        const ptr_t p = create_node_ptr(l, MAX_ID - get_varint(in));
+        return (v >> 2) & 1u ? flag(p) : p;
+      }
+      default:       return get_varint(in);
+      }
+    }
+
+    inline ptr_t get_ptr(const uint8_t *&in, const label_t label)
+    {
+      return __get_ptr_tail(in, get_varint(in), label);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Tags of a uid, stored in its first varint (any larger value is the
+    // zigzag encoded difference in labels plus two).
+    enum uid_tag : uint64_t { TAG_UID_RAW = 0u, TAG_UID_SAME_LEVEL = 1u, TAG_UID_LEVEL = 2u };
+
+    inline bool __is_encodable_uid(const uid_t u)
+    {
+      return is_node(u) && !is_flagged(u);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Encode node <tt>n</tt> given the uid of the prior node in the
+    ///        same frame (<tt>NIL</tt> if it is the first).
+    ///
+    /// \returns The number of bytes written to <tt>out</tt>.
+    ////////////////////////////////////////////////////////////////////////////
+    inline size_t encode(uint8_t *out, const node_t &n, const uid_t prior)
+    {
+      uint8_t *const begin = out;
+
+      if (!__is_encodable_uid(n.uid)) {
+        put_varint(out, TAG_UID_RAW);
+        put_varint(out, n.uid);
+      } else if (__is_encodable_uid(prior) && label_of(prior) == label_of(n.uid)) {
+        put_varint(out, TAG_UID_SAME_LEVEL);
+        put_varint(out, zigzag(static_cast<int64_t>(id_of(n.uid)) - static_cast<int64_t>(id_of(prior))));
+      } else {
+        const label_t prior_label = __is_encodable_uid(prior) ? label_of(prior) : 0u;
+        put_varint(out, TAG_UID_LEVEL + zigzag(static_cast<int64_t>(label_of(n.uid)) - prior_label));
+        put_varint(out, MAX_ID - id_of(n.uid));
+      }
+
+      const label_t label = is_node(n.uid) ? label_of(n.uid) : 0u;
+      put_ptr(out, n.low, label);
+      put_ptr(out, n.high, label);
+
+      return out - begin;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Decode the next node given the uid of the prior node in the same
+    ///        frame (<tt>NIL</tt> if it is the first).
+    ////////////////////////////////////////////////////////////////////////////
+    inline node_t decode(const uint8_t *&in, const uid_t prior)
+    {
+      node_t n;
+
+      const uint64_t tag = get_varint(in);
+      if (tag == TAG_UID_RAW) {
+        n.uid = get_varint(in);
+      } else if (tag == TAG_UID_SAME_LEVEL) {
+        const int64_t id = static_cast<int64_t>(id_of(prior)) + unzigzag(get_varint(in));
+        n.uid = create_node_uid(label_of(prior), static_cast<id_t>(id));
+      } else {
+        const label_t prior_label = __is_encodable_uid(prior) ? label_of(prior) : 0u;
+        const label_t label = static_cast<label_t>(prior_label + unzigzag(tag - TAG_UID_LEVEL));
+        n.uid = create_node_uid(label, MAX_ID - get_varint(in));
+      }
+
+      const label_t label = is_node(n.uid) ? label_of(n.uid) : 0u;
+      n.low = get_ptr(in, label);
+      n.high = get_ptr(in, label);
+
+      return n;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Whether the uid of <tt>n</tt> follows from the uid of the prior
+    ///        node in a uid-less frame, i.e. it is the next id on the same
+    ///        level or the first id on a later level.
+    ////////////////////////////////////////////////////////////////////////////
+    inline bool follows(const uid_t prior, const node_t &n)
+    {
+      if (!__is_encodable_uid(prior) || !__is_encodable_uid(n.uid)) { return false; }
+
+      return label_of(n.uid) == label_of(prior)
+        ? id_of(n.uid) + 1u == id_of(prior)
+        : label_of(n.uid) < label_of(prior) && id_of(n.uid) == MAX_ID;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Encode node <tt>n</tt> without its uid, which has to follow from
+    ///        the uid of the prior node in the same frame.
+    ///
+    /// \details The lowest bit of the first varint of the low child marks
+    ///          whether <tt>n</tt> starts a new level, in which case it is
+    ///          followed by the distance to the label of the prior node.
+    ///
+    /// \returns The number of bytes written to <tt>out</tt>.
+    ////////////////////////////////////////////////////////////////////////////
+    inline size_t encode_uidless(uint8_t *out, const node_t &n, const uid_t prior)
+    {
+      adiar_debug(follows(prior, n), "Uid must follow from the prior node");
+      uint8_t *const begin = out;
+
+      const label_t label = label_of(n.uid);
+      const bool new_level = label != label_of(prior);
+
+      const uint64_t low_head = __ptr_head(n.low, label);
+      put_varint(out, (low_head << 1) | new_level);
+      if (new_level) { put_varint(out, label_of(prior) - label - 1u); }
+      __put_ptr_tail(out, n.low, low_head);
+
+      put_ptr(out, n.high, label);
+
+      return out - begin;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Decode the next node of a uid-less frame given the uid of the
+    ///        prior node.
+    ////////////////////////////////////////////////////////////////////////////
+    inline node_t decode_uidless(const uint8_t *&in, const uid_t prior)
+    {
+      node_t n;
+
+      const uint64_t v = get_varint(in);
+      if (v & 1u) {
+        const label_t label = label_of(prior) - 1u - static_cast<label_t>(get_varint(in));
+        n.uid = create_node_uid(label, MAX_ID);
+      } else {
+        n.uid = create_node_uid(label_of(prior), id_of(prior) - 1u);
+      }
+
+      const label_t label = label_of(n.uid);
+      n.low = __get_ptr_tail(in, v >> 1, label);
+      n.high = get_ptr(in, label);
+
+      return n;
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Stream of nodes stored with <tt>node_codec</tt> in a TPIE file.
+  ///
+  /// \details Mirrors the part of <tt>tpie::file_stream<node_t></tt> that is
+  ///          used by <tt>file</tt>, its readers, and its writers, i.e. nodes
+  ///          can be read in both directions, one can seek to any node, and
+  ///          nodes can be appended to the end of the file.
+  ///
+  /// \remark  The frame being appended to is only written to disk when it is
+  ///          full, when another frame is read, or when the stream is closed.
+  ///
+  /// \remark  The buffers for a frame and its decoded nodes are only allocated
+  ///          when a frame is first read or written, such that merely opening
+  ///          a stream, e.g. to obtain its size, does not allocate them.
+  //////////////////////////////////////////////////////////////////////////////
+  class __encoded_node_stream
+  {
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Amount of memory (bytes) used by the buffers of a frame, i.e. the
+    ///        frame itself and its decoded nodes.
+    ////////////////////////////////////////////////////////////////////////////
+    static constexpr size_t frame_memory_usage()
+    {
+      return node_codec::FRAME_WORDS * sizeof(uint64_t)
+        + node_codec::MAX_FRAME_NODES * sizeof(node_t);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Amount of memory (bytes) used by a stream once it has accessed a
+    ///        frame (and not just been opened).
+    ////////////////////////////////////////////////////////////////////////////
+    static size_t memory_usage()
+    {
+      return 8u + memory::get_block_size()
+        + sizeof(__encoded_node_stream)
+        + frame_memory_usage();
+    }
+
+  private:
+    static constexpr size_t NO_FRAME = std::numeric_limits<size_t>::max();
+
+    tpie::file_stream<uint64_t> _words;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Number of frames in <tt>_words</tt> (including a frame that is
+    ///        being appended to but not yet written).
+    ////////////////////////////////////////////////////////////////////////////
+    size_t _frames = 0u;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Number of nodes.
+    ////////////////////////////////////////////////////////////////////////////
+    size_t _size = 0u;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Position of the read head, i.e. in front of the node with this
+    ///        index.
+    ////////////////////////////////////////////////////////////////////////////
+    size_t _pos = 0u;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // The one frame in internal memory (allocated on first access).
+    std::unique_ptr<uint64_t[]> _frame;
+    size_t _frame_idx = NO_FRAME;
+    size_t _frame_first = 0u;
+    size_t _frame_bytes = 0u;
+    bool _frame_dirty = false;
+    bool _frame_uidless = false;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Whether the uid of every node follows from the prior one, i.e.
+    ///        whether new frames are to be uid-less.
+    ////////////////////////////////////////////////////////////////////////////
+    bool _uidless = true;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The decoded nodes of the frame in internal memory.
+    ////////////////////////////////////////////////////////////////////////////
+    std::vector<node_t> _nodes;
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Allocate the buffers for a frame, unless already done.
+    ////////////////////////////////////////////////////////////////////////////
+    void allocate()
+    {
+      if (_frame) { return; }
+
+      _frame = std::make_unique<uint64_t[]>(node_codec::FRAME_WORDS);
+      _nodes.reserve(node_codec::MAX_FRAME_NODES);
+    }
+
+    uint8_t* payload()
+    {
+      return reinterpret_cast<uint8_t*>(_frame.get() + node_codec::HEADER_WORDS);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Write the frame in internal memory to disk, if it has changed.
+    ////////////////////////////////////////////////////////////////////////////
+    void flush()
+    {
+      if (!_frame_dirty) { return; }
+
+      _frame[0] = _frame_first;
+      _frame[1] = (static_cast<uint64_t>(_nodes.size()) << 32)
+        | (_frame_uidless ? node_codec::UIDLESS_BIT : 0u)
+        | _frame_bytes;
+
+      _words.seek(_frame_idx * node_codec::FRAME_WORDS);
+      for (size_t w = 0u; w < node_codec::FRAME_WORDS; w++) {
+        _words.write(_frame[w]);
+      }
+      _frame_dirty = false;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Load and decode the given frame.
+    ////////////////////////////////////////////////////////////////////////////
+    void load(const size_t frame_idx)
+    {
+      if (frame_idx == _frame_idx) { return; }
+      flush();
+      allocate();
+
+      _words.seek(frame_idx * node_codec::FRAME_WORDS);
+      for (size_t w = 0u; w < node_codec::FRAME_WORDS; w++) {
+        _frame[w] = _words.read();
+      }
+
+      _frame_idx = frame_idx;
+      _frame_first = _frame[0];
+      _frame_bytes = _frame[1] & (node_codec::UIDLESS_BIT - 1u);
+      _frame_uidless = _frame[1] & node_codec::UIDLESS_BIT;
+
+      const size_t count = _frame[1] >> 32;
+      _nodes.clear();
+
+      const uint8_t *in = payload();
+      uid_t prior = NIL;
+      for (size_t i = 0u; i < count; i++) {
+        const node_t n = _frame_uidless && i > 0u
+          ? node_codec::decode_uidless(in, prior)
+          : node_codec::decode(in, prior);
+        _nodes.push_back(n);
+        prior = n.uid;
+      }
+      adiar_debug(static_cast<size_t>(in - payload()) == _frame_bytes,
+                  "Decoded frame should match its size");
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Start a new (empty) frame at the end of the file.
+    ////////////////////////////////////////////////////////////////////////////
+    void begin_frame()
+    {
+      flush();
+      allocate();
+
+      _frame_idx = _frames++;
+      _frame_first = _size;
+      _frame_bytes = 0u;
+      _frame_uidless = _uidless;
+      _nodes.clear();
+      memset(_frame.get(), 0, node_codec::FRAME_WORDS * sizeof(uint64_t));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Load the frame with the node at the given index.
+    ////////////////////////////////////////////////////////////////////////////
+    void locate(const size_t idx)
+    {
+      adiar_debug(idx < _size, "Cannot locate a node beyond the end");
+
+      if (_frame_idx != NO_FRAME) {
+        const size_t frame_end = _frame_first + _nodes.size();
+        if (_frame_first <= idx && idx < frame_end) { return; }
+
+        // Sequential access in either direction
+        if (idx == frame_end) { load(_frame_idx + 1u); return; }
+        if (idx + 1u == _frame_first) { load(_frame_idx - 1u); return; }
+      }
+
+      // Binary search on the index of the first node of each frame
+      flush();
+
+      size_t low = 0u;
+      size_t high = _frames;
+      while (high - low > 1u) {
+        const size_t mid = low + (high - low) / 2u;
+
+        _words.seek(mid * node_codec::FRAME_WORDS);
+        if (_words.read() <= idx) { low = mid; } else { high = mid; }
+      }
+      load(low);
+    }
+
+  public:
+    __encoded_node_stream() = default;
+
+    ~__encoded_node_stream()
+    {
+      if (is_open()) { close(); }
+    }
+
+    void open(tpie::temp_file &f, tpie::access_type access)
+    {
+      _words.open(f, access);
+
+      _frames = _words.size() / node_codec::FRAME_WORDS;
+      _size = 0u;
+      _pos = 0u;
+      _frame_idx = NO_FRAME;
+      _frame_dirty = false;
+      _uidless = true;
+
+      if (_frames > 0u) {
+        _words.seek((_frames - 1u) * node_codec::FRAME_WORDS);
+        const uint64_t first = _words.read();
+        const uint64_t info = _words.read();
+        _size = first + (info >> 32);
+        _uidless = info & node_codec::UIDLESS_BIT;
+      }
+    }
+
+    bool is_open() const
+    {
+      return _words.is_open();
+    }
+
+    void close()
+    {
+      flush();
+      _words.close();
+      _frame_idx = NO_FRAME;
+    }
+
+    size_t size() const
+    {
+      return _size;
+    }
+
+    void seek(size_t idx)
+    {
+      adiar_debug(idx <= _size, "Cannot seek past the end of the file");
+      _pos = idx;
+    }
+
+    void seek(size_t idx, decltype(tpie::file_stream_base::end) whence)
+    {
+      _pos = whence == tpie::file_stream_base::end ? _size - idx : idx;
+    }
+
+    bool can_read() const
+    {
+      return _pos < _size;
+    }
+
+    bool can_read_back() const
+    {
+      return 0u < _pos;
+    }
+
+    node_t read()
+    {
+      locate(_pos);
+      return _nodes[_pos++ - _frame_first];
+    }
+
+    node_t read_back()
+    {
+      locate(--_pos);
+      return _nodes[_pos - _frame_first];
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Append a node to the end of the file.
+    ////////////////////////////////////////////////////////////////////////////
+    void write(const node_t &n)
+    {
+      if (_frames == 0u) {
+        begin_frame();
+      } else if (_frame_idx != _frames - 1u) {
+        load(_frames - 1u);
+      }
+
+      const uid_t prior = _nodes.empty() ? NIL : _nodes.back().uid;
+
+      // Fall back to storing the uids as soon as one does not follow from the
+      // prior one. The uid-less frames written until now stay as they are.
+      if (_uidless && !is_nil(prior) && !node_codec::follows(prior, n)) {
+        _uidless = false;
+        if (_frame_uidless) { begin_frame(); }
+      }
+
+      uint8_t bytes[node_codec::MAX_NODE_BYTES];
+      size_t len = _frame_uidless && !_nodes.empty()
+        ? node_codec::encode_uidless(bytes, n, prior)
+        : node_codec::encode(bytes, n, _nodes.empty() ? NIL : prior);
+
+      if (node_codec::PAYLOAD_BYTES < _frame_bytes + len) {
+        begin_frame();
+        len = node_codec::encode(bytes, n, NIL);
+      }
+
+      memcpy(payload() + _frame_bytes, bytes, len);
+      _frame_bytes += len;
+      _frame_dirty = true;
+
+      _nodes.push_back(n);
+      _size++;
+      _pos = _size;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Sort the nodes of the file.
+    ///
+    /// \details The nodes are decoded into a temporary TPIE file, sorted with
+    ///          <tt>tpie::sort</tt>, and then encoded anew, since the order of
+    ///          the nodes decides how they are encoded.
+    ////////////////////////////////////////////////////////////////////////////
+    template<typename pred_t>
+    void sort(pred_t pred)
+    {
+      tpie::temp_file tmp_file;
+      tpie::file_stream<node_t> tmp;
+      tmp.open(tmp_file, tpie::access_type::access_read_write);
+
+      seek(0u);
+      while (can_read()) { tmp.write(read()); }
+      flush();
+
+      tpie::progress_indicator_null pi;
+      tpie::sort(tmp, pred, pi);
+
+      _words.truncate(0u);
+      _frames = 0u;
+      _size = 0u;
+      _pos = 0u;
+      _frame_idx = NO_FRAME;
+      _uidless = true;
+
+      tmp.seek(0u);
+      while (tmp.can_read()) { write(tmp.read()); }
+    }
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// Nodes on disk are read and written with the <tt>__encoded_node_stream</tt>.
+  //////////////////////////////////////////////////////////////////////////////
+  template<>
+  inline size_t __tpie_file_stream_memory_usage<node_t>()
+  {
+    return __encoded_node_stream::memory_usage();
+  }
+}
+
+#endif // ADIAR_INTERNAL_NODE_CODEC_H
@@ -0,0 +1,49 @@
+#include "parallel.h"
+
+#include <atomic>
+
+#include <adiar/internal/assert.h>
+
+namespace adiar
+{
+  namespace parallel
+  {
+    // Set by 'adiar_init' and 'adiar_context' while operations on other threads
+    // may read them.
+    std::atomic<size_t> _threads { 1u };
+    std::atomic<size_t> _grain { 1u << 16 };
+    std::atomic<bool> _sorting { false };
+
+    void set_threads(size_t threads)
+    {
+      adiar_assert(threads > 0u, "Adiar requires at least one thread");
+      _threads = threads;
+    }
+
+    size_t get_threads()
+    {
+      return _threads;
+    }
+
+    void set_grain(size_t elements)
+    {
+      adiar_assert(elements > 0u, "The grain size must be positive");
+      _grain = elements;
+    }
+
+    size_t get_grain()
+    {
+      return _grain;
+    }
+
+    void set_sorting(bool enabled)
+    {
+      _sorting = enabled;
+    }
+
+    bool get_sorting()
+    {
+      return _sorting;
+    }
+  }
+}
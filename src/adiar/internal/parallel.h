@@ -0,0 +1,318 @@
+#ifndef ADIAR_INTERNAL_PARALLEL_H
+#define ADIAR_INTERNAL_PARALLEL_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <adiar/statistics.h>
+
+#include <adiar/internal/memory.h>
+
+namespace adiar
+{
+  namespace parallel
+  {
+    //////////////////////////////////////////////////////////////////////////////
+    /// \brief Sets the number of threads Adiar may use within a single
+    ///        operation. The default of 1 disables all parallel code paths.
+    //////////////////////////////////////////////////////////////////////////////
+    void set_threads(size_t threads = 1u);
+
+    //////////////////////////////////////////////////////////////////////////////
+    /// \brief Get the number of threads Adiar may use within a single operation.
+    //////////////////////////////////////////////////////////////////////////////
+    size_t get_threads();
+
+    //////////////////////////////////////////////////////////////////////////////
+    /// \brief Sets the minimum number of elements given to each thread, i.e.
+    ///        the size below which work is not worth sharing between threads.
+    //////////////////////////////////////////////////////////////////////////////
+    void set_grain(size_t elements);
+
+    //////////////////////////////////////////////////////////////////////////////
+    /// \brief Get the minimum number of elements given to each thread.
+    //////////////////////////////////////////////////////////////////////////////
+    size_t get_grain();
+
+    //////////////////////////////////////////////////////////////////////////////
+    /// \brief Sets whether the internal sorters (e.g. the buckets of the
+    ///        levelized priority queues) are sorted with multiple threads. By
+    ///        default, this is disabled.
+    //////////////////////////////////////////////////////////////////////////////
+    void set_sorting(bool enabled = false);
+
+    //////////////////////////////////////////////////////////////////////////////
+    /// \brief Whether the internal sorters are sorted with multiple threads.
+    //////////////////////////////////////////////////////////////////////////////
+    bool get_sorting();
+
+    //////////////////////////////////////////////////////////////////////////////
+    /// \brief Number of threads to use for work on the given number of elements.
+    //////////////////////////////////////////////////////////////////////////////
+    inline size_t threads_for(size_t elements)
+    {
+      const size_t threads = get_threads();
+      const size_t grain = get_grain();
+
+      const size_t max_threads = std::max<size_t>(1u, elements / grain);
+      return std::min(threads, max_threads);
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    /// \brief   Start a thread that runs <tt>f()</tt> within the context of the
+    ///          calling thread.
+    ///
+    /// \details The new thread shares the memory budget and the directory for
+    ///          temporary files of the calling thread. Its statistics are added
+    ///          to the ones of the calling thread (or its context) when it is
+    ///          done.
+    //////////////////////////////////////////////////////////////////////////////
+    template<typename F>
+    std::thread spawn(F &&f)
+    {
+      return std::thread([limit = memory::_context_limit,
+                          path = memory::_context_path,
+                          stats = __stats_get_inbox(),
+                          f = std::forward<F>(f)]() mutable {
+        memory::_context_limit = limit;
+        memory::_context_path = std::move(path);
+
+        f();
+
+        std::lock_guard<std::mutex> lock(stats -> mutex);
+        __stats_add(stats -> stats, __stats_collect());
+      });
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    /// \brief   Index of the first element of a chunk, when the given number of
+    ///          elements are split into (almost) equally sized chunks.
+    //////////////////////////////////////////////////////////////////////////////
+    inline size_t chunk_begin(size_t elements, size_t chunks, size_t chunk)
+    {
+      return (elements * chunk) / chunks;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    /// \brief   Split the elements into the given number of chunks and process
+    ///          each of them on its own thread.
+    ///
+    /// \param f Function called as <tt>f(chunk, begin, end)</tt> for the indices
+    ///          [begin, end) of each chunk. The calling thread processes the
+    ///          first chunk and the others are processed on threads started
+    ///          with <tt>spawn</tt>.
+    //////////////////////////////////////////////////////////////////////////////
+    template<typename chunk_f>
+    void for_each_chunk(size_t elements, size_t chunks, const chunk_f &f)
+    {
+      std::vector<std::thread> workers;
+      workers.reserve(chunks - 1u);
+
+      for (size_t chunk = 1u; chunk < chunks; chunk++) {
+        const size_t begin = chunk_begin(elements, chunks, chunk);
+        const size_t end = chunk_begin(elements, chunks, chunk + 1u);
+
+        workers.push_back(spawn([&f, chunk, begin, end]() { f(chunk, begin, end); }));
+      }
+      f(0u, 0u, chunk_begin(elements, chunks, 1u));
+
+      for (std::thread &w : workers) { w.join(); }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    /// \brief   Sort the elements in [begin, end) with up to
+    ///          <tt>get_threads()</tt> threads.
+    ///
+    /// \details Each thread sorts a chunk of the input, after which pairs of
+    ///          sorted chunks are merged in parallel until only one is left.
+    ///          The merges go through <tt>scratch</tt>, which has to have room
+    ///          for as many elements as [begin, end), such that no memory is
+    ///          allocated outside of the caller's memory budget.
+    //////////////////////////////////////////////////////////////////////////////
+    template<typename it_t, typename scratch_it_t, typename pred_t>
+    void sort(it_t begin, it_t end, scratch_it_t scratch, pred_t pred)
+    {
+      const size_t elements = end - begin;
+      const size_t chunks = threads_for(elements);
+
+      if (chunks <= 1u) {
+        std::sort(begin, end, pred);
+        return;
+      }
+
+      for_each_chunk(elements, chunks, [&](size_t, size_t b, size_t e) {
+        std::sort(begin + b, begin + e, pred);
+      });
+
+      for (size_t width = 1u; width < chunks; width *= 2u) {
+        std::vector<std::thread> workers;
+
+        for (size_t chunk = 0u; chunk + width < chunks; chunk += 2u * width) {
+          const it_t left  = begin + chunk_begin(elements, chunks, chunk);
+          const it_t mid   = begin + chunk_begin(elements, chunks, chunk + width);
+          const it_t right = begin + chunk_begin(elements, chunks,
+                                                 std::min(chunk + 2u * width, chunks));
+
+          const scratch_it_t out = scratch + (left - begin);
+
+          workers.push_back(spawn([=]() {
+            const scratch_it_t out_end = std::merge(left, mid, mid, right, out, pred);
+            std::copy(out, out_end, left);
+          }));
+        }
+
+        for (std::thread &w : workers) { w.join(); }
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    /// \brief   Wraps a stream, such that its elements are read ahead on a
+    ///          separate thread into one of two buffers while the other buffer
+    ///          is consumed by the calling thread.
+    ///
+    /// \details The wrapped stream is only accessed by the reading thread
+    ///          (after its construction), so it need not be thread-safe.
+    ///
+    /// \param stream_t Type of the stream with a <tt>can_pull()</tt> and a
+    ///                 <tt>pull()</tt> function.
+    //////////////////////////////////////////////////////////////////////////////
+    template<typename stream_t>
+    class prefetch_stream
+    {
+    public:
+      typedef std::decay_t<decltype(std::declval<stream_t&>().pull())> elem_t;
+
+      //////////////////////////////////////////////////////////////////////////////
+      /// \brief Default number of elements in each of the two buffers.
+      //////////////////////////////////////////////////////////////////////////////
+      static constexpr size_t DEFAULT_BLOCK_SIZE = 1u << 14;
+
+      //////////////////////////////////////////////////////////////////////////////
+      /// \brief Amount of memory (bytes) used by the buffers.
+      //////////////////////////////////////////////////////////////////////////////
+      static constexpr size_t memory_usage(size_t block_size = DEFAULT_BLOCK_SIZE)
+      {
+        return 2u * block_size * sizeof(elem_t);
+      }
+
+    private:
+      stream_t _stream;
+
+      struct buffer_t
+      {
+        std::vector<elem_t> elems;
+        bool ready = false;
+        bool last = false;
+      } _buffers[2];
+
+      size_t _buffer_idx = 0u;
+      size_t _elem_idx = 0u;
+
+      bool _stop = false;
+      std::mutex _mutex;
+      std::condition_variable _cv;
+
+      std::thread _reader;
+
+    public:
+      template<typename... stream_args_t>
+      prefetch_stream(size_t block_size, stream_args_t&&... stream_args)
+        : _stream(std::forward<stream_args_t>(stream_args)...)
+      {
+        _buffers[0].elems.reserve(block_size);
+        _buffers[1].elems.reserve(block_size);
+
+        _reader = spawn([this, block_size]() { read(block_size); });
+
+        // Wait for the first buffer, such that can_pull() need not block twice.
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cv.wait(lock, [this]() { return _buffers[0].ready; });
+      }
+
+      ~prefetch_stream()
+      {
+        {
+          std::lock_guard<std::mutex> lock(_mutex);
+          _stop = true;
+        }
+        _cv.notify_all();
+        _reader.join();
+      }
+
+      prefetch_stream(const prefetch_stream&) = delete;
+      prefetch_stream& operator= (const prefetch_stream&) = delete;
+
+    private:
+      void read(size_t block_size)
+      {
+        for (size_t idx = 0u; true; idx ^= 1u) {
+          buffer_t &b = _buffers[idx];
+          {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cv.wait(lock, [this, &b]() { return _stop || !b.ready; });
+            if (_stop) { return; }
+          }
+
+          b.elems.clear();
+          while (b.elems.size() < block_size && _stream.can_pull()) {
+            b.elems.push_back(_stream.pull());
+          }
+          const bool last = !_stream.can_pull();
+
+          {
+            std::lock_guard<std::mutex> lock(_mutex);
+            b.ready = true;
+            b.last = last;
+          }
+          _cv.notify_all();
+
+          if (last) { return; }
+        }
+      }
+
+    public:
+      //////////////////////////////////////////////////////////////////////////////
+      /// \brief Whether the stream contains more elements.
+      //////////////////////////////////////////////////////////////////////////////
+      bool can_pull()
+      {
+        while (_elem_idx == _buffers[_buffer_idx].elems.size()) {
+          if (_buffers[_buffer_idx].last) { return false; }
+
+          // Hand the consumed buffer back to the reader and move to the next.
+          {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _buffers[_buffer_idx].ready = false;
+          }
+          _cv.notify_all();
+
+          _buffer_idx ^= 1u;
+          _elem_idx = 0u;
+
+          std::unique_lock<std::mutex> lock(_mutex);
+          _cv.wait(lock, [this]() { return _buffers[_buffer_idx].ready; });
+        }
+        return true;
+      }
+
+      //////////////////////////////////////////////////////////////////////////////
+      /// \brief Obtain the next element (and move the read head).
+      //////////////////////////////////////////////////////////////////////////////
+      elem_t pull()
+      {
+        can_pull();
+        return _buffers[_buffer_idx].elems[_elem_idx++];
+      }
+    };
+  }
+}
+
+#endif // ADIAR_INTERNAL_PARALLEL_H
@@ -1,11 +1,16 @@
 #include "pred.h"
 
+#include <atomic>
+#include <vector>
+
 #include <adiar/file_stream.h>
+#include <adiar/internal/memory.h>
+#include <adiar/internal/parallel.h>
 #include <adiar/internal/util.h>
 
 namespace adiar
 {
-  stats_t::equality_t stats_equality;
+  thread_local stats_t::equality_t stats_equality;
 
   //////////////////////////////////////////////////////////////////////////////
   // Slow O(sort(N)) I/Os comparison by traversing the product construction and
@@ -158,8 +163,66 @@ namespace adiar
   //  - The number of nodes are the same (to simplify the 'while' condition)
   //  - The node_files are both 'canonical'.
   //  - The negation flags given for both node_files agree (breaks canonicity)
+  //
+  // If multiple threads may be used, then the files are split into ranges of
+  // levels with roughly the same number of nodes. Each range is compared on
+  // its own thread, where a mismatch in one range stops all other threads.
+  bool __fast_isomorphism_check_parallel(const node_file &f1, const node_file &f2,
+                                         const size_t chunks)
+  {
+    const size_t nodes = f1.size();
+
+    // Index (within the files) of the first node of each chunk, moved forward
+    // to the beginning of a level.
+    std::vector<size_t> chunk_begin(chunks + 1u, nodes);
+    chunk_begin[0] = 0u;
+    {
+      level_info_stream<node_t, true> in_meta(f1);
+
+      size_t chunk = 1u;
+      size_t level_begin = 0u;
+      while (in_meta.can_pull() && chunk < chunks) {
+        level_begin += width_of(in_meta.pull());
+        while (chunk < chunks && parallel::chunk_begin(nodes, chunks, chunk) <= level_begin) {
+          chunk_begin[chunk++] = level_begin;
+        }
+      }
+    }
+
+    std::atomic<bool> mismatch = false;
+
+    parallel::for_each_chunk(nodes, chunks, [&](size_t chunk, size_t, size_t) {
+      node_stream<true> in_1(f1);
+      in_1.seek(chunk_begin[chunk]);
+
+      node_stream<true> in_2(f2);
+      in_2.seek(chunk_begin[chunk]);
+
+      for (size_t idx = chunk_begin[chunk]; idx < chunk_begin[chunk + 1u]; idx++) {
+        if (in_1.pull() != in_2.pull()) {
+          mismatch.store(true, std::memory_order_relaxed);
+        }
+        if (mismatch.load(std::memory_order_relaxed)) { return; }
+      }
+    });
+
+#ifdef ADIAR_STATS
+    stats_equality.fast_check.parallel_runs++;
+    if (mismatch) { stats_equality.fast_check.exit_on_mismatch++; }
+#endif
+    return !mismatch;
+  }
+
   bool fast_isomorphism_check(const node_file &f1, const node_file &f2)
   {
+    const size_t chunks =
+      std::min(parallel::threads_for(f1.size()),
+               memory::available() / (2u * node_stream<>::memory_usage()));
+
+    if (1u < chunks) {
+      return __fast_isomorphism_check_parallel(f1, f2, chunks);
+    }
+
     node_stream<> in_nodes_1(f1);
     node_stream<> in_nodes_2(f2);
 
@@ -215,6 +278,14 @@ namespace adiar
       return false;
     }
 
+    // Are they trivially not the same, since their Merkle hashes differ?
+    if (f1._file_ptr->hash[negate1] != f2._file_ptr->hash[negate2]) {
+#ifdef ADIAR_STATS
+      stats_equality.exit_on_hash++;
+#endif
+      return false;
+    }
+
     // Are they trivially not the same, since the labels or the size of each
     // level does not match?
     { // Create new scope to garbage collect the two meta_streams early
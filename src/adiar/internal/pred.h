@@ -8,6 +8,7 @@
 
 #include <adiar/internal/decision_diagram.h>
 #include <adiar/internal/levelized_priority_queue.h>
+#include <adiar/internal/parallel.h>
 #include <adiar/internal/product_construction.h>
 #include <adiar/internal/tuple.h>
 
@@ -15,7 +16,7 @@ namespace adiar
 {
   //////////////////////////////////////////////////////////////////////////////
   /// Struct to hold statistics for equality checking
-  extern stats_t::equality_t stats_equality;
+  extern thread_local stats_t::equality_t stats_equality;
 
   //////////////////////////////////////////////////////////////////////////////
   /// \brief Given two node files, computes whether they are isomorphic; i.e.
@@ -47,15 +48,46 @@ namespace adiar
   template<template<typename, typename> typename priority_queue_template>
   using comparison_priority_queue_2_t =  priority_queue_template<tuple_data, tuple_snd_lt>;
 
-  template<typename comp_policy, typename pq_1_t, typename pq_2_t>
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Node stream that reads its nodes ahead on a separate thread, such
+  ///        that the I/O of both inputs overlaps with the priority queues.
+  //////////////////////////////////////////////////////////////////////////////
+  class prefetch_node_stream : public parallel::prefetch_stream<node_stream<>>
+  {
+  public:
+    static constexpr size_t memory_usage()
+    {
+      return node_stream<>::memory_usage()
+        + parallel::prefetch_stream<node_stream<>>::memory_usage();
+    }
+
+  public:
+    prefetch_node_stream(const node_file &f, bool negate = false)
+      : parallel::prefetch_stream<node_stream<>>(DEFAULT_BLOCK_SIZE, f, negate)
+    { }
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Whether the slow comparison check should read its inputs on
+  ///        separate threads, i.e. whether two more threads may be used and
+  ///        the inputs are large enough for it to pay off.
+  //////////////////////////////////////////////////////////////////////////////
+  inline bool comparison_check_prefetch(const node_file &f1, const node_file &f2)
+  {
+    return 3u <= parallel::get_threads()
+      && 1u < parallel::threads_for(f1.size() + f2.size());
+  }
+
+  template<typename comp_policy, typename pq_1_t, typename pq_2_t,
+           typename in_stream_t = node_stream<>>
   bool __comparison_check(const node_file &f1, const node_file &f2,
                           const bool negate1, const bool negate2,
                           const tpie::memory_size_type pq_1_memory,
                           const tpie::memory_size_type pq_2_memory,
                           const size_t max_pq_size)
   {
-    node_stream<> in_nodes_1(f1, negate1);
-    node_stream<> in_nodes_2(f2, negate2);
+    in_stream_t in_nodes_1(f1, negate1);
+    in_stream_t in_nodes_2(f2, negate2);
 
     node_t v1 = in_nodes_1.pull();
     node_t v2 = in_nodes_2.pull();
@@ -72,7 +104,7 @@ namespace adiar
     }
 
     // Set up priority queue for recursion
-    pq_1_t comparison_pq_1({f1, f2}, pq_1_memory, max_pq_size);
+    pq_1_t comparison_pq_1({f1, f2}, pq_1_memory, max_pq_size, &stats_equality);
 
     // Check for violation on root children, or 'recurse' otherwise
     label_t level = label_of(fst(v1.uid, v2.uid));
@@ -204,12 +236,18 @@ namespace adiar
     // We then may derive an upper bound on the size of auxiliary data
     // structures and check whether we can run them with a faster internal
     // memory variant.
+    const bool prefetch = comparison_check_prefetch(f1, f2);
+
     const size_t aux_available_memory = memory::available()
       // Input
-      - 2*node_stream<>::memory_usage()
+      - 2*(prefetch ? prefetch_node_stream::memory_usage() : node_stream<>::memory_usage())
       // Level checker policy
       - comp_policy::level_check_t::memory_usage();
 
+#ifdef ADIAR_STATS
+    if (prefetch) { stats_equality.slow_check.prefetched_runs++; }
+#endif
+
     constexpr size_t data_structures_in_pq_1 =
       comparison_priority_queue_1_t<internal_sorter, internal_priority_queue>::DATA_STRUCTURES;
 
@@ -235,10 +273,16 @@ namespace adiar
 #ifdef ADIAR_STATS
       stats_equality.lpq_internal++;
 #endif
-      return __comparison_check<comp_policy,
-                                comparison_priority_queue_1_t<internal_sorter, internal_priority_queue>,
-                                comparison_priority_queue_2_t<internal_priority_queue>>
-        (f1, f2, negate1, negate2, pq_1_internal_memory, pq_2_internal_memory, max_pq_size);
+      return prefetch
+        ? __comparison_check<comp_policy,
+                             comparison_priority_queue_1_t<internal_sorter, internal_priority_queue>,
+                             comparison_priority_queue_2_t<internal_priority_queue>,
+                             prefetch_node_stream>
+          (f1, f2, negate1, negate2, pq_1_internal_memory, pq_2_internal_memory, max_pq_size)
+        : __comparison_check<comp_policy,
+                             comparison_priority_queue_1_t<internal_sorter, internal_priority_queue>,
+                             comparison_priority_queue_2_t<internal_priority_queue>>
+          (f1, f2, negate1, negate2, pq_1_internal_memory, pq_2_internal_memory, max_pq_size);
     } else {
 #ifdef ADIAR_STATS
       stats_equality.lpq_external++;
@@ -246,10 +290,16 @@ namespace adiar
       const size_t pq_1_memory = aux_available_memory / 2;
       const size_t pq_2_memory = pq_1_memory;
 
-      return __comparison_check<comp_policy,
-                                comparison_priority_queue_1_t<external_sorter, external_priority_queue>,
-                                comparison_priority_queue_2_t<external_priority_queue>>
-        (f1, f2, negate1, negate2, pq_1_memory, pq_2_memory, max_pq_size);
+      return prefetch
+        ? __comparison_check<comp_policy,
+                             comparison_priority_queue_1_t<external_sorter, external_priority_queue>,
+                             comparison_priority_queue_2_t<external_priority_queue>,
+                             prefetch_node_stream>
+          (f1, f2, negate1, negate2, pq_1_memory, pq_2_memory, max_pq_size)
+        : __comparison_check<comp_policy,
+                             comparison_priority_queue_1_t<external_sorter, external_priority_queue>,
+                             comparison_priority_queue_2_t<external_priority_queue>>
+          (f1, f2, negate1, negate2, pq_1_memory, pq_2_memory, max_pq_size);
     }
   }
 
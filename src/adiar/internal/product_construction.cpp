@@ -1,5 +1,5 @@
 #include "product_construction.h"
 
 namespace adiar {
-  stats_t::product_construction_t stats_product_construction;
+  thread_local stats_t::product_construction_t stats_product_construction;
 }
@@ -19,7 +19,7 @@ namespace adiar
 {
   //////////////////////////////////////////////////////////////////////////////
   /// Struct to hold statistics
-  extern stats_t::product_construction_t stats_product_construction;
+  extern thread_local stats_t::product_construction_t stats_product_construction;
 
   //////////////////////////////////////////////////////////////////////////////
   // Data structures
@@ -82,9 +82,9 @@ namespace adiar
 
   //////////////////////////////////////////////////////////////////////////////
   // Helper functions
-  template<typename pq_1_t>
+  template<typename pq_1_t, typename op_t>
   inline void prod_recurse_out(pq_1_t &prod_pq_1, arc_writer &aw,
-                               const bool_op &op,
+                               const op_t &op,
                                ptr_t source, tuple target)
   {
     if (is_sink(target.t1) && is_sink(target.t2)) {
@@ -145,7 +145,8 @@ namespace adiar
     }
   };
 
-  inline node_file prod_sink(ptr_t t1, ptr_t t2, const bool_op &op)
+  template<typename op_t>
+  inline node_file prod_sink(ptr_t t1, ptr_t t2, const op_t &op)
   {
     node_file sink_file;
     node_writer sink_writer(sink_file);
@@ -237,14 +238,15 @@ namespace adiar
     }
   };
 
-  template<typename prod_policy, typename pq_1_t, typename pq_2_t>
+  template<typename prod_policy, typename pq_1_t, typename pq_2_t, typename op_t>
   typename prod_policy::unreduced_t
   __product_construction(const typename prod_policy::reduced_t &in_1,
                          const typename prod_policy::reduced_t &in_2,
-                         const bool_op &op,
+                         const op_t &op,
                          const size_t pq_1_memory,
                          const size_t pq_2_memory,
-                         const size_t max_pq_size)
+                         const size_t max_pq_size,
+                         const size_t out_memory)
   {
     node_stream<> in_nodes_1(in_1);
     node_stream<> in_nodes_2(in_2);
@@ -262,9 +264,13 @@ namespace adiar
 
     // Set-up for Product Construction Algorithm
     arc_file out_arcs;
+    if (0u < out_memory) {
+      out_arcs._file_ptr->set_internal_capacity(out_memory,
+                                                in_1.file_ptr()->meta_size() + in_2.file_ptr()->meta_size());
+    }
     arc_writer aw(out_arcs);
 
-    pq_1_t prod_pq_1({in_1, in_2}, pq_1_memory, max_pq_size);
+    pq_1_t prod_pq_1({in_1, in_2}, pq_1_memory, max_pq_size, &stats_product_construction);
     pq_2_t prod_pq_2(pq_2_memory, max_pq_size);
 
     // Process root and create initial recursion requests
@@ -405,13 +411,21 @@ namespace adiar
 
     out_arcs._file_ptr->max_1level_cut = max_1level_cut;
 
+#ifdef ADIAR_STATS
+    if (out_arcs._file_ptr->is_on_disk()) {
+      stats_product_construction.fused_spilled++;
+    } else {
+      stats_product_construction.fused_internal++;
+    }
+#endif
+
     return out_arcs;
   }
 
-  template<typename prod_policy>
+  template<typename prod_policy, typename op_t>
   size_t __prod_max_cut_upper_bound(const typename prod_policy::reduced_t &in_1,
                                     const typename prod_policy::reduced_t &in_2,
-                                    const bool_op &op)
+                                    const op_t &op)
   {
     const size_t nodes_in_1 = in_1.file_ptr()->size();
     const size_t left_leaves = prod_policy::left_leaves(op);
@@ -432,6 +446,115 @@ namespace adiar
     }
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Upper bound on the number of bytes of the unreduced output, i.e.
+  ///        of two arcs for every pair of nodes and sinks in the inputs.
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename prod_policy>
+  size_t __prod_out_size_upper_bound(const typename prod_policy::reduced_t &in_1,
+                                     const typename prod_policy::reduced_t &in_2)
+  {
+    const size_t nodes_in_1 = in_1.file_ptr()->size();
+    const size_t nodes_in_2 = in_2.file_ptr()->size();
+
+    const bits_approximation in_1_bits(nodes_in_1);
+    const bits_approximation in_2_bits(nodes_in_2);
+
+    const bits_approximation bound_bits =
+      (in_1_bits + 2) * (in_2_bits + 2) * 2 * sizeof(arc_t);
+
+    if(bound_bits.may_overflow()) {
+      return std::numeric_limits<size_t>::max();
+    } else {
+      return (nodes_in_1 + 2) * (nodes_in_2 + 2) * 2 * sizeof(arc_t);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Fraction (as 1/x) of the available memory that at most is set aside
+  ///        to keep the unreduced output in internal memory.
+  ///
+  /// \details The Reduce that follows the product construction then reads the
+  ///          arcs directly from internal memory rather than from disk. Memory
+  ///          is only set aside if the output is guaranteed to fit. Otherwise,
+  ///          it would likely be spilled to disk anyway, and the priority
+  ///          queues are better off with all of the memory.
+  //////////////////////////////////////////////////////////////////////////////
+  constexpr size_t PROD_OUT_MEMORY_FRACTION = 4u;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Product construction for an operator of type 'op_t', i.e. either
+  ///        one of the operator types in data.h or a generic bool_op.
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename prod_policy, typename op_t>
+  typename prod_policy::unreduced_t __product_construction_op(const typename prod_policy::reduced_t &in_1,
+                                                              const typename prod_policy::reduced_t &in_2,
+                                                              const op_t &op)
+  {
+    // Compute amount of memory available for auxiliary data structures after
+    // having opened all streams.
+    //
+    // We then may derive an upper bound on the size of auxiliary data
+    // structures and check whether we can run them with a faster internal
+    // memory variant.
+    const size_t available_memory = memory::available()
+      // Input streams
+      - 2*node_stream<>::memory_usage()
+      // Output stream
+      - arc_writer::memory_usage();
+
+    // Set aside memory to keep the (small) output in internal memory, such that
+    // the following Reduce does not need to read it from disk.
+    const size_t out_size_bound = __prod_out_size_upper_bound<prod_policy>(in_1, in_2);
+    const size_t out_memory =
+      out_size_bound <= available_memory / PROD_OUT_MEMORY_FRACTION ? out_size_bound : 0u;
+
+    const size_t aux_available_memory = available_memory - out_memory;
+
+    constexpr size_t data_structures_in_pq_1 =
+      prod_priority_queue_1_t<internal_sorter, internal_priority_queue>::DATA_STRUCTURES;
+
+    constexpr size_t data_structures_in_pq_2 =
+      prod_priority_queue_2_t<internal_priority_queue>::DATA_STRUCTURES;
+
+    const size_t pq_1_internal_memory =
+      (aux_available_memory / (data_structures_in_pq_1 + data_structures_in_pq_2)) * data_structures_in_pq_1;
+
+    const size_t pq_2_internal_memory = aux_available_memory - pq_1_internal_memory;
+
+    const size_t max_pq_size = __prod_max_cut_upper_bound<prod_policy, op_t>(in_1, in_2, op);
+
+    const size_t pq_1_memory_fits =
+      prod_priority_queue_1_t<internal_sorter, internal_priority_queue>::memory_fits(pq_1_internal_memory);
+
+    const size_t pq_2_memory_fits =
+      prod_priority_queue_2_t<internal_priority_queue>::memory_fits(pq_2_internal_memory);
+
+    // TODO: maximum 1-level cut suffices for pq_2!
+    if(max_pq_size <= pq_1_memory_fits && max_pq_size <= pq_2_memory_fits) {
+#ifdef ADIAR_STATS
+      stats_product_construction.lpq_internal++;
+#endif
+      return __product_construction<prod_policy,
+                                    prod_priority_queue_1_t<internal_sorter, internal_priority_queue>,
+                                    prod_priority_queue_2_t<internal_priority_queue>,
+                                    op_t>
+        (in_1, in_2, op, pq_1_internal_memory, pq_2_internal_memory, max_pq_size, out_memory);
+    } else {
+#ifdef ADIAR_STATS
+      stats_product_construction.lpq_external++;
+#endif
+      const size_t pq_1_memory = aux_available_memory / 2;
+      const size_t pq_2_memory = pq_1_memory;
+
+      return __product_construction<prod_policy,
+                                    prod_priority_queue_1_t<external_sorter, external_priority_queue>,
+                                    prod_priority_queue_2_t<external_priority_queue>,
+                                    op_t>
+        (in_1, in_2, op, pq_1_memory, pq_2_memory, max_pq_size, out_memory);
+    }
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// Creates the product construction of the given two DAGs.
   ///
@@ -472,7 +595,9 @@ namespace adiar
   /// \param in_i  DAGs to combine into one.
   ///
   /// \param op    Binary boolean operator to be applied. See data.h for the
-  ///              ones directly provided by Adiar.
+  ///              ones directly provided by Adiar. These are resolved at
+  ///              compile-time, so the strategy functions above and the
+  ///              evaluation of sinks are instantiated for each of them.
   ///
   /// \return      A class that inherits from __decision_diagram and describes
   ///              the product of the two given DAGs.
@@ -486,58 +611,10 @@ namespace adiar
       return prod_policy::resolve_same_file(in_1, in_2, op);
     }
 
-    // Compute amount of memory available for auxiliary data structures after
-    // having opened all streams.
-    //
-    // We then may derive an upper bound on the size of auxiliary data
-    // structures and check whether we can run them with a faster internal
-    // memory variant.
-    const size_t aux_available_memory = memory::available()
-      // Input streams
-      - 2*node_stream<>::memory_usage()
-      // Output stream
-      - arc_writer::memory_usage();
-
-    constexpr size_t data_structures_in_pq_1 =
-      prod_priority_queue_1_t<internal_sorter, internal_priority_queue>::DATA_STRUCTURES;
-
-    constexpr size_t data_structures_in_pq_2 =
-      prod_priority_queue_2_t<internal_priority_queue>::DATA_STRUCTURES;
-
-    const size_t pq_1_internal_memory =
-      (aux_available_memory / (data_structures_in_pq_1 + data_structures_in_pq_2)) * data_structures_in_pq_1;
-
-    const size_t pq_2_internal_memory = aux_available_memory - pq_1_internal_memory;
-
-    const size_t max_pq_size = __prod_max_cut_upper_bound<prod_policy>(in_1, in_2, op);
-
-    const size_t pq_1_memory_fits =
-      prod_priority_queue_1_t<internal_sorter, internal_priority_queue>::memory_fits(pq_1_internal_memory);
-
-    const size_t pq_2_memory_fits =
-      prod_priority_queue_2_t<internal_priority_queue>::memory_fits(pq_2_internal_memory);
-
-    // TODO: maximum 1-level cut suffices for pq_2!
-    if(max_pq_size <= pq_1_memory_fits && max_pq_size <= pq_2_memory_fits) {
-#ifdef ADIAR_STATS
-      stats_product_construction.lpq_internal++;
-#endif
-      return __product_construction<prod_policy,
-                                    prod_priority_queue_1_t<internal_sorter, internal_priority_queue>,
-                                    prod_priority_queue_2_t<internal_priority_queue>>
-        (in_1, in_2, op, pq_1_internal_memory, pq_2_internal_memory, max_pq_size);
-    } else {
-#ifdef ADIAR_STATS
-      stats_product_construction.lpq_external++;
-#endif
-      const size_t pq_1_memory = aux_available_memory / 2;
-      const size_t pq_2_memory = pq_1_memory;
-
-      return __product_construction<prod_policy,
-                                    prod_priority_queue_1_t<external_sorter, external_priority_queue>,
-                                    prod_priority_queue_2_t<external_priority_queue>>
-        (in_1, in_2, op, pq_1_memory, pq_2_memory, max_pq_size);
-    }
+    // Resolve the operator at compile-time, if it is one of the predefined.
+    return bool_op_dispatch(op, [&](const auto &static_op) {
+      return __product_construction_op<prod_policy>(in_1, in_2, static_op);
+    });
   }
 }
 
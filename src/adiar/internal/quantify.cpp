@@ -1,5 +1,5 @@
 #include "quantify.h"
 
 namespace adiar {
-  stats_t::quantify_t stats_quantify;
+  thread_local stats_t::quantify_t stats_quantify;
 }
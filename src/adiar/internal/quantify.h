@@ -16,7 +16,7 @@ namespace adiar
 {
   //////////////////////////////////////////////////////////////////////////////
   /// Struct to hold statistics
-  extern stats_t::quantify_t stats_quantify;
+  extern thread_local stats_t::quantify_t stats_quantify;
 
   //////////////////////////////////////////////////////////////////////////////
   // Data structures
@@ -162,7 +162,7 @@ namespace adiar
     arc_file out_arcs;
     arc_writer aw(out_arcs);
 
-    pq_1_t quantify_pq_1({in}, pq_1_memory, max_pq_size);
+    pq_1_t quantify_pq_1({in}, pq_1_memory, max_pq_size, &stats_quantify);
     pq_2_t quantify_pq_2(pq_2_memory, max_pq_size);
 
     label_t out_label = label_of(v.uid);
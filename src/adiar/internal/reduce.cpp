@@ -2,5 +2,5 @@
 
 namespace adiar
 {
-  stats_t::reduce_t stats_reduce;
+  thread_local stats_t::reduce_t stats_reduce;
 }
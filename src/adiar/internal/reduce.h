@@ -1,6 +1,10 @@
 #ifndef ADIAR_INTERNAL_REDUCE_H
 #define ADIAR_INTERNAL_REDUCE_H
 
+#include <vector>
+
+#include <tpie/array.h>
+
 #include <adiar/file.h>
 #include <adiar/file_stream.h>
 #include <adiar/file_writer.h>
@@ -8,6 +12,7 @@
 #include <adiar/internal/assert.h>
 #include <adiar/internal/levelized_priority_queue.h>
 #include <adiar/internal/memory.h>
+#include <adiar/internal/parallel.h>
 #include <adiar/internal/sorter.h>
 
 #include <adiar/statistics.h>
@@ -16,21 +21,39 @@ namespace adiar
 {
   //////////////////////////////////////////////////////////////////////////////
   /// Struct to hold statistics
-  extern stats_t::reduce_t stats_reduce;
+  extern thread_local stats_t::reduce_t stats_reduce;
 
   //////////////////////////////////////////////////////////////////////////////
   // Data structures
+  //
+  // The Merkle hash of each output node is derived from the hashes of its
+  // children, which are carried along with the new uid of a node in the
+  // mappings and with the arcs forwarded to its parents.
   struct mapping
   {
     uid_t old_uid;
     uid_t new_uid;
+    node_hash hash;
+  };
+
+  struct reduce_arc
+  {
+    ptr_t source;
+    ptr_t target;
+    node_hash hash;
+  };
+
+  struct reduce_node
+  {
+    node_t node;
+    node_hash hash;
   };
 
   //////////////////////////////////////////////////////////////////////////////
   // For priority queue
   struct reduce_queue_lt
   {
-    bool operator()(const arc_t &a, const arc_t &b)
+    bool operator()(const reduce_arc &a, const reduce_arc &b)
     {
       // We want the high arc first, but that is already placed on the
       // least-significant bit on the source variable.
@@ -40,7 +63,7 @@ namespace adiar
 
   struct reduce_queue_label
   {
-    static label_t label_of(const arc_t &a)
+    static label_t label_of(const reduce_arc &a)
     {
       return adiar::label_of(a.source);
     }
@@ -49,18 +72,18 @@ namespace adiar
   template<template<typename, typename> typename sorter_template,
            template<typename, typename> typename priority_queue_template>
   using reduce_priority_queue_t =
-    levelized_arc_priority_queue<arc_t, reduce_queue_label, reduce_queue_lt,
+    levelized_arc_priority_queue<reduce_arc, reduce_queue_label, reduce_queue_lt,
                                  sorter_template, priority_queue_template>;
 
   //////////////////////////////////////////////////////////////////////////////
   // For sorting for Reduction Rule 2 (and back again)
   struct reduce_node_children_lt
   {
-    bool operator()(const node_t &a, const node_t &b)
+    bool operator()(const reduce_node &a, const reduce_node &b)
     {
-      return a.high > b.high ||
-        (a.high == b.high && a.low > b.low) ||
-        (a.high == b.high && a.low == b.low && a.uid > b.uid);
+      return a.node.high > b.node.high ||
+        (a.node.high == b.node.high && a.node.low > b.node.low) ||
+        (a.node.high == b.node.high && a.node.low == b.node.low && a.node.uid > b.node.uid);
     }
   };
 
@@ -77,42 +100,34 @@ namespace adiar
 
   // Merging priority queue with sink_arc stream
   template <typename pq_t>
-  inline arc_t __reduce_get_next(pq_t &reduce_pq, sink_arc_stream<false> &sink_arcs)
+  inline reduce_arc __reduce_get_next(pq_t &reduce_pq, sink_arc_stream<false> &sink_arcs)
   {
     if (!reduce_pq.can_pull()
         || (sink_arcs.can_pull() && sink_arcs.peek().source > reduce_pq.top().source)) {
-      return sink_arcs.pull();
+      const arc_t e = sink_arcs.pull();
+      return { e.source, e.target, hash_of_sink(value_of(e.target)) };
     } else {
       return reduce_pq.pull();
     }
   }
 
-  template <typename dd_policy, typename pq_t, template<typename, typename> typename sorter_t>
-  void __reduce_level(sink_arc_stream<> &sink_arcs,
-                      node_arc_stream<> &node_arcs,
-                      pq_t &reduce_pq,
-                      label_t &label,
-                      node_writer &out_writer,
-                      const size_t sorters_memory,
-                      const size_t level_width)
+  // Pull out all nodes from reduce_pq and sink_arcs for 'label'. Nodes removed
+  // by Reduction Rule 1 are mapped in red1_mapping, all others are pushed to
+  // child_grouping.
+  template <typename dd_policy, typename pq_t, typename child_grouping_t>
+  inline void __reduce_collect(sink_arc_stream<> &sink_arcs,
+                               pq_t &reduce_pq,
+                               const label_t label,
+                               tpie::file_stream<mapping> &red1_mapping,
+                               child_grouping_t &child_grouping)
   {
-    // Temporary file for Reduction Rule 1 mappings (opened later if need be)
-    tpie::file_stream<mapping> red1_mapping;
-
-    // Sorter to find Reduction Rule 2 mappings
-    sorter_t<node_t, reduce_node_children_lt>
-      child_grouping(sorters_memory, level_width, 2);
-
-    sorter_t<mapping, reduce_uid_lt>
-      red2_mapping(sorters_memory, level_width, 2);
-
-    // Pull out all nodes from reduce_pq and sink_arcs for this level
     while ((sink_arcs.can_pull() && label_of(sink_arcs.peek().source) == label)
             || reduce_pq.can_pull()) {
-      const arc_t e_high = __reduce_get_next(reduce_pq, sink_arcs);
-      const arc_t e_low = __reduce_get_next(reduce_pq, sink_arcs);
+      const reduce_arc e_high = __reduce_get_next(reduce_pq, sink_arcs);
+      const reduce_arc e_low = __reduce_get_next(reduce_pq, sink_arcs);
 
-      node_t n = node_of(e_low, e_high);
+      node_t n = node_of(arc_t { e_low.source, e_low.target },
+                         arc_t { e_high.source, e_high.target });
 
       // Apply Reduction rule 1
       ptr_t reduction_rule_ret = dd_policy::reduction_rule(n);
@@ -123,61 +138,31 @@ namespace adiar
 #ifdef ADIAR_STATS_EXTRA
         stats_reduce.removed_by_rule_1++;
 #endif
-        red1_mapping.write({ n.uid, reduction_rule_ret });
+        const node_hash &h = reduction_rule_ret == n.low ? e_low.hash : e_high.hash;
+        red1_mapping.write({ n.uid, reduction_rule_ret, h });
       } else {
-        child_grouping.push(n);
+        child_grouping.push({ n, hash_of_node(label, e_low.hash, e_high.hash) });
       }
     }
-    // Sort and apply Reduction rule 2
-    child_grouping.sort();
-
-    if (child_grouping.can_pull()) {
-      // Set up for remapping, keeping the very first node seen
-      id_t out_id = MAX_ID;
-      node_t current_node = child_grouping.pull();
-
-      adiar_debug(out_id > 0, "Has run out of ids");
-
-      node_t out_node = create_node(label, out_id--, current_node.low, current_node.high);
-      out_writer.unsafe_push(out_node);
-
-      red2_mapping.push({ current_node.uid, out_node.uid });
-
-      // Keep the first node with different children than prior, and remap all
-      // the later that match its children.
-      while (child_grouping.can_pull()) {
-        node_t next_node = child_grouping.pull();
-        if (current_node.low == next_node.low && current_node.high == next_node.high) {
-#ifdef ADIAR_STATS_EXTRA
-          stats_reduce.removed_by_rule_2++;
-#endif
-          red2_mapping.push({ next_node.uid, out_node.uid });
-        } else {
-          current_node = next_node;
-
-          out_node = create_node(label, out_id, current_node.low, current_node.high);
-          out_writer.unsafe_push(out_node);
-          out_id--;
-
-          red2_mapping.push({current_node.uid, out_node.uid});
-        }
-      }
-
-      out_writer.unsafe_push(create_level_info(label, MAX_ID - out_id));
-    }
-
-    // Sort mappings for Reduction rule 2 back in order of node_arcs
-    red2_mapping.sort();
+  }
 
+  // Pass all mappings of Reduction Rule 1 and 2 (in order of node_arcs) to the
+  // parents in reduce_pq. Returns the last mapping of Reduction Rule 1 (if any).
+  template <typename pq_t, typename red2_t>
+  inline mapping __reduce_forward(node_arc_stream<> &node_arcs,
+                                  pq_t &reduce_pq,
+                                  tpie::file_stream<mapping> &red1_mapping,
+                                  red2_t &red2_mapping)
+  {
     // Merging of red1_mapping and red2_mapping
-    mapping next_red1 = {0, 0};
+    mapping next_red1 = { 0, 0, {{ 0u, 0u }} };
     bool has_next_red1 = red1_mapping.is_open() && red1_mapping.size() > 0;
     if (has_next_red1) {
       red1_mapping.seek(0);
       next_red1 = red1_mapping.read();
     }
 
-    mapping next_red2 = {0, 0};
+    mapping next_red2 = { 0, 0, {{ 0u, 0u }} };
     bool has_next_red2 = red2_mapping.can_pull();
     if (has_next_red2) {
       next_red2 = red2_mapping.pull();
@@ -196,7 +181,7 @@ namespace adiar
       // Find all arcs that have sources that match the current mapping's old_uid
       while (node_arcs.can_pull() && current_map.old_uid == node_arcs.peek().target) {
         // The is_high flag is included in arc_t..source
-        arc_t new_arc = { node_arcs.pull().source, current_map.new_uid };
+        reduce_arc new_arc = { node_arcs.pull().source, current_map.new_uid, current_map.hash };
         reduce_pq.push(new_arc);
       }
 
@@ -217,6 +202,20 @@ namespace adiar
     // Move on to the next level
     red1_mapping.close();
 
+    return next_red1;
+  }
+
+  // Set up reduce_pq and label for the next level. If no level is left and
+  // nothing has been output, then the diagram collapsed to the sink given by
+  // the last mapping of Reduction Rule 1.
+  template <typename pq_t>
+  inline void __reduce_next_level(sink_arc_stream<> &sink_arcs,
+                                  node_arc_stream<> &node_arcs,
+                                  pq_t &reduce_pq,
+                                  label_t &label,
+                                  node_writer &out_writer,
+                                  const mapping &last_red1)
+  {
     if (!reduce_pq.empty()) {
       adiar_debug(!sink_arcs.can_pull() || label_of(sink_arcs.peek().source) < label,
                   "All sink arcs for 'label' should be processed");
@@ -247,8 +246,214 @@ namespace adiar
       adiar_debug(!out_writer.has_pushed(),
                   "No nodes are pushed when it collapses to a sink");
 
-      out_writer.push({ next_red1.new_uid, NIL, NIL });
+      out_writer.push({ last_red1.new_uid, NIL, NIL });
+    }
+  }
+
+  template <typename dd_policy, typename pq_t, template<typename, typename> typename sorter_t>
+  void __reduce_level(sink_arc_stream<> &sink_arcs,
+                      node_arc_stream<> &node_arcs,
+                      pq_t &reduce_pq,
+                      label_t &label,
+                      node_writer &out_writer,
+                      const size_t sorters_memory,
+                      const size_t level_width)
+  {
+    // Temporary file for Reduction Rule 1 mappings (opened later if need be)
+    tpie::file_stream<mapping> red1_mapping;
+
+    // Sorter to find Reduction Rule 2 mappings
+    sorter_t<reduce_node, reduce_node_children_lt>
+      child_grouping(sorters_memory, level_width, 2);
+
+    sorter_t<mapping, reduce_uid_lt>
+      red2_mapping(sorters_memory, level_width, 2);
+
+    // Pull out all nodes from reduce_pq and sink_arcs for this level
+    __reduce_collect<dd_policy>(sink_arcs, reduce_pq, label, red1_mapping, child_grouping);
+
+    // Sort and apply Reduction rule 2
+    child_grouping.sort();
+
+    if (child_grouping.can_pull()) {
+      // Set up for remapping, keeping the very first node seen
+      id_t out_id = MAX_ID;
+      reduce_node current = child_grouping.pull();
+
+      adiar_debug(out_id > 0, "Has run out of ids");
+
+      node_t out_node = create_node(label, out_id--, current.node.low, current.node.high);
+      out_writer.unsafe_push(out_node, current.hash);
+
+      red2_mapping.push({ current.node.uid, out_node.uid, current.hash });
+
+      // Keep the first node with different children than prior, and remap all
+      // the later that match its children.
+      while (child_grouping.can_pull()) {
+        const reduce_node next = child_grouping.pull();
+        if (current.node.low == next.node.low && current.node.high == next.node.high) {
+#ifdef ADIAR_STATS_EXTRA
+          stats_reduce.removed_by_rule_2++;
+#endif
+          red2_mapping.push({ next.node.uid, out_node.uid, current.hash });
+        } else {
+          current = next;
+
+          out_node = create_node(label, out_id, current.node.low, current.node.high);
+          out_writer.unsafe_push(out_node, current.hash);
+          out_id--;
+
+          red2_mapping.push({ current.node.uid, out_node.uid, current.hash });
+        }
+      }
+
+      out_writer.unsafe_push(create_level_info(label, MAX_ID - out_id));
     }
+
+    // Sort mappings for Reduction rule 2 back in order of node_arcs
+    red2_mapping.sort();
+
+    const mapping last_red1 = __reduce_forward(node_arcs, reduce_pq, red1_mapping, red2_mapping);
+    __reduce_next_level(sink_arcs, node_arcs, reduce_pq, label, out_writer, last_red1);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Multi-threaded variant of __reduce_level for wide levels that fit into
+  // internal memory. The output is identical to the one above, since both
+  // sorting predicates are total orders.
+  //
+  // - Both sorts are split over multiple threads.
+  //
+  // - The new identifiers of Reduction Rule 2 are assigned in parallel: each
+  //   thread first counts the distinct children in its chunk of the sorted
+  //   nodes, after which the prefix sum over these counts provides the first
+  //   identifier of each chunk.
+  //
+  // The other threads only work on the arrays below, which are allocated
+  // beforehand on the calling thread. All TPIE allocations and all access to
+  // out_writer and reduce_pq stay on the calling thread.
+
+  // Number of nodes that fit into the given memory for __reduce_level_parallel:
+  // the collected nodes, the output nodes, the mappings, and the scratch space
+  // of the sort of the mappings (which is more than the one for the nodes).
+  inline size_t __reduce_level_parallel_fits(const size_t sorters_memory)
+  {
+    return sorters_memory / (2u * sizeof(reduce_node) + 2u * sizeof(mapping));
+  }
+
+  template <typename dd_policy, typename pq_t>
+  void __reduce_level_parallel(sink_arc_stream<> &sink_arcs,
+                               node_arc_stream<> &node_arcs,
+                               pq_t &reduce_pq,
+                               label_t &label,
+                               node_writer &out_writer,
+                               const size_t level_width)
+  {
+    // Temporary file for Reduction Rule 1 mappings (opened later if need be)
+    tpie::file_stream<mapping> red1_mapping;
+
+    // Pull out all nodes from reduce_pq and sink_arcs for this level
+    struct level_nodes_t
+    {
+      tpie::array<reduce_node> nodes;
+      size_t size = 0u;
+
+      void push(const reduce_node &n)
+      {
+        adiar_debug(size < nodes.size(), "Level is wider than given in its level_info");
+        nodes[size++] = n;
+      }
+    } level_nodes { tpie::array<reduce_node>(level_width) };
+
+    __reduce_collect<dd_policy>(sink_arcs, reduce_pq, label, red1_mapping, level_nodes);
+
+    const tpie::array<reduce_node> &nodes = level_nodes.nodes;
+    const size_t nodes_size = level_nodes.size;
+
+    // Sort and apply Reduction rule 2
+    {
+      tpie::array<reduce_node> scratch(nodes_size);
+      parallel::sort(level_nodes.nodes.begin(), level_nodes.nodes.begin() + nodes_size,
+                     scratch.begin(), reduce_node_children_lt());
+    }
+
+    const auto is_new_children = [&nodes](const size_t idx) -> bool {
+      return idx == 0u
+        || nodes[idx-1u].node.low != nodes[idx].node.low
+        || nodes[idx-1u].node.high != nodes[idx].node.high;
+    };
+
+    const size_t chunks = parallel::threads_for(nodes_size);
+
+    std::vector<size_t> chunk_offset(chunks + 1u, 0u);
+    parallel::for_each_chunk(nodes_size, chunks, [&](size_t chunk, size_t begin, size_t end) {
+      size_t new_children = 0u;
+      for (size_t idx = begin; idx < end; idx++) {
+        if (is_new_children(idx)) { new_children++; }
+      }
+      chunk_offset[chunk + 1u] = new_children;
+    });
+
+    for (size_t chunk = 0u; chunk < chunks; chunk++) {
+      chunk_offset[chunk + 1u] += chunk_offset[chunk];
+    }
+
+    const size_t out_size = chunk_offset[chunks];
+    adiar_debug(out_size <= MAX_ID, "Has run out of ids");
+
+#ifdef ADIAR_STATS_EXTRA
+    stats_reduce.removed_by_rule_2 += nodes_size - out_size;
+#endif
+
+    tpie::array<reduce_node> out_nodes(out_size);
+    tpie::array<mapping> red2_mapping(nodes_size);
+
+    parallel::for_each_chunk(nodes_size, chunks, [&](size_t chunk, size_t begin, size_t end) {
+      // Index of the latest output node (one prior to the chunk's first)
+      size_t out_idx = chunk_offset[chunk] - 1u;
+
+      for (size_t idx = begin; idx < end; idx++) {
+        if (is_new_children(idx)) {
+          out_idx++;
+          out_nodes[out_idx] = {
+            create_node(label, MAX_ID - out_idx, nodes[idx].node.low, nodes[idx].node.high),
+            nodes[idx].hash
+          };
+        }
+        red2_mapping[idx] = {
+          nodes[idx].node.uid, create_node_uid(label, MAX_ID - out_idx), nodes[idx].hash
+        };
+      }
+    });
+
+    // Write the output nodes
+    for (size_t out_idx = 0u; out_idx < out_size; out_idx++) {
+      out_writer.unsafe_push(out_nodes[out_idx].node, out_nodes[out_idx].hash);
+    }
+    if (out_size > 0u) {
+      out_writer.unsafe_push(create_level_info(label, out_size));
+    }
+
+    // Sort mappings for Reduction rule 2 back in order of node_arcs
+    {
+      tpie::array<mapping> scratch(nodes_size);
+      parallel::sort(red2_mapping.begin(), red2_mapping.begin() + nodes_size,
+                     scratch.begin(), reduce_uid_lt());
+    }
+
+    struct red2_stream_t
+    {
+      const tpie::array<mapping> &mappings;
+      const size_t size;
+      size_t idx = 0u;
+
+      bool can_pull() const { return idx < size; }
+      mapping pull() { return mappings[idx++]; }
+    } red2_stream { red2_mapping, nodes_size };
+
+    const mapping last_red1 = __reduce_forward(node_arcs, reduce_pq, red1_mapping, red2_stream);
+
+    __reduce_next_level(sink_arcs, node_arcs, reduce_pq, label, out_writer, last_red1);
   }
 
   template<typename dd_policy, typename pq_t>
@@ -293,13 +498,14 @@ namespace adiar
       return out_file;
     }
 
-    pq_t reduce_pq({in_file}, lpq_memory, in_file._file_ptr->max_1level_cut);
+    pq_t reduce_pq({in_file}, lpq_memory, in_file._file_ptr->max_1level_cut, &stats_reduce);
 
     // Find the first label
     // TODO take from level info instead
     label_t label = label_of(sink_arcs.peek().source);
 
-    const size_t internal_sorter_can_fit = internal_sorter<node_t>::memory_fits(sorters_memory / 2);
+    const size_t internal_sorter_can_fit = internal_sorter<reduce_node>::memory_fits(sorters_memory / 2);
+    const size_t parallel_can_fit = __reduce_level_parallel_fits(sorters_memory);
 
     // Process bottom-up each level
     while (sink_arcs.can_pull() || !reduce_pq.empty()) {
@@ -309,7 +515,13 @@ namespace adiar
       const level_info_t current_level_info = level_info.pull();
       const size_t level_width = width_of(current_level_info);
 
-      if(level_width <= internal_sorter_can_fit) {
+      if (1u < parallel::threads_for(level_width) && level_width <= parallel_can_fit) {
+#ifdef ADIAR_STATS
+        stats_reduce.parallel_levels++;
+#endif
+        __reduce_level_parallel<dd_policy, pq_t>
+          (sink_arcs, node_arcs, reduce_pq, label, out_writer, level_width);
+      } else if(level_width <= internal_sorter_can_fit) {
         __reduce_level<dd_policy, pq_t, internal_sorter>
           (sink_arcs, node_arcs, reduce_pq, label, out_writer, sorters_memory, level_width);
       } else {
@@ -0,0 +1,408 @@
+#ifndef ADIAR_INTERNAL_SAMPLE_H
+#define ADIAR_INTERNAL_SAMPLE_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <adiar/data.h>
+#include <adiar/file.h>
+#include <adiar/file_stream.h>
+#include <adiar/file_writer.h>
+
+#include <adiar/internal/assert.h>
+#include <adiar/internal/count.h>
+#include <adiar/internal/decision_diagram.h>
+#include <adiar/internal/priority_queue.h>
+#include <adiar/internal/sorter.h>
+
+namespace adiar
+{
+  //////////////////////////////////////////////////////////////////////////////
+  // Sampling
+  //
+  // A batch of k paths to the true sink are drawn uniformly at random with
+  // three sweeps of the diagram:
+  //
+  // 1. A top-down sweep writes all arcs grouped by their target. That is, the
+  //    transposed diagram.
+  //
+  // 2. A bottom-up sweep derives the (logarithm of the) number of paths below
+  //    each node. With the transposed arcs, each count is forwarded to the
+  //    parents. The probability of following the high arc is written to a side
+  //    file.
+  //
+  // 3. A top-down sweep forwards the k sample requests with a levelized
+  //    priority queue. Each choice is placed in a sorter, from which the k
+  //    samples are finally put together.
+  //
+  // Hence, this takes O(sort(N + k·L)) I/Os.
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Data structures
+  struct sample_parent
+  {
+    uid_t uid;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Source of the arc, flagged if it is a high arc.
+    ////////////////////////////////////////////////////////////////////////////
+    ptr_t source;
+  };
+
+  struct sample_count
+  {
+    uid_t uid;
+    double log2_count;
+    bool high;
+  };
+
+  struct sample_request
+  {
+    uid_t uid;
+    size_t sample;
+  };
+
+  struct sample_choice
+  {
+    size_t sample;
+    label_t label;
+    bool value;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Priority queue functions
+  template<>
+  struct count_queue_lt<sample_parent>
+  {
+    bool operator()(const sample_parent &a, const sample_parent &b)
+    {
+      return a.uid < b.uid;
+    }
+  };
+
+  template<>
+  struct count_queue_lt<sample_request>
+  {
+    bool operator()(const sample_request &a, const sample_request &b)
+    {
+      return a.uid < b.uid;
+    }
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Bottom-up ordering of counts, i.e. the largest uid first.
+  //////////////////////////////////////////////////////////////////////////////
+  struct sample_count_gt
+  {
+    bool operator()(const sample_count &a, const sample_count &b)
+    {
+      return a.uid > b.uid;
+    }
+  };
+
+  struct sample_choice_lt
+  {
+    bool operator()(const sample_choice &a, const sample_choice &b)
+    {
+      return a.sample < b.sample || (a.sample == b.sample && a.label < b.label);
+    }
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Sweep 1: Transposition
+  template<typename sample_pq_t>
+  void __sample_transpose(const decision_diagram &dd,
+                          simple_file<arc_t> &parents,
+                          const size_t pq_max_memory,
+                          const size_t pq_max_size)
+  {
+    node_stream<> ns(dd);
+    simple_file_writer<arc_t> pw(parents);
+
+    sample_pq_t sample_pq({dd}, pq_max_memory, pq_max_size);
+
+    const auto forward_arcs = [&sample_pq](const node_t &n) {
+      if (is_node(n.low)) { sample_pq.push({ n.low, n.uid }); }
+      if (is_node(n.high)) { sample_pq.push({ n.high, flag(n.uid) }); }
+    };
+
+    forward_arcs(ns.pull());
+
+    while (ns.can_pull()) {
+      const node_t n = ns.pull();
+
+      if (!sample_pq.has_current_level() || sample_pq.current_level() != label_of(n)) {
+        sample_pq.setup_next_level();
+      }
+      adiar_debug(sample_pq.can_pull() && sample_pq.top().uid == n.uid,
+                  "Priority queue is out-of-sync with node stream");
+
+      while (sample_pq.can_pull() && sample_pq.top().uid == n.uid) {
+        pw.unsafe_push({ sample_pq.pull().source, n.uid });
+      }
+
+      forward_arcs(n);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Sweep 2: Counting
+  //
+  // The count of a node is the number of paths (or assignments to the levels
+  // below it, if 'count_skipped') to the true sink. Values are forwarded to
+  // parents with the index of the child's level added, such that the parent
+  // can account for the skipped levels.
+  template<bool count_skipped, typename count_pq_t>
+  void __sample_count(const decision_diagram &dd,
+                      const simple_file<arc_t> &parents,
+                      const std::vector<label_t> &levels,
+                      weight_file &probabilities,
+                      const size_t pq_max_memory,
+                      const size_t pq_max_size)
+  {
+    const log2_arithmetic arith;
+
+    node_stream<true> ns(dd);
+    file_stream<arc_t, true> ps(parents);
+    weight_writer pw(probabilities);
+
+    count_pq_t count_pq(pq_max_memory, pq_max_size);
+
+    const double true_value = count_skipped ? levels.size() : 0.0;
+
+    while (ns.can_pull()) {
+      const node_t n = ns.pull();
+      const size_t level =
+        std::lower_bound(levels.begin(), levels.end(), label_of(n)) - levels.begin();
+
+      double low = is_sink(n.low) ? (value_of(n.low) ? true_value : arith.zero()) : arith.zero();
+      double high = is_sink(n.high) ? (value_of(n.high) ? true_value : arith.zero()) : arith.zero();
+
+      while (!count_pq.empty() && count_pq.top().uid == n.uid) {
+        const sample_count c = count_pq.top();
+        count_pq.pop();
+        (c.high ? high : low) = c.log2_count;
+      }
+
+      if constexpr (count_skipped) {
+        low -= level + 1u;
+        high -= level + 1u;
+      }
+
+      const double count = arith.add(low, high);
+      pw.unsafe_push(std::exp2(high - count));
+
+      const double value = count_skipped ? count + level : count;
+
+      while (ps.can_pull() && ps.peek().target == n.uid) {
+        const arc_t a = ps.pull();
+        count_pq.push({ unflag(a.source), value, is_high(a) });
+      }
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Sweep 3: Sampling
+  template<typename sample_pq_t, typename sorter_t, typename rng_t>
+  void __sample_sweep(const decision_diagram &dd,
+                      const weight_file &probabilities,
+                      const size_t samples,
+                      rng_t &rng,
+                      sorter_t &choices,
+                      const size_t pq_max_memory,
+                      const size_t pq_max_size)
+  {
+    node_stream<> ns(dd);
+    file_stream<double, true> ps(probabilities);
+
+    sample_pq_t sample_pq({dd}, pq_max_memory, pq_max_size);
+
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+
+    const auto choose = [&](const node_t &n, const double p, const size_t sample) {
+      const bool high = coin(rng) < p;
+      choices.push({ sample, label_of(n), high });
+
+      const ptr_t child = high ? n.high : n.low;
+      adiar_debug(!is_false(child), "Should never pick a path to the false sink");
+
+      if (is_node(child)) { sample_pq.push({ child, sample }); }
+    };
+
+    node_t n = ns.pull();
+    double p = ps.pull();
+
+    for (size_t sample = 0u; sample < samples; sample++) {
+      choose(n, p, sample);
+    }
+
+    // Nodes without any requests are skipped
+    while (!sample_pq.empty()) {
+      if (sample_pq.empty_level()) {
+        sample_pq.setup_next_level();
+      }
+
+      const sample_request request = sample_pq.pull();
+
+      while (n.uid < request.uid) {
+        n = ns.pull();
+        p = ps.pull();
+      }
+      adiar_debug(n.uid == request.uid, "Priority queue is out-of-sync with node stream");
+
+      choose(n, p, request.sample);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Output
+  template<bool count_skipped, typename sorter_t, typename rng_t, typename callback_t>
+  void __sample_output(sorter_t &choices,
+                       const std::vector<label_t> &levels,
+                       const size_t samples,
+                       rng_t &rng,
+                       callback_t &&callback)
+  {
+    std::vector<assignment_t> path;
+    path.reserve(levels.size());
+
+    bool has_next = choices.can_pull();
+    sample_choice next = has_next ? choices.pull() : sample_choice();
+
+    for (size_t sample = 0u; sample < samples; sample++) {
+      path.clear();
+
+      for (const label_t label : levels) {
+        if (has_next && next.sample == sample && next.label == label) {
+          path.push_back(create_assignment(label, next.value));
+
+          has_next = choices.can_pull();
+          if (has_next) { next = choices.pull(); }
+        } else if constexpr (count_skipped) {
+          path.push_back(create_assignment(label, rng() & 1u));
+        }
+      }
+      callback(path);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  template<bool count_skipped, typename sorter_t, typename rng_t, typename callback_t>
+  void __sample_paths(const decision_diagram &dd,
+                      const weight_file &probabilities,
+                      const std::vector<label_t> &levels,
+                      const size_t samples,
+                      rng_t &rng,
+                      callback_t &&callback,
+                      const size_t sorter_memory,
+                      const size_t pq_memory)
+  {
+    sorter_t choices(sorter_memory, samples * levels.size(), 2);
+
+    if (samples <= count_priority_queue_t<sample_request>::memory_fits(pq_memory)) {
+      __sample_sweep<count_priority_queue_t<sample_request, internal_sorter, internal_priority_queue>>
+        (dd, probabilities, samples, rng, choices, pq_memory, samples);
+    } else {
+      __sample_sweep<count_priority_queue_t<sample_request, external_sorter, external_priority_queue>>
+        (dd, probabilities, samples, rng, choices, pq_memory, samples);
+    }
+
+    choices.sort();
+    __sample_output<count_skipped>(choices, levels, samples, rng, callback);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Call <tt>callback</tt> with each of the given number of paths to
+  ///          the true sink drawn independently and uniformly at random.
+  ///
+  /// \details As for <tt>enumerate_paths</tt>, the trace of a path is given as
+  ///          the (label, value) of every arc taken in increasing order of the
+  ///          labels.
+  ///
+  /// \param count_skipped Whether every assignment to the levels of the
+  ///                      diagram is equally likely (and the levels skipped by
+  ///                      a path are assigned at random) rather than every path.
+  //////////////////////////////////////////////////////////////////////////////
+  template<bool count_skipped, typename rng_t, typename callback_t>
+  void sample_paths(const decision_diagram &dd,
+                    const size_t samples,
+                    rng_t &rng,
+                    callback_t &&callback)
+  {
+    if (is_sink(dd)) {
+      if (value_of(dd)) {
+        const std::vector<assignment_t> empty;
+        for (size_t sample = 0u; sample < samples; sample++) { callback(empty); }
+      }
+      return;
+    }
+    if (samples == 0u) { return; }
+
+    std::vector<label_t> levels;
+    {
+      level_info_stream<node_t> ls(dd);
+      while (ls.can_pull()) { levels.push_back(label_of(ls.pull())); }
+    }
+
+    const size_t nodes = dd.file_ptr() -> size();
+
+    // Sweep 1
+    simple_file<arc_t> parents;
+    {
+      const size_t max_pq_size = __count_max_cut_upper_bound(dd);
+      const size_t pq_memory = memory::available()
+        - node_stream<>::memory_usage()
+        - simple_file_writer<arc_t>::memory_usage();
+
+      if (max_pq_size <= count_priority_queue_t<sample_parent>::memory_fits(pq_memory)) {
+        __sample_transpose<count_priority_queue_t<sample_parent, internal_sorter, internal_priority_queue>>
+          (dd, parents, pq_memory, max_pq_size);
+      } else {
+        __sample_transpose<count_priority_queue_t<sample_parent, external_sorter, external_priority_queue>>
+          (dd, parents, pq_memory, max_pq_size);
+      }
+    }
+
+    // Sweep 2
+    weight_file probabilities;
+    {
+      // Each arc carries a count at most once
+      const size_t max_pq_size = 2u * nodes;
+      const size_t pq_memory = memory::available()
+        - node_stream<>::memory_usage()
+        - file_stream<arc_t>::memory_usage()
+        - weight_writer::memory_usage();
+
+      if (max_pq_size <= internal_priority_queue<sample_count, sample_count_gt>::memory_fits(pq_memory)) {
+        __sample_count<count_skipped, internal_priority_queue<sample_count, sample_count_gt>>
+          (dd, parents, levels, probabilities, pq_memory, max_pq_size);
+      } else {
+        __sample_count<count_skipped, external_priority_queue<sample_count, sample_count_gt>>
+          (dd, parents, levels, probabilities, pq_memory, max_pq_size);
+      }
+    }
+
+    // Sweep 3 (and output)
+    {
+      const size_t aux_memory = memory::available()
+        - node_stream<>::memory_usage()
+        - file_stream<double>::memory_usage();
+
+      const size_t sorter_memory = aux_memory / 2u;
+      const size_t pq_memory = aux_memory - sorter_memory;
+
+      if (samples * levels.size() <= internal_sorter<sample_choice, sample_choice_lt>::memory_fits(sorter_memory)) {
+        __sample_paths<count_skipped, internal_sorter<sample_choice, sample_choice_lt>>
+          (dd, probabilities, levels, samples, rng, callback, sorter_memory, pq_memory);
+      } else {
+        __sample_paths<count_skipped, external_sorter<sample_choice, sample_choice_lt>>
+          (dd, probabilities, levels, samples, rng, callback, sorter_memory, pq_memory);
+      }
+    }
+  }
+}
+
+#endif // ADIAR_INTERNAL_SAMPLE_H
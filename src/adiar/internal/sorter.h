@@ -5,15 +5,24 @@
 #include <math.h>
 #include <algorithm>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include <tpie/tpie.h>
 #include <tpie/sort.h>
 
 #include <adiar/internal/assert.h>
+#include <adiar/internal/parallel.h>
 
 namespace adiar {
   //////////////////////////////////////////////////////////////////////////////
-  /// \brief Wrapper for TPIE's internal vector with standard quick-sort.
+  /// \brief   Wrapper for TPIE's internal vector with standard quick-sort.
+  ///
+  /// \details If <tt>parallel::get_sorting()</tt> is enabled, then chunks of
+  ///          the vector are sorted on multiple threads instead. These sorted
+  ///          runs are not merged up front; rather, each call to <tt>pull</tt>
+  ///          on the caller's thread picks the smallest of their heads. Only
+  ///          the sorting of the runs is parallel, the merge is not.
   //////////////////////////////////////////////////////////////////////////////
   template <typename T, typename pred_t = std::less<T>>
   class internal_sorter {
@@ -23,6 +32,12 @@ namespace adiar {
     size_t _size;
     size_t _front_idx;
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The remaining [begin, end) of each sorted run (if sorted with
+    ///        multiple threads).
+    ////////////////////////////////////////////////////////////////////////////
+    std::vector<std::pair<size_t, size_t>> _runs;
+
   public:
     static constexpr tpie::memory_size_type unsafe_memory_usage(tpie::memory_size_type no_elements)
     {
@@ -46,6 +61,23 @@ namespace adiar {
 
     static constexpr size_t DATA_STRUCTURES = 1u;
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Minimum amount of memory needed by a single sorter.
+    ////////////////////////////////////////////////////////////////////////////
+    static constexpr tpie::memory_size_type memory_minimum()
+    {
+      return unsafe_memory_usage(1u);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The number of sorters of the given size that fit into memory.
+    ////////////////////////////////////////////////////////////////////////////
+    static constexpr size_t max_sorters(tpie::memory_size_type memory_bytes,
+                                        tpie::memory_size_type no_elements)
+    {
+      return memory_bytes / std::max<tpie::memory_size_type>(memory_usage(no_elements), 1u);
+    }
+
     static std::unique_ptr<internal_sorter<T, pred_t>> make_unique(size_t memory_bytes,
                                                                    size_t no_elements,
                                                                    size_t no_sorters,
@@ -76,8 +108,20 @@ namespace adiar {
 
     void sort()
     {
-      tpie::parallel_sort(_array.begin(), _array.begin() + _size, _pred);
       _front_idx = 0;
+      _runs.clear();
+
+      const size_t runs = parallel::get_sorting() ? parallel::threads_for(_size) : 1u;
+      if (runs <= 1u) {
+        tpie::parallel_sort(_array.begin(), _array.begin() + _size, _pred);
+        return;
+      }
+
+      _runs.resize(runs);
+      parallel::for_each_chunk(_size, runs, [this](size_t run, size_t begin, size_t end) {
+        std::sort(_array.begin() + begin, _array.begin() + end, _pred);
+        _runs[run] = { begin, end };
+      });
     }
 
     bool can_pull()
@@ -87,13 +131,32 @@ namespace adiar {
 
     T pull()
     {
-      return _array[_front_idx++];
+      adiar_debug(can_pull(), "Cannot pull from an empty sorter");
+      _front_idx++;
+
+      if (_runs.empty()) {
+        return _array[_front_idx - 1];
+      }
+
+      // Lazily merge the runs by taking the smallest of their heads, i.e. in
+      // O(runs) time per pulled element.
+      size_t min_run = _runs.size();
+      for (size_t run = 0u; run < _runs.size(); run++) {
+        if (_runs[run].first == _runs[run].second) { continue; }
+
+        if (min_run == _runs.size()
+            || _pred(_array[_runs[run].first], _array[_runs[min_run].first])) {
+          min_run = run;
+        }
+      }
+      return _array[_runs[min_run].first++];
     }
 
     void reset()
     {
       _size = 0;
       _front_idx = 0;
+      _runs.clear();
     }
   };
 
@@ -114,9 +177,35 @@ namespace adiar {
   private:
     tpie::merge_sorter<T, false, pred_t> _sorter;
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Minimum amount of memory for phase 1 and 3 of each sorter.
+    ///
+    /// \remark Quickfix: Issue #250 of thomasmoelhave/tpie
+    ////////////////////////////////////////////////////////////////////////////
+    static constexpr tpie::memory_size_type minimum_phase1 = sizeof(T) * 128 * 1024 + 5 * 1024 * 1024;
+
   public:
     static constexpr size_t DATA_STRUCTURES = 1u;
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Minimum amount of memory needed by a single sorter.
+    ////////////////////////////////////////////////////////////////////////////
+    static constexpr tpie::memory_size_type memory_minimum()
+    {
+      return minimum_phase1;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The number of sorters that fit into memory, i.e. where the phase
+    ///        2 of one of them still has (at least) half of the memory while
+    ///        all others are in phase 1.
+    ////////////////////////////////////////////////////////////////////////////
+    static constexpr size_t max_sorters(tpie::memory_size_type memory_bytes,
+                                        tpie::memory_size_type /*no_elements*/)
+    {
+      return 1u + (memory_bytes / 2u) / minimum_phase1;
+    }
+
     static std::unique_ptr<external_sorter<T, pred_t>> make_unique(size_t memory_bytes,
                                                                    size_t no_elements,
                                                                    size_t no_sorters,
@@ -159,9 +248,6 @@ namespace adiar {
       //       slightly more than the amount of memory necessary to hold all
       //       values simultaneously.
 
-      // Quickfix: Issue #250 of thomasmoelhave/tpie
-      constexpr tpie::memory_size_type minimum_phase1 = sizeof(T) * 128 * 1024 + 5 * 1024 * 1024;
-
       const tpie::memory_size_type maximum_phase1 = (memory_bytes >> 4) / (number_of_sorters - 1);
 
       const tpie::memory_size_type phase1 =
@@ -1,5 +1,5 @@
 #include "substitution.h"
 
 namespace adiar {
-  stats_t::substitute_t stats_substitute;
+  thread_local stats_t::substitute_t stats_substitute;
 }
@@ -16,7 +16,7 @@ namespace adiar
 {
   //////////////////////////////////////////////////////////////////////////////
   /// Struct to hold statistics
-  extern stats_t::substitute_t stats_substitute;
+  extern thread_local stats_t::substitute_t stats_substitute;
 
   //////////////////////////////////////////////////////////////////////////////
   // Priority queue functions
@@ -103,7 +103,7 @@ namespace adiar
     arc_file out_arcs;
     arc_writer aw(out_arcs);
 
-    pq_t substitute_pq({dd}, pq_memory, pq_max_size);
+    pq_t substitute_pq({dd}, pq_memory, pq_max_size, &stats_substitute);
 
     label_t level = label_of(n);
     size_t level_size = 0;
@@ -25,6 +25,28 @@ namespace adiar {
     ptr_t t3;
   };
 
+  inline bool operator== (const tuple &a, const tuple &b)
+  {
+    return a.t1 == b.t1 && a.t2 == b.t2;
+  }
+
+  inline bool operator!= (const tuple &a, const tuple &b)
+  {
+    return !(a == b);
+  }
+
+  inline bool operator== (const tuple_data &a, const tuple_data &b)
+  {
+    return static_cast<const tuple&>(a) == static_cast<const tuple&>(b)
+      && a.data_low == b.data_low && a.data_high == b.data_high;
+  }
+
+  inline bool operator== (const triple &a, const triple &b)
+  {
+    return static_cast<const tuple&>(a) == static_cast<const tuple&>(b)
+      && a.t3 == b.t3;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   // Ordered access
   inline ptr_t fst(const ptr_t t1, const ptr_t t2)
@@ -1,6 +1,9 @@
 #ifndef ADIAR_INTERNAL_UTIL_H
 #define ADIAR_INTERNAL_UTIL_H
 
+#include <algorithm>
+#include <vector>
+
 #include <adiar/data.h>
 
 #include <adiar/file.h>
@@ -50,6 +53,33 @@ namespace adiar
     return vars;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief The given labels in ascending order without duplicates. If they
+  ///        already are so, then the file itself is returned.
+  //////////////////////////////////////////////////////////////////////////////
+  inline label_file sorted_labels(const label_file &labels)
+  {
+    std::vector<label_t> ls;
+    bool is_sorted = true;
+    {
+      label_stream<> s(labels);
+      while (s.can_pull()) {
+        const label_t l = s.pull();
+        is_sorted &= ls.empty() || ls.back() < l;
+        ls.push_back(l);
+      }
+    }
+    if (is_sorted) { return labels; }
+
+    std::sort(ls.begin(), ls.end());
+    ls.erase(std::unique(ls.begin(), ls.end()), ls.end());
+
+    label_file out;
+    label_writer lw(out);
+    for (const label_t l : ls) { lw << l; }
+    return out;
+  }
+
   class bits_approximation
   {
   public:
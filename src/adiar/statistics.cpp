@@ -10,16 +10,24 @@
 #include <adiar/internal/substitution.h>
 #include <adiar/internal/intercut.h>
 #include <adiar/bdd/reorder.h>
+#include <adiar/internal/cache.h>
 
 namespace adiar
 {
-  // Define the available function
-  stats_t adiar_stats()
+  //////////////////////////////////////////////////////////////////////////////
+  // Statistics of the calling thread
+  thread_local std::shared_ptr<__stats_inbox> __stats_current_inbox;
+
+  std::shared_ptr<__stats_inbox> __stats_get_inbox()
   {
-#ifndef ADIAR_STATS
-    std::cerr << "Statistics not gathered. Please compile with 'ADIAR_STATS' or 'ADIAR_STATS_EXTRA'" << std::endl;
-#endif
+    if (!__stats_current_inbox) {
+      __stats_current_inbox = std::make_shared<__stats_inbox>();
+    }
+    return __stats_current_inbox;
+  }
 
+  stats_t __stats_collect()
+  {
     return {
       stats_count,
       stats_equality,
@@ -31,9 +39,130 @@ namespace adiar
       stats_reduce,
       stats_substitute,
       stats_reorder,
+      stats_cache,
     };
   }
 
+  void __stats_load(const stats_t &s)
+  {
+    stats_count = s.count;
+    stats_equality = s.equality;
+    stats_if_else = s.if_else;
+    stats_intercut = s.intercut;
+    stats_priority_queue = s.priority_queue;
+    stats_product_construction = s.product_construction;
+    stats_quantify = s.quantify;
+    stats_reduce = s.reduce;
+    stats_substitute = s.substitute;
+    stats_reorder = s.reorder;
+    stats_cache = s.cache;
+  }
+
+  void __stats_add(memory_t &into, const memory_t &s)
+  {
+    into.lpq_internal += s.lpq_internal;
+    into.lpq_external += s.lpq_external;
+
+    into.lpq_queues += s.lpq_queues;
+    into.lpq_lookahead += s.lpq_lookahead;
+    into.lpq_push_bucket += s.lpq_push_bucket;
+    into.lpq_push_overflow += s.lpq_push_overflow;
+  }
+
+  void __stats_add(stats_t &into, const stats_t &s)
+  {
+    __stats_add(into.count, s.count);
+
+    __stats_add(into.equality, s.equality);
+    into.equality.exit_on_same_file += s.equality.exit_on_same_file;
+    into.equality.exit_on_nodecount += s.equality.exit_on_nodecount;
+    into.equality.exit_on_varcount += s.equality.exit_on_varcount;
+    into.equality.exit_on_sinkcount += s.equality.exit_on_sinkcount;
+    into.equality.exit_on_hash += s.equality.exit_on_hash;
+    into.equality.exit_on_levels_mismatch += s.equality.exit_on_levels_mismatch;
+    into.equality.slow_check.runs += s.equality.slow_check.runs;
+    into.equality.slow_check.exit_on_root += s.equality.slow_check.exit_on_root;
+    into.equality.slow_check.exit_on_processed_on_level += s.equality.slow_check.exit_on_processed_on_level;
+    into.equality.slow_check.exit_on_children += s.equality.slow_check.exit_on_children;
+    into.equality.slow_check.prefetched_runs += s.equality.slow_check.prefetched_runs;
+    into.equality.fast_check.runs += s.equality.fast_check.runs;
+    into.equality.fast_check.exit_on_mismatch += s.equality.fast_check.exit_on_mismatch;
+    into.equality.fast_check.parallel_runs += s.equality.fast_check.parallel_runs;
+
+    __stats_add(into.if_else, s.if_else);
+    __stats_add(into.intercut, s.intercut);
+
+    into.priority_queue.push_bucket += s.priority_queue.push_bucket;
+    into.priority_queue.push_overflow += s.priority_queue.push_overflow;
+    for (size_t idx = 0u; idx <= stats_t::priority_queue_t::MAX_LOOKAHEAD; idx++) {
+      into.priority_queue.lookahead[idx].queues += s.priority_queue.lookahead[idx].queues;
+      into.priority_queue.lookahead[idx].push_bucket += s.priority_queue.lookahead[idx].push_bucket;
+      into.priority_queue.lookahead[idx].push_overflow += s.priority_queue.lookahead[idx].push_overflow;
+    }
+
+    __stats_add(into.product_construction, s.product_construction);
+    into.product_construction.fused_internal += s.product_construction.fused_internal;
+    into.product_construction.fused_spilled += s.product_construction.fused_spilled;
+    into.product_construction.nary_sweeps += s.product_construction.nary_sweeps;
+    into.product_construction.nary_fallbacks += s.product_construction.nary_fallbacks;
+    into.product_construction.relprod_runs += s.product_construction.relprod_runs;
+    into.product_construction.relprod_deferred += s.product_construction.relprod_deferred;
+
+    __stats_add(into.quantify, s.quantify);
+    into.quantify.multi_sweeps += s.quantify.multi_sweeps;
+    into.quantify.multi_fallbacks += s.quantify.multi_fallbacks;
+    into.quantify.multi_deferred += s.quantify.multi_deferred;
+
+    __stats_add(into.reduce, s.reduce);
+    into.reduce.sum_node_arcs += s.reduce.sum_node_arcs;
+    into.reduce.sum_sink_arcs += s.reduce.sum_sink_arcs;
+    into.reduce.parallel_levels += s.reduce.parallel_levels;
+    into.reduce.removed_by_rule_1 += s.reduce.removed_by_rule_1;
+    into.reduce.removed_by_rule_2 += s.reduce.removed_by_rule_2;
+
+    __stats_add(into.substitute, s.substitute);
+
+    __stats_add(into.reorder, s.reorder);
+    into.reorder.less_than_comparisons += s.reorder.less_than_comparisons;
+    into.reorder.expensive_less_than_comparisons += s.reorder.expensive_less_than_comparisons;
+    into.reorder.reverse_path += s.reorder.reverse_path;
+    into.reorder.dual_reverse_path += s.reorder.dual_reverse_path;
+    into.reorder.min_label += s.reorder.min_label;
+    into.reorder.merges += s.reorder.merges;
+
+    into.cache.hits += s.cache.hits;
+    into.cache.misses += s.cache.misses;
+    into.cache.evictions += s.cache.evictions;
+  }
+
+  void __stats_drain(stats_t &into, __stats_inbox &inbox)
+  {
+    std::lock_guard<std::mutex> lock(inbox.mutex);
+    __stats_add(into, inbox.stats);
+    inbox.stats = {};
+  }
+
+  void __stats_sync()
+  {
+    if (!__stats_current_inbox) { return; }
+
+    stats_t s = __stats_collect();
+    __stats_drain(s, *__stats_current_inbox);
+    __stats_load(s);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Define the available function
+  stats_t adiar_stats()
+  {
+#ifndef ADIAR_STATS
+    std::cerr << "Statistics not gathered. Please compile with 'ADIAR_STATS' or 'ADIAR_STATS_EXTRA'" << std::endl;
+#endif
+
+    __stats_sync();
+    return __stats_collect();
+  }
+
   // Helper functions for pretty printing (UNIX)
   std::ostream& bold_on(std::ostream& os)  { return os << "\e[1m"; }
   std::ostream& bold_off(std::ostream& os) { return os << "\e[0m"; }
@@ -43,8 +172,20 @@ namespace adiar
 
   double compute_percent(size_t s, size_t of) { return (static_cast<double>(s) / static_cast<double>(of)) * 100; }
 
+  void print_lookahead(std::ostream &o, const char *name, const memory_t &s)
+  {
+    if (s.lpq_queues == 0u) { return; }
+
+    o << indent << indent << indent << name << indent
+      << s.lpq_queues << " queues, "
+      << static_cast<double>(s.lpq_lookahead) / static_cast<double>(s.lpq_queues) << " level(s) on average, "
+      << compute_percent(s.lpq_push_bucket, s.lpq_push_bucket + s.lpq_push_overflow) << percent << " to bucket" << endl;
+  }
+
   void adiar_printstat(std::ostream &o)
   {
+    __stats_sync();
+
     o << bold_on << "Adiar statistics" << bold_off << endl;
     o << endl;
 #ifndef ADIAR_STATS
@@ -57,6 +198,7 @@ namespace adiar
     o << indent << indent << "node count              " << indent << stats_equality.exit_on_nodecount << endl;
     o << indent << indent << "var count               " << indent << stats_equality.exit_on_varcount << endl;
     o << indent << indent << "sink count              " << indent << stats_equality.exit_on_sinkcount << endl;
+    o << indent << indent << "hash                    " << indent << stats_equality.exit_on_hash << endl;
     o << indent << indent << "levels mismatch         " << indent << stats_equality.exit_on_levels_mismatch << endl;
     o << endl;
     o << indent << indent << "O(sort(N)) algorithm    " << endl;
@@ -64,10 +206,39 @@ namespace adiar
     o << indent << indent << indent << "root                    " << stats_equality.slow_check.exit_on_root << endl;
     o << indent << indent << indent << "requests on a level     " << stats_equality.slow_check.exit_on_processed_on_level << endl;
     o << indent << indent << indent << "child violation         " << stats_equality.slow_check.exit_on_children << endl;
+    o << indent << indent << indent << "prefetched inputs       " << stats_equality.slow_check.prefetched_runs << endl;
     o << endl;
     o << indent << indent << "O(N/B) algorithm" << endl;
     o << indent << indent << indent << "runs                    " << stats_equality.fast_check.runs << endl;
     o << indent << indent << indent << "node mismatch           " << stats_equality.fast_check.exit_on_mismatch << endl;
+    o << indent << indent << indent << "multi-threaded          " << stats_equality.fast_check.parallel_runs << endl;
+    o << endl;
+
+    size_t total_fused = stats_product_construction.fused_internal + stats_product_construction.fused_spilled;
+    o << indent << bold_on << "Product construction" << bold_off << endl;
+    o << indent << indent << "output in memory        " << indent << stats_product_construction.fused_internal
+      << " = " << compute_percent(stats_product_construction.fused_internal, total_fused) << percent << endl;
+    o << indent << indent << "output spilled to disk  " << indent << stats_product_construction.fused_spilled
+      << " = " << compute_percent(stats_product_construction.fused_spilled, total_fused) << percent << endl;
+    o << indent << indent << "n-ary sweeps            " << indent << stats_product_construction.nary_sweeps << endl;
+    o << indent << indent << "n-ary fallbacks         " << indent << stats_product_construction.nary_fallbacks << endl;
+    o << indent << indent << "relational products     " << indent << stats_product_construction.relprod_runs << endl;
+    o << indent << indent << "deferred quantification " << indent << stats_product_construction.relprod_deferred << endl;
+    o << endl;
+
+    o << indent << bold_on << "Quantification" << bold_off << endl;
+    o << indent << indent << "multi-variable sweeps   " << indent << stats_quantify.multi_sweeps << endl;
+    o << indent << indent << "per-variable fallbacks  " << indent << stats_quantify.multi_fallbacks << endl;
+    o << indent << indent << "deferred levels         " << indent << stats_quantify.multi_deferred << endl;
+    o << endl;
+
+    size_t total_lookups = stats_cache.hits + stats_cache.misses;
+    o << indent << bold_on << "Cache" << bold_off << endl;
+    o << indent << indent << "hits                    " << indent << stats_cache.hits
+      << " = " << compute_percent(stats_cache.hits, total_lookups) << percent << endl;
+    o << indent << indent << "misses                  " << indent << stats_cache.misses
+      << " = " << compute_percent(stats_cache.misses, total_lookups) << percent << endl;
+    o << indent << indent << "evictions               " << indent << stats_cache.evictions << endl;
     o << endl;
 
 #ifdef ADIAR_STATS_EXTRA
@@ -78,6 +249,28 @@ namespace adiar
       << " = " << compute_percent(stats_priority_queue.push_bucket, total_pushes) << percent << endl;
     o << indent << indent << "pushes to overflow      " << indent << stats_priority_queue.push_overflow
       << " = " << compute_percent(stats_priority_queue.push_overflow, total_pushes) << percent << endl;
+
+    o << indent << indent << "per look-ahead" << endl;
+    for (size_t lookahead = 0u; lookahead <= stats_t::priority_queue_t::MAX_LOOKAHEAD; lookahead++) {
+      const stats_t::priority_queue_t::lookahead_t &l = stats_priority_queue.lookahead[lookahead];
+      if (l.queues == 0u) { continue; }
+
+      const bool last = lookahead == stats_t::priority_queue_t::MAX_LOOKAHEAD;
+      o << indent << indent << indent << lookahead << (last ? "+" : " ") << " level(s):          " << indent
+        << l.queues << " queues, "
+        << compute_percent(l.push_bucket, l.push_bucket + l.push_overflow) << percent << " to bucket" << endl;
+    }
+
+    o << indent << indent << "per algorithm" << endl;
+    print_lookahead(o, "Count               ", stats_count);
+    print_lookahead(o, "Equality checking   ", stats_equality);
+    print_lookahead(o, "If-Then-Else        ", stats_if_else);
+    print_lookahead(o, "Intercut            ", stats_intercut);
+    print_lookahead(o, "Product construction", stats_product_construction);
+    print_lookahead(o, "Quantification      ", stats_quantify);
+    print_lookahead(o, "Reduce              ", stats_reduce);
+    print_lookahead(o, "Substitution        ", stats_substitute);
+    print_lookahead(o, "Reordering          ", stats_reorder);
     o << endl;
 
 #endif
@@ -92,6 +285,8 @@ namespace adiar
     o << indent << indent << indent << "sink arcs:            " << indent
       << stats_reduce.sum_sink_arcs << " = " << compute_percent(stats_reduce.sum_sink_arcs, total_arcs) << percent << endl;
 
+    o << indent << indent << "levels (multi-threaded) " << indent << stats_reduce.parallel_levels << endl;
+
 #ifdef ADIAR_STATS_EXTRA
     size_t total_removed = stats_reduce.removed_by_rule_1 + stats_reduce.removed_by_rule_2;
     o << indent << indent << "nodes removed           " << indent
@@ -180,6 +375,11 @@ namespace adiar
 
   void adiar_statsreset()
   {
+    if (__stats_current_inbox) {
+      std::lock_guard<std::mutex> lock(__stats_current_inbox -> mutex);
+      __stats_current_inbox -> stats = {};
+    }
+
     stats_count = {};
     stats_equality = {};
     stats_if_else = {};
@@ -190,5 +390,6 @@ namespace adiar
     stats_reduce = {};
     stats_substitute = {};
     stats_reorder = {};
+    stats_cache = {};
   }
 }
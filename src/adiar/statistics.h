@@ -3,6 +3,9 @@
 
 #include <iostream>
 #include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace adiar
 {
@@ -11,6 +14,14 @@ namespace adiar
   {
     size_t lpq_internal = 0;
     size_t lpq_external = 0;
+
+    // Number of levelized priority queues, the sum of their look-ahead, and
+    // whether their elements were pushed to a bucket or to the overflow queue
+    // (ADIAR_STATS_EXTRA)
+    size_t lpq_queues = 0;
+    size_t lpq_lookahead = 0;
+    size_t lpq_push_bucket = 0;
+    size_t lpq_push_overflow = 0;
   };
 
   //////////////////////////////////////////////////////////////////////////////
@@ -38,6 +49,7 @@ namespace adiar
       size_t exit_on_nodecount = 0;
       size_t exit_on_varcount = 0;
       size_t exit_on_sinkcount = 0;
+      size_t exit_on_hash = 0;
       size_t exit_on_levels_mismatch = 0;
 
       // Statistics on non-trivial cases
@@ -47,12 +59,18 @@ namespace adiar
         size_t exit_on_root = 0;
         size_t exit_on_processed_on_level = 0;
         size_t exit_on_children = 0;
+
+        // Runs with the inputs read on separate threads
+        size_t prefetched_runs = 0;
       } slow_check;
 
       struct fast_t
       {
         size_t runs = 0;
         size_t exit_on_mismatch = 0;
+
+        // Runs split into level ranges compared on separate threads
+        size_t parallel_runs = 0;
       } fast_check;
     } equality;
 
@@ -64,20 +82,61 @@ namespace adiar
     struct intercut_t : public memory_t
     { } intercut;
 
-    // Levelized Priority Queue (ADIAR_STATS_EXTRA)
+    // Levelized Priority Queue, aggregated over all algorithms (ADIAR_STATS_EXTRA)
     struct priority_queue_t
     {
       size_t push_bucket = 0;
       size_t push_overflow = 0;
+
+      // Look-ahead and pushes of a single priority queue, i.e. of an operation.
+      struct queue_t
+      {
+        size_t lookahead = 0;
+        size_t push_bucket = 0;
+        size_t push_overflow = 0;
+      };
+
+      // Number of priority queues and their pushes for each look-ahead. The
+      // last entry also includes all priority queues with a larger one.
+      static constexpr size_t MAX_LOOKAHEAD = 16;
+
+      struct lookahead_t
+      {
+        size_t queues = 0;
+        size_t push_bucket = 0;
+        size_t push_overflow = 0;
+      } lookahead[MAX_LOOKAHEAD + 1];
     } priority_queue;
 
     // Product construction
     struct product_construction_t : public memory_t
-    { } product_construction;
+    {
+      // Whether the unreduced output could be kept in internal memory for the
+      // subsequent Reduce (ADIAR_STATS)
+      size_t fused_internal = 0;
+      size_t fused_spilled = 0;
+
+      // Whether many operands were combined in one sweep or the sweep had to
+      // fall back to a balanced tree of smaller products (ADIAR_STATS)
+      size_t nary_sweeps = 0;
+      size_t nary_fallbacks = 0;
+
+      // Relational products computed in a single sweep and the number of
+      // levels that could not be quantified within it (ADIAR_STATS)
+      size_t relprod_runs = 0;
+      size_t relprod_deferred = 0;
+    } product_construction;
 
     // Quantification
     struct quantify_t : public memory_t
-    { } quantify;
+    {
+      // Whether multiple variables were quantified in one sweep or it had to
+      // fall back to one sweep per variable, and the number of levels that
+      // could not be quantified within the sweep (ADIAR_STATS)
+      size_t multi_sweeps = 0;
+      size_t multi_fallbacks = 0;
+      size_t multi_deferred = 0;
+    } quantify;
 
     // Reduce
     struct reduce_t : public memory_t
@@ -85,6 +144,7 @@ namespace adiar
       // (ADIAR_STATS)
       size_t sum_node_arcs = 0;
       size_t sum_sink_arcs = 0;
+      size_t parallel_levels = 0;
 
       // (ADIAR_STATS_EXTRA)
       size_t removed_by_rule_1 = 0;
@@ -105,10 +165,20 @@ namespace adiar
       size_t min_label = 0;
       size_t merges = 0;
     } reorder;
+
+    // Computed-table cache of top-level operations (ADIAR_STATS)
+    struct cache_t
+    {
+      size_t hits = 0;
+      size_t misses = 0;
+      size_t evictions = 0;
+    } cache;
   };
 
   //////////////////////////////////////////////////////////////////////////////
-  /// \brief Obtain a copy of all statistics gathered.
+  /// \brief Obtain a copy of all statistics gathered (on the calling thread
+  ///        outside of any <tt>adiar_context</tt>). This includes the ones of
+  ///        asynchronous operations it has submitted that are done.
   ///
   /// \copydoc stats_t
   //////////////////////////////////////////////////////////////////////////////
@@ -125,6 +195,54 @@ namespace adiar
   /// \brief Resets all statistics to default value.
   //////////////////////////////////////////////////////////////////////////////
   void adiar_statsreset();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Statistics gathered on other threads on behalf of a thread (or of
+  ///          an <tt>adiar_context</tt>) that are yet to be added to its own.
+  ///
+  /// \details Other threads add to it when they are done; its owner adds its
+  ///          content to its own statistics whenever they are read.
+  //////////////////////////////////////////////////////////////////////////////
+  struct __stats_inbox
+  {
+    std::mutex mutex;
+    stats_t stats;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief The inbox of the calling thread (or of the context it runs in).
+  //////////////////////////////////////////////////////////////////////////////
+  extern thread_local std::shared_ptr<__stats_inbox> __stats_current_inbox;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief The inbox of the calling thread, which is created if it has none.
+  //////////////////////////////////////////////////////////////////////////////
+  std::shared_ptr<__stats_inbox> __stats_get_inbox();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Add all values of <tt>s</tt> to the ones of <tt>into</tt>.
+  //////////////////////////////////////////////////////////////////////////////
+  void __stats_add(stats_t &into, const stats_t &s);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Move the content of <tt>inbox</tt> into <tt>into</tt>.
+  //////////////////////////////////////////////////////////////////////////////
+  void __stats_drain(stats_t &into, __stats_inbox &inbox);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief The statistics of the calling thread.
+  //////////////////////////////////////////////////////////////////////////////
+  stats_t __stats_collect();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Overwrite the statistics of the calling thread.
+  //////////////////////////////////////////////////////////////////////////////
+  void __stats_load(const stats_t &s);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief Add the content of the calling thread's inbox to its statistics.
+  //////////////////////////////////////////////////////////////////////////////
+  void __stats_sync();
 }
 
 #endif // ADIAR_STATISTICS_H
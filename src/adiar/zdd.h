@@ -1,8 +1,11 @@
 #ifndef ADIAR_ZDD_H
 #define ADIAR_ZDD_H
 
+#include <functional>
 #include <optional>
+#include <random>
 #include <string>
+#include <vector>
 
 #include <adiar/data.h>
 #include <adiar/file.h>
@@ -108,6 +111,18 @@ namespace adiar
   __zdd operator| (const zdd &, __zdd &&);
   __zdd operator| (__zdd &&, const zdd &);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief    The union of many families of sets.
+  ///
+  /// \details  Up to 64 ZDDs are combined in a single sweep, if it fits into
+  ///           memory. Otherwise, they are split into a balanced tree of
+  ///           smaller products.
+  ///
+  /// \returns
+  /// \f$ \bigcup_{A \in \mathit{As}} A \f$
+  //////////////////////////////////////////////////////////////////////////////
+  __zdd zdd_union(const std::vector<zdd> &As);
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief   The intersection of two families of sets.
   ///
@@ -122,6 +137,22 @@ namespace adiar
   __zdd operator& (const zdd &, __zdd &&);
   __zdd operator& (__zdd &&, const __zdd &);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief    The intersection of many families of sets.
+  ///
+  /// \details  Up to 64 ZDDs are combined in a single sweep, if it fits into
+  ///           memory. Otherwise, they are split into a balanced tree of
+  ///           smaller products.
+  ///
+  /// \returns
+  /// \f$ \bigcap_{A \in \mathit{As}} A \f$
+  ///
+  /// \throws std::invalid_argument If <tt>As</tt> is empty, since the
+  ///         intersection of no families of sets (i.e. the set of all sets) is
+  ///         not defined without a domain.
+  //////////////////////////////////////////////////////////////////////////////
+  __zdd zdd_intsec(const std::vector<zdd> &As);
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief   The set difference of two families of sets.
   ///
@@ -256,6 +287,16 @@ namespace adiar
   bool operator!= (const zdd &, __zdd &&);
   bool operator!= (__zdd &&, const zdd &);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief A hash of the family, i.e. if A and B are the same family then
+  ///        zdd_hash(A) == zdd_hash(B).
+  ///
+  /// \details The hash is derived bottom-up while the ZDD is constructed, so
+  ///          this takes constant time. The converse does not hold: two
+  ///          different families may (rarely) have the same hash.
+  //////////////////////////////////////////////////////////////////////////////
+  uint64_t zdd_hash(const zdd &A);
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief Whether one family is a subset or equal to the other.
   //////////////////////////////////////////////////////////////////////////////
@@ -311,6 +352,29 @@ namespace adiar
   //////////////////////////////////////////////////////////////////////////////
   uint64_t zdd_size(const zdd &A);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief The (base 2) logarithm of the number of sets in the family of
+  ///        sets, i.e. negative infinity for the empty family.
+  //////////////////////////////////////////////////////////////////////////////
+  double zdd_sizeln(const zdd &A);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief The number of sets in the family of sets modulo the given
+  ///        (positive) number.
+  ///
+  /// \throws std::invalid_argument If <tt>modulus</tt> is 0.
+  //////////////////////////////////////////////////////////////////////////////
+  uint64_t zdd_size_mod(const zdd &A, uint64_t modulus);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief  The exact number of sets in the family of sets in decimal.
+  ///
+  /// \throws std::overflow_error If A has more than 65535 levels or if the
+  ///         numbers needed are too large for the priority queue to fit into
+  ///         memory.
+  //////////////////////////////////////////////////////////////////////////////
+  std::string zdd_size_str(const zdd &A);
+
   /* =========================== ZDD SET ELEMENTS =========================== */
 
   //////////////////////////////////////////////////////////////////////////////
@@ -338,6 +402,45 @@ namespace adiar
   //////////////////////////////////////////////////////////////////////////////
   std::optional<label_file> zdd_maxelem(const zdd &A);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief A batch of sets, each given as its labels in ascending order.
+  //////////////////////////////////////////////////////////////////////////////
+  typedef std::vector<std::vector<label_t>> label_batch;
+
+  typedef std::function<void(const label_batch&)> label_batch_func;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Enumerate all sets a in A.
+  ///
+  /// \details The ZDD is walked depth-first with a stack of at most one entry
+  ///          per level and random access into its nodes, such that only the
+  ///          current batch of sets is kept in internal memory.
+  ///
+  /// \param cb         Callback, which is given the sets in batches.
+  ///
+  /// \param batch_size Maximum number of sets in a batch.
+  //////////////////////////////////////////////////////////////////////////////
+  void zdd_allelem(const zdd &A, const label_batch_func &cb, size_t batch_size = 1024u);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief   Draw k sets a in A independently and uniformly at random.
+  ///
+  /// \details The number of sets below each node is derived in a single
+  ///          bottom-up sweep, after which all k samples are drawn together in
+  ///          a single top-down sweep. This takes O(sort(N + k L)) I/Os.
+  ///
+  /// \param k          Number of samples.
+  ///
+  /// \param rng        Source of randomness.
+  ///
+  /// \param cb         Callback, which is given the sets in batches. If A is
+  ///                   empty, then it is never called.
+  ///
+  /// \param batch_size Maximum number of sets in a batch.
+  //////////////////////////////////////////////////////////////////////////////
+  void zdd_sample(const zdd &A, size_t k, std::mt19937_64 &rng,
+                  const label_batch_func &cb, size_t batch_size = 1024u);
+
   //////////////////////////////////////////////////////////////////////////////
   /// \brief    Get the labels of the levels of the ZDD
   //////////////////////////////////////////////////////////////////////////////
@@ -358,6 +461,42 @@ namespace adiar
   //////////////////////////////////////////////////////////////////////////////
   __zdd zdd_from(const bdd &f, const label_file &dom);
 
+  /* ============================== PERSISTENCE ============================= */
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief          Store a ZDD persistently on disk.
+  ///
+  /// \param A        The ZDD to store
+  ///
+  /// \param filename Path for the header of the stored ZDD. Its nodes and
+  ///                 levels are stored in files next to it with the same name
+  ///                 but different suffixes. The file must not already exist.
+  ///
+  /// \throws std::invalid_argument If <tt>filename</tt> already exists.
+  ///
+  /// \sa zdd_load
+  //////////////////////////////////////////////////////////////////////////////
+  void zdd_save(const zdd &A, const std::string &filename);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// \brief          Reopen a ZDD previously stored with <tt>zdd_save</tt>.
+  ///
+  /// \param filename Path for the header of the stored ZDD
+  ///
+  /// \details        The stored files are used as they are, i.e. nothing is
+  ///                 copied and the files are left on disk when the ZDD is
+  ///                 garbage collected.
+  ///
+  /// \throws std::invalid_argument If <tt>filename</tt> does not exist.
+  ///
+  /// \throws std::runtime_error    If <tt>filename</tt> is not a ZDD stored by
+  ///                               this version of Adiar, or if its nodes or
+  ///                               levels files are missing or do not match it.
+  ///
+  /// \sa zdd_save
+  //////////////////////////////////////////////////////////////////////////////
+  zdd zdd_load(const std::string &filename);
+
   /* ================================= DEBUG ================================ */
 
   //////////////////////////////////////////////////////////////////////////////
@@ -1,15 +1,20 @@
 #include <adiar/zdd.h>
+
+#include <stdexcept>
+
 #include <adiar/zdd/zdd_policy.h>
 
 #include <adiar/file_stream.h>
 
-#include <adiar/internal/assert.h>
+#include <adiar/internal/cache.h>
+#include <adiar/internal/nary_product_construction.h>
 #include <adiar/internal/product_construction.h>
 #include <adiar/internal/tuple.h>
 
 namespace adiar
 {
-  bool can_right_shortcut_zdd(const bool_op &op, const ptr_t sink)
+  template<typename op_t>
+  inline bool can_right_shortcut_zdd(const op_t &op, const ptr_t sink)
   {
     ptr_t sink_F = create_sink_ptr(false);
     ptr_t sink_T = create_sink_ptr(true);
@@ -20,7 +25,8 @@ namespace adiar
       && op(sink_F, sink_F) == sink_F && op(sink_T,  sink_F) == sink_F;
   }
 
-  bool can_left_shortcut_zdd(const bool_op &op, const ptr_t sink)
+  template<typename op_t>
+  inline bool can_left_shortcut_zdd(const op_t &op, const ptr_t sink)
   {
     ptr_t sink_F = create_sink_ptr(false);
     ptr_t sink_T = create_sink_ptr(true);
@@ -31,7 +37,8 @@ namespace adiar
       && op(sink_F, sink_F) == sink_F && op(sink_F,  sink_T) == sink_F;
   }
 
-  bool zdd_skippable(const bool_op &op, ptr_t high1, ptr_t high2)
+  template<typename op_t>
+  inline bool zdd_skippable(const op_t &op, ptr_t high1, ptr_t high2)
   {
     return (is_sink(high1) && is_sink(high2)
             && op(high1, high2) == create_sink_ptr(false))
@@ -60,9 +67,10 @@ namespace adiar
     }
 
   public:
+    template<typename op_t>
     static __zdd resolve_sink_root(const node_t &v1, const zdd& zdd_1,
                                    const node_t &v2, const zdd& zdd_2,
-                                   const bool_op &op)
+                                   const op_t &op)
     {
       ptr_t sink_F = create_sink_ptr(false);
 
@@ -90,20 +98,23 @@ namespace adiar
     }
 
   public:
-    static size_t left_leaves(const bool_op &op)
+    template<typename op_t>
+    static size_t left_leaves(const op_t &op)
     {
       return !can_left_shortcut_zdd(op, create_sink_ptr(false)) +
              !can_left_shortcut_zdd(op, create_sink_ptr(true));
     }
 
-    static size_t right_leaves(const bool_op &op)
+    template<typename op_t>
+    static size_t right_leaves(const op_t &op)
     {
       return !can_right_shortcut_zdd(op, create_sink_ptr(false)) +
              !can_right_shortcut_zdd(op, create_sink_ptr(true));
     }
 
   private:
-    static tuple __resolve_request(const bool_op &op, ptr_t r1, ptr_t r2)
+    template<typename op_t>
+    static tuple __resolve_request(const op_t &op, ptr_t r1, ptr_t r2)
     {
       if (is_sink(r1) && can_left_shortcut_zdd(op, r1)) {
         return { r1, create_sink_ptr(true) };
@@ -115,7 +126,8 @@ namespace adiar
     }
 
   public:
-    static prod_rec resolve_request(const bool_op &op,
+    template<typename op_t>
+    static prod_rec resolve_request(const op_t &op,
                                     ptr_t low1, ptr_t low2, ptr_t high1, ptr_t high2)
     {
       // Skip node, if it would be removed in the following Reduce
@@ -135,6 +147,49 @@ namespace adiar
   //////////////////////////////////////////////////////////////////////////////
   __zdd zdd_binop(const zdd &A, const zdd &B, const bool_op &op)
   {
-    return product_construction<zdd_prod_policy>(A, B, op);
+    return cache::memoize<zdd, __zdd>(cache::key_of(cache::operation::ZDD_BINOP, A, B, op), [&]() {
+      return product_construction<zdd_prod_policy>(A, B, op);
+    });
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // ZDD n-ary product construction policy
+  class zdd_nary_policy : public zdd_policy
+  {
+  public:
+    static bool is_absorbing(const bool_op &op, const ptr_t sink)
+    {
+      return can_left_shortcut_zdd(op, sink);
+    }
+
+    static bool is_neutral(const bool_op &op, const ptr_t sink)
+    {
+      return is_left_irrelevant(op, sink) && is_left_irrelevant(op, create_sink_ptr(false));
+    }
+
+  public:
+    static __zdd resolve_empty(const bool_op &op)
+    {
+      if (!is_neutral(op, create_sink_ptr(false))) {
+        throw std::invalid_argument("Operator has no result on zero families of sets");
+      }
+      return zdd_sink(false);
+    }
+
+    static __zdd resolve_binary(const zdd &A, const zdd &B, const bool_op &op)
+    {
+      return zdd_binop(A, B, op);
+    }
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  __zdd zdd_union(const std::vector<zdd> &As)
+  {
+    return nary_product_construction<zdd_nary_policy>(As, or_op);
+  }
+
+  __zdd zdd_intsec(const std::vector<zdd> &As)
+  {
+    return nary_product_construction<zdd_nary_policy>(As, and_op);
   }
 }
@@ -1,5 +1,7 @@
 #include <adiar/zdd.h>
 
+#include <stdexcept>
+
 #include <adiar/data.h>
 
 #include <adiar/internal/assert.h>
@@ -17,10 +19,36 @@ namespace adiar
     return varcount(zdd.file);
   }
 
+  template<typename arith_t>
+  typename arith_t::value_t __zdd_size(const zdd &zdd, const arith_t &arith)
+  {
+    if (is_sink(zdd)) {
+      return value_of(zdd) ? arith.one() : arith.zero();
+    }
+    return count<path_count_policy<arith_t>>(zdd, zdd_varcount(zdd), arith);
+  }
+
   uint64_t zdd_size(const zdd &zdd)
   {
-    return is_sink(zdd)
-      ? value_of(zdd)
-      : count<path_count_policy>(zdd, zdd_varcount(zdd));
+    return __zdd_size(zdd, uint64_arithmetic());
+  }
+
+  double zdd_sizeln(const zdd &zdd)
+  {
+    return __zdd_size(zdd, log2_arithmetic());
+  }
+
+  uint64_t zdd_size_mod(const zdd &zdd, uint64_t modulus)
+  {
+    if (modulus == 0u) { throw std::invalid_argument("Cannot count modulo 0"); }
+    return __zdd_size(zdd, modular_arithmetic { modulus });
+  }
+
+  std::string zdd_size_str(const zdd &zdd)
+  {
+    // Each set is a path, that visits every level at most once.
+    return big_uint_dispatch(zdd_varcount(zdd) + 1u, [&zdd](const auto &arith) {
+      return __zdd_size(zdd, arith).to_string();
+    });
   }
 }
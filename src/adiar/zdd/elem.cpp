@@ -6,6 +6,8 @@
 #include <adiar/file_stream.h>
 #include <adiar/file_writer.h>
 
+#include <adiar/internal/enumerate.h>
+#include <adiar/internal/sample.h>
 #include <adiar/internal/traverse.h>
 
 namespace adiar
@@ -79,4 +81,32 @@ namespace adiar
     traverse(A, v);
     return v.get_result();
   }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// The set of a path, i.e. the labels where the high arc was taken.
+  inline void __zdd_elem(std::vector<label_t> &a, const std::vector<assignment_t> &path)
+  {
+    for (const assignment_t &x : path) {
+      if (x.value) { a.push_back(label_of(x)); }
+    }
+  }
+
+  void zdd_allelem(const zdd &A, const label_batch_func &cb, size_t batch_size)
+  {
+    enumerate_batch<label_t> batch(cb, batch_size);
+    enumerate_paths<false>(A, [&batch](const std::vector<assignment_t> &path) {
+      __zdd_elem(batch.next(), path);
+    });
+    batch.flush();
+  }
+
+  void zdd_sample(const zdd &A, size_t k, std::mt19937_64 &rng,
+                  const label_batch_func &cb, size_t batch_size)
+  {
+    enumerate_batch<label_t> batch(cb, batch_size);
+    sample_paths<false>(A, k, rng, [&batch](const std::vector<assignment_t> &path) {
+      __zdd_elem(batch.next(), path);
+    });
+    batch.flush();
+  }
 }
@@ -10,6 +10,11 @@ namespace adiar {
     return is_isomorphic(s2, s1);
   }
 
+  uint64_t zdd_hash(const zdd &A)
+  {
+    return hash_of(A);
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   class ignore_levels
   {
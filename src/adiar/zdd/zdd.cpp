@@ -10,6 +10,7 @@
 #include <adiar/internal/convert.h>
 #include <adiar/internal/dot.h>
 #include <adiar/internal/intercut.h>
+#include <adiar/internal/io.h>
 #include <adiar/internal/reduce.h>
 #include <adiar/internal/util.h>
 
@@ -167,6 +168,18 @@ namespace adiar {
     return intercut<convert_decision_diagram_policy<zdd_policy, bdd_policy>>(f, dom);
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  // Persistence
+  void zdd_save(const zdd &A, const std::string &filename)
+  {
+    save(A, filename);
+  }
+
+  zdd zdd_load(const std::string &filename)
+  {
+    return zdd(load(filename));
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   // Debug
   void output_dot(const zdd &A, const std::string &file_name)
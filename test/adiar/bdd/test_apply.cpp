@@ -1,4 +1,5 @@
 #include <adiar/adiar.h>
+#include <adiar/internal/nary_product_construction.h>
 
 go_bandit([]() {
   describe("adiar/bdd/apply.cpp", []() {
@@ -345,6 +346,21 @@ go_bandit([]() {
         AssertThat(out.get<arc_file>()._file_ptr->number_of_sinks[1], Is().EqualTo(4u));
       });
 
+      it("should keep the (small) unreduced output in internal memory", [&]() {
+        const size_t threshold = memory::get_internal_file_threshold();
+        memory::set_internal_file_threshold(0u);
+
+        __bdd out = bdd_and(bdd_1, bdd_2);
+
+        memory::set_internal_file_threshold(threshold);
+
+        AssertThat(out.get<arc_file>()._file_ptr->is_on_disk(), Is().False());
+        AssertThat(out.get<arc_file>().size(), Is().EqualTo(16u));
+
+        bdd reduced = out;
+        AssertThat(bdd_nodecount(reduced), Is().EqualTo(8u));
+      });
+
       it("should return input on being given the same BDD twice", [&]() {
         __bdd out = bdd_and(bdd_1, bdd_1);
 
@@ -1292,6 +1308,113 @@ go_bandit([]() {
       });
     });
 
+    describe("bdd_and(fs)", [&]() {
+      it("should resolve no BDDs to the true sink", [&]() {
+        bdd out = bdd_and(std::vector<bdd> { });
+        AssertThat(out == bdd_true(), Is().True());
+      });
+
+      it("should return a single BDD as is", [&]() {
+        __bdd out = bdd_and(std::vector<bdd> { bdd_x0 });
+        AssertThat(out.get<node_file>()._file_ptr, Is().EqualTo(bdd_x0._file_ptr));
+      });
+
+      it("should shortcut on an F sink", [&]() {
+        bdd out = bdd_and(std::vector<bdd> { bdd_x0, bdd_F, bdd_x1 });
+        AssertThat(out == bdd_false(), Is().True());
+      });
+
+      it("should ignore T sinks", [&]() {
+        bdd out = bdd_and(std::vector<bdd> { bdd_T, bdd_x0, bdd_T, bdd_x1 });
+        AssertThat(out == bdd_and(bdd_x0, bdd_x1), Is().True());
+      });
+
+      it("should compute x0 /\\ !x0 /\\ x1 in one sweep", [&]() {
+        bdd out = bdd_and(std::vector<bdd> { bdd_x0, bdd_not_x0, bdd_x1 });
+        AssertThat(out == bdd_false(), Is().True());
+      });
+
+      it("should compute BDD 1 /\\ [2] /\\ x1 in one sweep", [&]() {
+        bdd expected = bdd_and(bdd_and(bdd_1, bdd_2), bdd_x1);
+
+        bdd out = bdd_and(std::vector<bdd> { bdd_1, bdd_2, bdd_x1 });
+        AssertThat(out == expected, Is().True());
+      });
+
+      it("should compute with negated BDDs", [&]() {
+        bdd expected = bdd_and(bdd_and(bdd_not(bdd_1), bdd_2), bdd_not(bdd_x2));
+
+        bdd out = bdd_and(std::vector<bdd> { bdd_not(bdd_1), bdd_2, bdd_not(bdd_x2) });
+        AssertThat(out == expected, Is().True());
+      });
+
+      it("should compute with a tuple wider than the narrowest one", [&]() {
+        std::vector<bdd> fs;
+        bdd expected = bdd_true();
+
+        for (label_t var = 0; var < NARY_MIN_OPERANDS + 1u; var++) {
+          bdd f = bdd_or(bdd_ithvar(var), bdd_nithvar(var+1));
+          fs.push_back(f);
+          expected = bdd_and(expected, f);
+        }
+
+        bdd out = bdd_and(fs);
+        AssertThat(out == expected, Is().True());
+      });
+
+      it("should combine more BDDs than fit in one sweep", [&]() {
+        std::vector<bdd> fs;
+        bdd expected = bdd_true();
+
+        for (label_t var = 0; var < 3u * NARY_MAX_OPERANDS; var++) {
+          bdd f = var % 2 ? bdd_ithvar(var) : bdd_nithvar(var);
+          fs.push_back(f);
+          expected = bdd_and(expected, f);
+        }
+
+        bdd out = bdd_and(fs);
+        AssertThat(out == expected, Is().True());
+      });
+    });
+
+    describe("bdd_or(fs)", [&]() {
+      it("should resolve no BDDs to the false sink", [&]() {
+        bdd out = bdd_or(std::vector<bdd> { });
+        AssertThat(out == bdd_false(), Is().True());
+      });
+
+      it("should shortcut on a T sink", [&]() {
+        bdd out = bdd_or(std::vector<bdd> { bdd_x0, bdd_x1, bdd_T });
+        AssertThat(out == bdd_true(), Is().True());
+      });
+
+      it("should compute x0 \\/ !x0 \\/ x1 in one sweep", [&]() {
+        bdd out = bdd_or(std::vector<bdd> { bdd_x0, bdd_not_x0, bdd_x1 });
+        AssertThat(out == bdd_true(), Is().True());
+      });
+
+      it("should compute BDD 1 \\/ [2] \\/ x2 in one sweep", [&]() {
+        bdd expected = bdd_or(bdd_or(bdd_1, bdd_2), bdd_x2);
+
+        bdd out = bdd_or(std::vector<bdd> { bdd_1, bdd_2, bdd_x2 });
+        AssertThat(out == expected, Is().True());
+      });
+
+      it("should combine more BDDs than fit in one sweep", [&]() {
+        std::vector<bdd> fs;
+        bdd expected = bdd_false();
+
+        for (label_t var = 0; var < 2u * NARY_MAX_OPERANDS + 3u; var++) {
+          bdd f = bdd_and(bdd_ithvar(var), bdd_ithvar(var+1));
+          fs.push_back(f);
+          expected = bdd_or(expected, f);
+        }
+
+        bdd out = bdd_or(fs);
+        AssertThat(out == expected, Is().True());
+      });
+    });
+
     describe("bdd_invimp(f,g)", [&]() {
       // TODO
     });
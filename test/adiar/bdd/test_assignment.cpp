@@ -321,5 +321,300 @@ go_bandit([]() {
         AssertThat(out_assignment.can_pull(), Is().False());
       });
     });
+    weight_file costs_2;
+    { // Garbage collect writer to free write-lock
+      weight_writer ww(costs_2);
+      ww << 1.0 << -2.0 << 3.0 << -4.0;
+    }
+
+    weight_file costs_3;
+    { // Garbage collect writer to free write-lock
+      weight_writer ww(costs_3);
+      ww << -1.0 << 2.0 << -3.0 << 1.0 << 5.0 << -2.0;
+    }
+
+    describe("bdd_satmincost", [&]() {
+      it("should retrieve assignment of minimal cost [2]", [&]() {
+        assignment_file result = bdd_satmincost(bdd_2, costs_2);
+        assignment_stream<> out_assignment(result);
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(0, false)));
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(1, true)));
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(2, false)));
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(3, true)));
+
+        AssertThat(out_assignment.can_pull(), Is().False());
+      });
+
+      it("should pick the cheapest value for skipped variables [3]", [&]() {
+        assignment_file result = bdd_satmincost(bdd_3, costs_3);
+        assignment_stream<> out_assignment(result);
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(0, true)));
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(1, false)));
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(2, true)));
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(3, true)));
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(4, false)));
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(5, true)));
+
+        AssertThat(out_assignment.can_pull(), Is().False());
+      });
+
+      it("should pick the cheapest value of all variables for a true sink", [&]() {
+        assignment_file result = bdd_satmincost(bdd_true(), costs_2);
+        assignment_stream<> out_assignment(result);
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(0, false)));
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(1, true)));
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(2, false)));
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(3, true)));
+
+        AssertThat(out_assignment.can_pull(), Is().False());
+      });
+
+      it("should retrieve no assignment for a false sink", [&]() {
+        assignment_file result = bdd_satmincost(bdd_false(), costs_2);
+        assignment_stream<> out_assignment(result);
+
+        AssertThat(out_assignment.can_pull(), Is().False());
+      });
+    });
+
+    describe("bdd_satmaxcost", [&]() {
+      it("should retrieve assignment of maximal cost [2]", [&]() {
+        assignment_file result = bdd_satmaxcost(bdd_2, costs_2);
+        assignment_stream<> out_assignment(result);
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(0, true)));
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(1, false)));
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(2, true)));
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(3, false)));
+
+        AssertThat(out_assignment.can_pull(), Is().False());
+      });
+
+      it("should pick the most expensive value for skipped variables [3]", [&]() {
+        assignment_file result = bdd_satmaxcost(bdd_3, costs_3);
+        assignment_stream<> out_assignment(result);
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(0, false)));
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(1, true)));
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(2, false)));
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(3, true)));
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(4, true)));
+
+        AssertThat(out_assignment.can_pull(), Is().True());
+        AssertThat(out_assignment.pull(), Is().EqualTo(create_assignment(5, true)));
+
+        AssertThat(out_assignment.can_pull(), Is().False());
+      });
+    });
+    // Collect all batches of an enumeration and check their sizes
+    const auto collect = [](const auto &enumerate, const size_t batch_size) {
+      assignment_batch result;
+      enumerate([&](const assignment_batch &batch) {
+        AssertThat(batch.size(), Is().GreaterThan(0u));
+        AssertThat(batch.size(), Is().LessThanOrEqualTo(batch_size));
+        result.insert(result.end(), batch.begin(), batch.end());
+      }, batch_size);
+      return result;
+    };
+
+    const auto assert_equal = [](const assignment_batch &actual,
+                                 const assignment_batch &expected) {
+      AssertThat(actual.size(), Is().EqualTo(expected.size()));
+      for (size_t i = 0; i < expected.size(); i++) {
+        AssertThat(actual[i].size(), Is().EqualTo(expected[i].size()));
+        for (size_t j = 0; j < expected[i].size(); j++) {
+          AssertThat(actual[i][j], Is().EqualTo(expected[i][j]));
+        }
+      }
+    };
+
+    describe("bdd_satall", [&]() {
+      it("should enumerate all assignments in order [2]", [&]() {
+        const assignment_batch result = collect([&](const auto &cb, size_t bs) {
+          bdd_satall(bdd_2, cb, bs);
+        }, 2u);
+
+        assert_equal(result, {
+          { create_assignment(0, false), create_assignment(1, false), create_assignment(2, true), create_assignment(3, false) },
+          { create_assignment(0, false), create_assignment(1, true), create_assignment(2, false), create_assignment(3, false) },
+          { create_assignment(0, false), create_assignment(1, true), create_assignment(2, false), create_assignment(3, true) },
+          { create_assignment(0, true), create_assignment(1, false), create_assignment(2, false), create_assignment(3, false) },
+          { create_assignment(0, true), create_assignment(1, false), create_assignment(2, true), create_assignment(3, false) },
+          { create_assignment(0, true), create_assignment(1, false), create_assignment(2, true), create_assignment(3, true) },
+          { create_assignment(0, true), create_assignment(1, true), create_assignment(2, false), create_assignment(3, false) },
+          { create_assignment(0, true), create_assignment(1, true), create_assignment(2, true), create_assignment(3, false) },
+          { create_assignment(0, true), create_assignment(1, true), create_assignment(2, true), create_assignment(3, true) }
+        });
+      });
+
+      it("should enumerate skipped levels [3]", [&]() {
+        const assignment_batch result = collect([&](const auto &cb, size_t bs) {
+          bdd_satall(bdd_3, cb, bs);
+        }, 3u);
+
+        assert_equal(result, {
+          { create_assignment(1, false), create_assignment(3, false), create_assignment(5, false) },
+          { create_assignment(1, false), create_assignment(3, true), create_assignment(5, true) },
+          { create_assignment(1, true), create_assignment(3, false), create_assignment(5, true) },
+          { create_assignment(1, true), create_assignment(3, true), create_assignment(5, true) }
+        });
+      });
+
+      it("should enumerate assignments of the negation [~3]", [&]() {
+        const assignment_batch result = collect([&](const auto &cb, size_t bs) {
+          bdd_satall(bdd_not(bdd_3), cb, bs);
+        }, 1024u);
+
+        AssertThat(result.size(), Is().EqualTo(4u));
+      });
+
+      it("should enumerate the empty assignment of a true sink", [&]() {
+        const assignment_batch result = collect([&](const auto &cb, size_t bs) {
+          bdd_satall(bdd_true(), cb, bs);
+        }, 2u);
+
+        AssertThat(result.size(), Is().EqualTo(1u));
+        AssertThat(result[0].size(), Is().EqualTo(0u));
+      });
+
+      it("should enumerate nothing for a false sink", [&]() {
+        bool called = false;
+        bdd_satall(bdd_false(), [&](const assignment_batch &) { called = true; });
+        AssertThat(called, Is().False());
+      });
+    });
+
+    describe("bdd_satcubes", [&]() {
+      it("should enumerate all cubes in order [2]", [&]() {
+        const assignment_batch result = collect([&](const auto &cb, size_t bs) {
+          bdd_satcubes(bdd_2, cb, bs);
+        }, 3u);
+
+        assert_equal(result, {
+          { create_assignment(0, false), create_assignment(1, false), create_assignment(2, true), create_assignment(3, false) },
+          { create_assignment(0, false), create_assignment(1, true), create_assignment(2, false) },
+          { create_assignment(0, true), create_assignment(2, false), create_assignment(3, false) },
+          { create_assignment(0, true), create_assignment(2, true) }
+        });
+      });
+
+      it("should leave out skipped levels [3]", [&]() {
+        const assignment_batch result = collect([&](const auto &cb, size_t bs) {
+          bdd_satcubes(bdd_3, cb, bs);
+        }, 1u);
+
+        assert_equal(result, {
+          { create_assignment(1, false), create_assignment(3, false), create_assignment(5, false) },
+          { create_assignment(1, false), create_assignment(3, true), create_assignment(5, true) },
+          { create_assignment(1, true), create_assignment(5, true) }
+        });
+      });
+    });
+    describe("bdd_sample", [&]() {
+      it("should only draw satisfying assignments to all levels [2]", [&]() {
+        std::mt19937_64 rng(42);
+        size_t samples = 0u;
+
+        bdd_sample(bdd_2, 100u, rng, [&](const assignment_batch &batch) {
+          AssertThat(batch.size(), Is().LessThanOrEqualTo(16u));
+
+          for (const std::vector<assignment_t> &x : batch) {
+            AssertThat(x.size(), Is().EqualTo(4u));
+            for (size_t i = 0; i < x.size(); i++) {
+              AssertThat(label_of(x[i]), Is().EqualTo(i));
+            }
+            AssertThat(bdd_eval(bdd_2, [&x](label_t l) { return x[l].value; }), Is().True());
+            samples++;
+          }
+        }, 16u);
+
+        AssertThat(samples, Is().EqualTo(100u));
+      });
+
+      it("should draw assignments uniformly [3]", [&]() {
+        // bdd_3 has 4 satisfying assignments to x1, x3, and x5, each of which
+        // should be drawn roughly a quarter of the time.
+        std::mt19937_64 rng(42);
+        std::map<std::vector<bool>, size_t> histogram;
+
+        bdd_sample(bdd_3, 4000u, rng, [&](const assignment_batch &batch) {
+          for (const std::vector<assignment_t> &x : batch) {
+            AssertThat(x.size(), Is().EqualTo(3u));
+            histogram[{ x[0].value, x[1].value, x[2].value }]++;
+          }
+        });
+
+        AssertThat(histogram.size(), Is().EqualTo(4u));
+        for (const auto &kv : histogram) {
+          AssertThat(kv.second, Is().GreaterThan(850u));
+          AssertThat(kv.second, Is().LessThan(1150u));
+        }
+      });
+
+      it("should draw empty assignments from a true sink", [&]() {
+        std::mt19937_64 rng(42);
+        size_t samples = 0u;
+
+        bdd_sample(bdd_true(), 3u, rng, [&](const assignment_batch &batch) {
+          for (const std::vector<assignment_t> &x : batch) {
+            AssertThat(x.size(), Is().EqualTo(0u));
+            samples++;
+          }
+        });
+
+        AssertThat(samples, Is().EqualTo(3u));
+      });
+
+      it("should draw nothing from a false sink", [&]() {
+        std::mt19937_64 rng(42);
+        bool called = false;
+        bdd_sample(bdd_false(), 3u, rng, [&](const assignment_batch &) { called = true; });
+        AssertThat(called, Is().False());
+      });
+    });
   });
  });
@@ -0,0 +1,87 @@
+#include <adiar/internal/async.h>
+
+go_bandit([]() {
+  describe("adiar/bdd/async.cpp", []() {
+    const bdd x0 = bdd_ithvar(0);
+    const bdd x1 = bdd_ithvar(1);
+    const bdd x2 = bdd_ithvar(2);
+
+    label_file labels_1;
+    {
+      label_writer lw(labels_1);
+      lw << 1;
+    }
+
+    it("wraps an already computed BDD", [&]() {
+      const bdd_future f(x0);
+
+      AssertThat(f.is_ready(), Is().True());
+      AssertThat(f.task() == nullptr, Is().True());
+      AssertThat(f.get() == x0, Is().True());
+    });
+
+    it("computes bdd_apply_async(x0, x1, and_op)", [&]() {
+      const bdd_future f = bdd_apply_async(x0, x1, and_op);
+
+      AssertThat(f.get() == bdd_and(x0, x1), Is().True());
+      AssertThat(f.is_ready(), Is().True());
+    });
+
+    it("computes bdd_ite_async(x0, x1, x2)", [&]() {
+      const bdd_future f = bdd_ite_async(x0, x1, x2);
+
+      AssertThat(f.get() == bdd_ite(x0, x1, x2), Is().True());
+    });
+
+    it("computes bdd_exists_async and bdd_forall_async", [&]() {
+      const bdd_future f = bdd_apply_async(x0, x1, and_op);
+
+      AssertThat(bdd_exists_async(f, 1).get() == x0, Is().True());
+      AssertThat(bdd_forall_async(f, 1).get() == bdd_false(), Is().True());
+
+      AssertThat(bdd_exists_async(f, labels_1).get() == x0, Is().True());
+      AssertThat(bdd_forall_async(f, labels_1).get() == bdd_false(), Is().True());
+    });
+
+    it("computes bdd_relprod_async(x0, x1, {1})", [&]() {
+      const bdd_future f = bdd_relprod_async(x0, x1, labels_1);
+
+      AssertThat(f.get() == x0, Is().True());
+    });
+
+    it("runs operations on the results of other asynchronous operations", [&]() {
+      // (x0 & x1) | (x1 ^ x2) | (x0 & x2), where the three parts are independent
+      const bdd_future f_01 = bdd_apply_async(x0, x1, and_op);
+      const bdd_future f_12 = bdd_apply_async(x1, x2, xor_op);
+      const bdd_future f_02 = bdd_apply_async(x0, x2, and_op);
+
+      const bdd_future f = bdd_apply_async(bdd_apply_async(f_01, f_12, or_op), f_02, or_op);
+
+      const bdd expected = (x0 & x1) | (x1 ^ x2) | (x0 & x2);
+      AssertThat(f.get() == expected, Is().True());
+    });
+
+    it("computes many independent operations", [&]() {
+      std::vector<bdd_future> fs;
+      for (label_t var = 0u; var < 16u; var++) {
+        fs.push_back(bdd_apply_async(bdd_ithvar(var), bdd_ithvar(var+1u), xor_op));
+      }
+
+      for (label_t var = 0u; var < 16u; var++) {
+        AssertThat(fs[var].get() == (bdd_ithvar(var) ^ bdd_ithvar(var+1u)), Is().True());
+      }
+    });
+
+    it("does not split a small memory budget below the minimum per operation", [&]() {
+      adiar_context ctx(64 * 1024 * 1024);
+
+      const bdd_future f = ctx.run([&]() { return bdd_apply_async(x0, x1, and_op); });
+      AssertThat(f.get() == bdd_and(x0, x1), Is().True());
+
+      AssertThat(f.task() -> concurrency, Is().LessThanOrEqualTo(2u));
+      AssertThat(f.task() -> memory, Is().GreaterThanOrEqualTo(async::MINIMUM_TASK_BYTES));
+      AssertThat(f.task() -> memory * f.task() -> concurrency,
+                 Is().LessThanOrEqualTo(64u * 1024u * 1024u));
+    });
+  });
+ });
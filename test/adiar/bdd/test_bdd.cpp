@@ -229,6 +229,47 @@ go_bandit([]() {
       });
     });
 
+    describe("bdd_hash", [&]() {
+      it("has equal hashes for the same function", [&]() {
+        AssertThat(bdd_hash(x0_and_x1), Is().EqualTo(bdd_hash(x0 & x1)));
+        AssertThat(bdd_hash(x0_nand_x1), Is().EqualTo(bdd_hash(~(x0 & x1))));
+        AssertThat(bdd_hash(sink_F), Is().EqualTo(bdd_hash(~sink_T)));
+      });
+
+      it("has equal hashes for the same function derived differently", [&]() {
+        bdd out_1 = x0 ^ x1;
+        bdd out_2 = (x0 & ~x1) | (~x0 & x1);
+        AssertThat(bdd_hash(out_1), Is().EqualTo(bdd_hash(out_2)));
+      });
+
+      it("has different hashes for x0 and x1", [&]() {
+        AssertThat(bdd_hash(x0), Is().Not().EqualTo(bdd_hash(x1)));
+      });
+
+      it("has different hashes for f and ~f", [&]() {
+        AssertThat(bdd_hash(x0_and_x1), Is().Not().EqualTo(bdd_hash(x0_nand_x1)));
+        AssertThat(bdd_hash(sink_T), Is().Not().EqualTo(bdd_hash(sink_F)));
+      });
+
+      it("has different hashes for x0 ^ x1 and ~(x0 ^ x1)", [&]() {
+        // Both have the nodes (x1,F,T), (x1,T,F), and a root on x0 pointing
+        // to both of them.
+        const bdd f = x0 ^ x1;
+        AssertThat(bdd_hash(f), Is().Not().EqualTo(bdd_hash(~f)));
+      });
+
+      it("has equal hashes for ~(x0 ^ x1) and its reduced form", [&]() {
+        const bdd f = x0 ^ x1;
+        const bdd g = bdd_apply(x0, x1, equiv_op);
+        AssertThat(bdd_hash(~f), Is().EqualTo(bdd_hash(g)));
+      });
+
+      it("has different hashes for x0 ? x1 : x2 and x0 ? x2 : x1", [&]() {
+        const bdd x2 = bdd_ithvar(2);
+        AssertThat(bdd_hash(bdd_ite(x0, x1, x2)), Is().Not().EqualTo(bdd_hash(bdd_ite(x0, x2, x1))));
+      });
+    });
+
     describe("sink predicates", [&]() {
       describe("is_sink", [&]() {
         it("rejects x0 as a sink file", [&]() {
@@ -326,5 +367,82 @@ go_bandit([]() {
         });
       });
     });
+
+    describe("bdd_save and bdd_load", [&]() {
+      // Remove leftovers of a prior run of the unit tests
+      for (const std::string name : { "bdd_save_test_and.adiar", "bdd_save_test_nand.adiar", "bdd_save_test_T.adiar",
+                                      "bdd_save_test_garbage.adiar", "bdd_save_test_truncated.adiar" }) {
+        for (const std::string suffix : { "", ".levels", ".0" }) {
+          std::filesystem::remove(name + suffix);
+        }
+      }
+
+      it("can save and load x0 & x1", [&]() {
+        bdd_save(x0_and_x1, "bdd_save_test_and.adiar");
+
+        bdd out = bdd_load("bdd_save_test_and.adiar");
+
+        AssertThat(out.file_ptr() -> is_persistent(), Is().True());
+        AssertThat(bdd_nodecount(out), Is().EqualTo(2u));
+        AssertThat(bdd_varcount(out), Is().EqualTo(2u));
+        AssertThat(is_canonical(out), Is().True());
+        AssertThat(out == x0_and_x1, Is().True());
+      });
+
+      it("stores the negation of ~(x0 & x1) in the saved file", [&]() {
+        bdd_save(x0_nand_x1, "bdd_save_test_nand.adiar");
+
+        bdd out = bdd_load("bdd_save_test_nand.adiar");
+
+        AssertThat(out.file_ptr() -> number_of_sinks[false], Is().EqualTo(1u));
+        AssertThat(out.file_ptr() -> number_of_sinks[true], Is().EqualTo(2u));
+        AssertThat(out == x0_nand_x1, Is().True());
+        AssertThat(out != x0_and_x1, Is().True());
+        AssertThat(bdd_hash(out), Is().EqualTo(bdd_hash(x0_nand_x1)));
+      });
+
+      it("can save and load a sink", [&]() {
+        bdd_save(sink_T, "bdd_save_test_T.adiar");
+
+        bdd out = bdd_load("bdd_save_test_T.adiar");
+
+        AssertThat(is_sink(out), Is().True());
+        AssertThat(value_of(out), Is().True());
+      });
+
+      it("can reload the same saved BDD multiple times", [&]() {
+        bdd out_1 = bdd_load("bdd_save_test_and.adiar");
+        bdd out_2 = bdd_load("bdd_save_test_and.adiar");
+
+        AssertThat(out_1 == out_2, Is().True());
+        AssertThat(out_1 == x0_and_x1, Is().True());
+      });
+
+      it("throws when saving to an already existing file", [&]() {
+        AssertThrows(std::invalid_argument, bdd_save(x0_nand_x1, "bdd_save_test_and.adiar"));
+
+        bdd out = bdd_load("bdd_save_test_and.adiar");
+        AssertThat(out == x0_and_x1, Is().True());
+      });
+
+      it("throws when loading a non-existing file", [&]() {
+        AssertThrows(std::invalid_argument, bdd_load("bdd_save_test_missing.adiar"));
+      });
+
+      it("throws when loading a file that is not a BDD", [&]() {
+        {
+          std::ofstream garbage("bdd_save_test_garbage.adiar");
+          garbage << "This is not a BDD";
+        }
+        AssertThrows(std::runtime_error, bdd_load("bdd_save_test_garbage.adiar"));
+      });
+
+      it("throws when loading a BDD whose nodes are missing", [&]() {
+        bdd_save(x0_and_x1, "bdd_save_test_truncated.adiar");
+        std::filesystem::remove("bdd_save_test_truncated.adiar.0");
+
+        AssertThrows(std::runtime_error, bdd_load("bdd_save_test_truncated.adiar"));
+      });
+    });
   });
  });
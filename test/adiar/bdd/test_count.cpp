@@ -268,5 +268,240 @@ go_bandit([]() {
         AssertThat(bdd_satcount(bdd_root_1), Is().EqualTo(1u));
       });
     });
+
+    // The number of assignments with exactly 150 out of 300 variables set to
+    // true is C(300,150), which is larger than 2^295.
+    const bdd bdd_counter_300 = bdd_counter(0, 299, 150);
+    const std::string binom_300_150 =
+      "93759702772827452793193754439064084879232655700081358920472352712975170021839591675861424";
+
+    describe("bdd_satcountln", [&]() {
+      it("can count assignments leading to T sinks [1]", [&]() {
+        AssertThat(bdd_satcountln(bdd_1, 4), Is().EqualToWithDelta(std::log2(5.0), 1e-9));
+        AssertThat(bdd_satcountln(bdd_1, 6), Is().EqualToWithDelta(std::log2(4 * 5.0), 1e-9));
+        AssertThat(bdd_satcountln(bdd_1), Is().EqualToWithDelta(std::log2(5.0), 1e-9));
+      });
+
+      it("can count assignments leading to F sinks [1]", [&]() {
+        AssertThat(bdd_satcountln(bdd_not(bdd_1), 4), Is().EqualToWithDelta(std::log2(11.0), 1e-9));
+      });
+
+      it("does not overflow on 300 variables", [&]() {
+        AssertThat(bdd_satcountln(bdd_1, 300), Is().EqualToWithDelta(std::log2(5.0) + 296, 1e-9));
+        AssertThat(bdd_satcountln(bdd_counter_300), Is().EqualToWithDelta(295.55864034637483, 1e-6));
+      });
+
+      it("should count all assignments to the desired sink-only BDD", [&]() {
+        AssertThat(bdd_satcountln(bdd_T, 5), Is().EqualToWithDelta(5.0, 1e-9));
+      });
+
+      it("should be negative infinity for an unsatisfiable BDD", [&]() {
+        AssertThat(std::isinf(bdd_satcountln(bdd_F, 3)), Is().True());
+        AssertThat(bdd_satcountln(bdd_F, 3) < 0.0, Is().True());
+      });
+    });
+
+    describe("bdd_pathcountln", [&]() {
+      it("can count paths leading to T sinks [1]", [&]() {
+        AssertThat(bdd_pathcountln(bdd_1), Is().EqualToWithDelta(std::log2(3.0), 1e-9));
+      });
+
+      it("can count paths leading to T sinks [4]", [&]() {
+        AssertThat(bdd_pathcountln(bdd_4), Is().EqualToWithDelta(std::log2(6.0), 1e-9));
+      });
+
+      it("should count no paths in a sink-only BDD", [&]() {
+        AssertThat(std::isinf(bdd_pathcountln(bdd_T)), Is().True());
+      });
+    });
+
+    describe("bdd_satcount_mod", [&]() {
+      it("can count assignments leading to T sinks modulo a small number", [&]() {
+        AssertThat(bdd_satcount_mod(bdd_1, 4, 3), Is().EqualTo(5u % 3u));
+        AssertThat(bdd_satcount_mod(bdd_1, 6, 7), Is().EqualTo(20u % 7u));
+        AssertThat(bdd_satcount_mod(bdd_not(bdd_1), 3), Is().EqualTo(11u % 3u));
+      });
+
+      it("can count modulo 1", [&]() {
+        AssertThat(bdd_satcount_mod(bdd_1, 1), Is().EqualTo(0u));
+        AssertThat(bdd_satcount_mod(bdd_T, 4, 1), Is().EqualTo(0u));
+      });
+
+      it("does not overflow on 300 variables", [&]() {
+        AssertThat(bdd_satcount_mod(bdd_1, 300, 1000000007u), Is().EqualTo(788140867u));
+        AssertThat(bdd_satcount_mod(bdd_1, 300, 18446744073709551557u),
+                   Is().EqualTo(11275664366168441009u));
+        AssertThat(bdd_satcount_mod(bdd_counter_300, 1000000007u), Is().EqualTo(956301965u));
+      });
+
+      it("should count all assignments to the desired sink-only BDD", [&]() {
+        AssertThat(bdd_satcount_mod(bdd_T, 5, 7), Is().EqualTo(32u % 7u));
+        AssertThat(bdd_satcount_mod(bdd_F, 5, 7), Is().EqualTo(0u));
+      });
+
+      it("throws if the modulus is 0", [&]() {
+        AssertThrows(std::invalid_argument, bdd_satcount_mod(bdd_1, 4, 0));
+        AssertThrows(std::invalid_argument, bdd_satcount_mod(bdd_T, 0));
+      });
+    });
+
+    describe("bdd_pathcount_mod", [&]() {
+      it("can count paths leading to T sinks modulo a small number", [&]() {
+        AssertThat(bdd_pathcount_mod(bdd_4, 4), Is().EqualTo(2u));
+        AssertThat(bdd_pathcount_mod(bdd_not(bdd_1), 3), Is().EqualTo(2u));
+      });
+
+      it("throws if the modulus is 0", [&]() {
+        AssertThrows(std::invalid_argument, bdd_pathcount_mod(bdd_4, 0));
+      });
+    });
+
+    describe("bdd_satcount_str", [&]() {
+      it("can count assignments leading to T sinks [1]", [&]() {
+        AssertThat(bdd_satcount_str(bdd_1, 4), Is().EqualTo("5"));
+        AssertThat(bdd_satcount_str(bdd_1), Is().EqualTo("5"));
+        AssertThat(bdd_satcount_str(bdd_not(bdd_1), 6), Is().EqualTo("44"));
+      });
+
+      it("does not overflow on 300 variables", [&]() {
+        AssertThat(bdd_satcount_str(bdd_1, 300),
+                   Is().EqualTo("636573742604526901958889277627930675328583873020605078323793890423244156176042720682311680"));
+        AssertThat(bdd_satcount_str(bdd_counter_300), Is().EqualTo(binom_300_150));
+      });
+
+      it("should count all assignments to the desired sink-only BDD", [&]() {
+        AssertThat(bdd_satcount_str(bdd_T, 70), Is().EqualTo("1180591620717411303424"));
+        AssertThat(bdd_satcount_str(bdd_F, 70), Is().EqualTo("0"));
+      });
+
+      it("counts with up to 65535 variables", [&]() {
+        AssertThat(bdd_satcount_str(bdd_T, 65535).size(), Is().EqualTo(19729u));
+      });
+
+      it("throws on more than 65535 variables", [&]() {
+        AssertThrows(std::overflow_error, bdd_satcount_str(bdd_T, 65536));
+      });
+    });
+
+    describe("bdd_pathcount_str", [&]() {
+      it("can count paths leading to T sinks [4]", [&]() {
+        AssertThat(bdd_pathcount_str(bdd_4), Is().EqualTo("6"));
+      });
+
+      it("does not overflow on 300 variables", [&]() {
+        // Each path of the counter visits all 300 levels.
+        AssertThat(bdd_pathcount_str(bdd_counter_300), Is().EqualTo(binom_300_150));
+      });
+
+      it("should count no paths in a sink-only BDD", [&]() {
+        AssertThat(bdd_pathcount_str(bdd_T), Is().EqualTo("0"));
+      });
+    });
+    weight_file probs_1;
+    weight_file costs_1;
+    { // Garbage collect writer to free write-lock
+      weight_writer pw(probs_1);
+      pw << 0.5 << 0.25 << 0.75 << 0.1;
+
+      weight_writer cw(costs_1);
+      cw << 3.0 << -2.0 << 4.0 << 1.0;
+    }
+
+    weight_file probs_2;
+    weight_file costs_2;
+    { // Garbage collect writer to free write-lock
+      weight_writer pw(probs_2);
+      pw << 0.2 << 0.4 << 0.6;
+
+      weight_writer cw(costs_2);
+      cw << -1.0 << 2.0 << 5.0;
+    }
+
+    weight_file probs_4;
+    weight_file costs_4;
+    { // Garbage collect writer to free write-lock
+      weight_writer pw(probs_4);
+      weight_writer cw(costs_4);
+      for (label_t i = 0; i < 7; i++) {
+        pw << 0.5;
+        cw << (i % 2 == 0 ? 1.0 : -1.0) * (i / 2 + 1);
+      }
+    }
+
+    describe("bdd_wmc", [&]() {
+      it("can compute the probability of T sinks [1]", [&]() {
+        AssertThat(bdd_wmc(bdd_1, probs_1), Is().EqualToWithDelta(0.078125, 1e-9));
+      });
+
+      it("can compute the probability of F sinks [1]", [&]() {
+        AssertThat(bdd_wmc(bdd_not(bdd_1), probs_1), Is().EqualToWithDelta(1.0 - 0.078125, 1e-9));
+      });
+
+      it("accounts for skipped levels [2]", [&]() {
+        AssertThat(bdd_wmc(bdd_2, probs_2), Is().EqualToWithDelta(0.76, 1e-9));
+      });
+
+      it("coincides with counting for uniform probabilities [4]", [&]() {
+        AssertThat(bdd_wmc(bdd_4, probs_4), Is().EqualToWithDelta(bdd_satcount(bdd_4, 7) / 128.0, 1e-9));
+      });
+
+      it("should be 1 for the true sink-only BDD", [&]() {
+        AssertThat(bdd_wmc(bdd_T, probs_2), Is().EqualToWithDelta(1.0, 1e-9));
+      });
+
+      it("should be 0 for the false sink-only BDD", [&]() {
+        AssertThat(bdd_wmc(bdd_F, probs_2), Is().EqualToWithDelta(0.0, 1e-9));
+      });
+    });
+
+    describe("bdd_mincost", [&]() {
+      it("can compute the minimal cost [1]", [&]() {
+        AssertThat(bdd_mincost(bdd_1, costs_1), Is().EqualTo(2.0));
+      });
+
+      it("can compute the minimal cost [~1]", [&]() {
+        AssertThat(bdd_mincost(bdd_not(bdd_1), costs_1), Is().EqualTo(-2.0));
+      });
+
+      it("includes negative costs of skipped levels [2]", [&]() {
+        AssertThat(bdd_mincost(bdd_2, costs_2), Is().EqualTo(1.0));
+      });
+
+      it("can compute the minimal cost [4]", [&]() {
+        AssertThat(bdd_mincost(bdd_4, costs_4), Is().EqualTo(-6.0));
+      });
+
+      it("should be the sum of all negative costs for the true sink-only BDD", [&]() {
+        AssertThat(bdd_mincost(bdd_T, costs_2), Is().EqualTo(-1.0));
+      });
+
+      it("should be infinity for the false sink-only BDD", [&]() {
+        AssertThat(std::isinf(bdd_mincost(bdd_F, costs_2)), Is().True());
+        AssertThat(bdd_mincost(bdd_F, costs_2) > 0.0, Is().True());
+      });
+    });
+
+    describe("bdd_maxcost", [&]() {
+      it("can compute the maximal cost [1]", [&]() {
+        AssertThat(bdd_maxcost(bdd_1, costs_1), Is().EqualTo(8.0));
+      });
+
+      it("includes positive costs of skipped levels [2]", [&]() {
+        AssertThat(bdd_maxcost(bdd_2, costs_2), Is().EqualTo(7.0));
+      });
+
+      it("can compute the maximal cost [4]", [&]() {
+        AssertThat(bdd_maxcost(bdd_4, costs_4), Is().EqualTo(10.0));
+      });
+
+      it("should be the sum of all positive costs for the true sink-only BDD", [&]() {
+        AssertThat(bdd_maxcost(bdd_T, costs_2), Is().EqualTo(7.0));
+      });
+
+      it("should be negative infinity for the false sink-only BDD", [&]() {
+        AssertThat(std::isinf(bdd_maxcost(bdd_F, costs_2)), Is().True());
+        AssertThat(bdd_maxcost(bdd_F, costs_2) < 0.0, Is().True());
+      });
+    });
   });
  });
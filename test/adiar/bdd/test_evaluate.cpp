@@ -352,5 +352,166 @@ go_bandit([]() {
         AssertThat(bdd_eval(bdd_T, af), Is().True());
       });
     });
+    describe("bdd_eval_batch(bdd, bitvector_file, varcount)", [&]() {
+      // Write the assignments 'x(i)' for i in [0, n) with 'words' words each
+      const auto assignments = [](size_t n, size_t words,
+                                  const std::function<uint64_t(size_t)> &x) {
+        bitvector_file xs;
+        bitvector_writer xw(xs);
+
+        for (size_t i = 0u; i < n; i++) {
+          xw << x(i);
+          for (size_t w = 1u; w < words; w++) { xw << uint64_t(0u); }
+        }
+        return xs;
+      };
+
+      const auto results = [](const bitvector_file &res) {
+        std::vector<uint64_t> words;
+        bitvector_stream<> rs(res);
+        while (rs.can_pull()) { words.push_back(rs.pull()); }
+        return words;
+      };
+
+      it("evaluates all assignments to the test BDD", [&]() {
+        const bitvector_file xs = assignments(16u, 1u, [](size_t i) { return i; });
+        const std::vector<uint64_t> res = results(bdd_eval_batch(bdd, xs, 4u));
+
+        AssertThat(res.size(), Is().EqualTo(1u));
+        for (uint64_t i = 0u; i < 16u; i++) {
+          const bool expected = bdd_eval(bdd, [&i](label_t l) { return (i >> l) & 1u; });
+          AssertThat(bool((res[0] >> i) & 1u), Is().EqualTo(expected));
+        }
+        AssertThat(res[0] >> 16u, Is().EqualTo(0u));
+      });
+
+      it("evaluates assignments across several words of results", [&]() {
+        const bitvector_file xs = assignments(100u, 1u, [](size_t i) { return i % 32u; });
+        const std::vector<uint64_t> res = results(bdd_eval_batch(skip_bdd, xs, 5u));
+
+        AssertThat(res.size(), Is().EqualTo(2u));
+        for (uint64_t i = 0u; i < 100u; i++) {
+          const bool expected = bdd_eval(skip_bdd, [&i](label_t l) { return ((i % 32u) >> l) & 1u; });
+          AssertThat(bool((res[i / 64u] >> (i % 64u)) & 1u), Is().EqualTo(expected));
+        }
+        AssertThat(res[1] >> 36u, Is().EqualTo(0u));
+      });
+
+      it("evaluates assignments of multiple words each", [&]() {
+        const bitvector_file xs = assignments(32u, 2u, [](size_t i) { return i; });
+        const std::vector<uint64_t> res = results(bdd_eval_batch(skip_bdd, xs, 70u));
+
+        AssertThat(res.size(), Is().EqualTo(1u));
+        for (uint64_t i = 0u; i < 32u; i++) {
+          const bool expected = bdd_eval(skip_bdd, [&i](label_t l) { return (i >> l) & 1u; });
+          AssertThat(bool((res[0] >> i) & 1u), Is().EqualTo(expected));
+        }
+      });
+
+      it("returns T for every assignment on T sink-only BDD", [&]() {
+        const bitvector_file xs = assignments(3u, 1u, [](size_t i) { return i; });
+        const std::vector<uint64_t> res = results(bdd_eval_batch(bdd_T, xs, 2u));
+
+        AssertThat(res.size(), Is().EqualTo(1u));
+        AssertThat(res[0], Is().EqualTo(7u));
+      });
+
+      it("returns F for every assignment on F sink-only BDD", [&]() {
+        const bitvector_file xs = assignments(3u, 1u, [](size_t i) { return i; });
+        const std::vector<uint64_t> res = results(bdd_eval_batch(bdd_F, xs, 2u));
+
+        AssertThat(res.size(), Is().EqualTo(1u));
+        AssertThat(res[0], Is().EqualTo(0u));
+      });
+
+      it("returns no results for no assignments", [&]() {
+        const bitvector_file xs;
+        AssertThat(bdd_eval_batch(bdd, xs, 4u).size(), Is().EqualTo(0u));
+      });
+
+      it("returns no results for no assignments to zero variables", [&]() {
+        const bitvector_file xs;
+        AssertThat(bdd_eval_batch(bdd_T, xs, 0u).size(), Is().EqualTo(0u));
+        AssertThat(bdd_eval_batch(bdd_F, xs, 0u).size(), Is().EqualTo(0u));
+      });
+
+      it("throws on non-empty assignments to zero variables", [&]() {
+        const bitvector_file xs = assignments(3u, 1u, [](size_t i) { return i; });
+        AssertThrows(std::invalid_argument, bdd_eval_batch(bdd_T, xs, 0u));
+      });
+    });
+    describe("bdd_compile(bdd) and compiled_bdd::eval_batch(xs, words)", [&]() {
+      // Bit-slice the assignments 'j mod 2^varcount' for j in [0, 64 * words)
+      const auto slices = [](label_t varcount, size_t words) {
+        std::vector<uint64_t> xs(varcount * words, 0u);
+        for (label_t l = 0u; l < varcount; l++) {
+          for (size_t j = 0u; j < 64u * words; j++) {
+            const uint64_t x = j % (uint64_t(1u) << varcount);
+            xs[l * words + j / 64u] |= ((x >> l) & 1u) << (j % 64u);
+          }
+        }
+        return xs;
+      };
+
+      const auto assert_eval = [](const adiar::bdd &f,
+                                  const std::vector<uint64_t> &res,
+                                  label_t varcount, size_t words) {
+        AssertThat(res.size(), Is().EqualTo(words));
+        for (size_t j = 0u; j < 64u * words; j++) {
+          const uint64_t x = j % (uint64_t(1u) << varcount);
+          const bool expected = bdd_eval(f, [&x](label_t l) { return (x >> l) & 1u; });
+          AssertThat(bool((res[j / 64u] >> (j % 64u)) & 1u), Is().EqualTo(expected));
+        }
+      };
+
+      it("flattens the test BDD bottom-up", [&]() {
+        const compiled_bdd c = bdd_compile(bdd);
+
+        AssertThat(c.size(), Is().EqualTo(5u));
+        AssertThat(c.varcount(), Is().EqualTo(4u));
+
+        // n5, n4, n3, n2, n1
+        AssertThat(c.nodes()[0].label, Is().EqualTo(3u));
+        AssertThat(c.nodes()[0].low, Is().EqualTo(0u));
+        AssertThat(c.nodes()[0].high, Is().EqualTo(1u));
+
+        AssertThat(c.nodes()[1].label, Is().EqualTo(2u));
+        AssertThat(c.nodes()[1].low, Is().EqualTo(1u));
+        AssertThat(c.nodes()[1].high, Is().EqualTo(2u));
+
+        AssertThat(c.nodes()[4].label, Is().EqualTo(0u));
+        AssertThat(c.nodes()[4].low, Is().EqualTo(4u));
+        AssertThat(c.nodes()[4].high, Is().EqualTo(5u));
+      });
+
+      it("evaluates the test BDD on a single word of assignments", [&]() {
+        const compiled_bdd c = bdd_compile(bdd);
+        assert_eval(bdd, c.eval_batch(slices(4u, 1u), 1u), 4u, 1u);
+      });
+
+      it("evaluates the test BDD on whole and partial SIMD lanes", [&]() {
+        const compiled_bdd c = bdd_compile(bdd);
+        assert_eval(bdd, c.eval_batch(slices(4u, 13u), 13u), 4u, 13u);
+      });
+
+      it("evaluates the negated BDD that skips levels", [&]() {
+        const adiar::bdd f = bdd_not(skip_bdd);
+        const compiled_bdd c = bdd_compile(f);
+        assert_eval(f, c.eval_batch(slices(5u, 3u), 3u), 5u, 3u);
+      });
+
+      it("evaluates a T sink-only BDD", [&]() {
+        const compiled_bdd c = bdd_compile(bdd_T);
+        AssertThat(c.size(), Is().EqualTo(0u));
+        AssertThat(c.eval_batch(std::vector<uint64_t>(), 2u),
+                   Is().EqualTo(std::vector<uint64_t>{ ~uint64_t(0u), ~uint64_t(0u) }));
+      });
+
+      it("evaluates a F sink-only BDD", [&]() {
+        const compiled_bdd c = bdd_compile(bdd_F);
+        AssertThat(c.eval_batch(std::vector<uint64_t>(), 2u),
+                   Is().EqualTo(std::vector<uint64_t>{ 0u, 0u }));
+      });
+    });
   });
  });
@@ -0,0 +1,207 @@
+go_bandit([]() {
+  describe("adiar/bdd/expr.cpp", []() {
+    typedef bdd_expr::node::op_t op_t;
+
+    const bdd x0 = bdd_ithvar(0);
+    const bdd x1 = bdd_ithvar(1);
+    const bdd x2 = bdd_ithvar(2);
+    const bdd x3 = bdd_ithvar(3);
+
+    label_file labels_1;
+    label_file labels_12;
+    {
+      label_writer lw_1(labels_1);
+      lw_1 << 1;
+
+      label_writer lw_12(labels_12);
+      lw_12 << 1 << 2;
+    }
+
+    describe("building", [&]() {
+      it("wraps a BDD as a leaf", [&]() {
+        const bdd_expr e = bdd_lazy(x0);
+
+        AssertThat(e.root() -> op == op_t::LEAF, Is().True());
+        AssertThat(e.negated(), Is().False());
+      });
+
+      it("flattens a chain of 'and' into a single operation", [&]() {
+        const bdd_expr e = bdd_lazy(x0) & x1 & x2 & x3;
+
+        AssertThat(e.root() -> op == op_t::AND, Is().True());
+        AssertThat(e.root() -> args.size(), Is().EqualTo(4u));
+      });
+
+      it("flattens a chain of 'or' into a single operation", [&]() {
+        const bdd_expr e = x0 | (bdd_lazy(x1) | x2) | x3;
+
+        AssertThat(e.root() -> op == op_t::OR, Is().True());
+        AssertThat(e.root() -> args.size(), Is().EqualTo(4u));
+      });
+
+      it("flattens a negated 'or' into an 'and'", [&]() {
+        const bdd_expr e = x0 & ~(bdd_lazy(x1) | x2);
+
+        AssertThat(e.root() -> op == op_t::AND, Is().True());
+        AssertThat(e.root() -> args.size(), Is().EqualTo(3u));
+      });
+
+      it("moves negations out of a 'xor'", [&]() {
+        const bdd_expr e = ~bdd_lazy(x0) ^ x1 ^ ~bdd_lazy(x2);
+
+        AssertThat(e.root() -> op == op_t::XOR, Is().True());
+        AssertThat(e.root() -> args.size(), Is().EqualTo(3u));
+        AssertThat(e.negated(), Is().False());
+
+        for (const bdd_expr &a : e.root() -> args) {
+          AssertThat(a.negated(), Is().False());
+        }
+      });
+
+      it("folds double negation", [&]() {
+        const bdd_expr e = bdd_lazy(x0) & x1;
+        const bdd_expr not_not_e = ~~e;
+
+        AssertThat(not_not_e.root() == e.root(), Is().True());
+        AssertThat(not_not_e.negated(), Is().False());
+      });
+
+      it("does not flatten a shared subexpression", [&]() {
+        const bdd_expr e_01 = bdd_lazy(x0) & x1;
+        const bdd_expr e = e_01 & x2;
+
+        AssertThat(e.root() -> args.size(), Is().EqualTo(2u));
+        AssertThat(e.root() -> args[0].root() == e_01.root(), Is().True());
+      });
+
+      it("removes neutral constants", [&]() {
+        const bdd_expr e = bdd_lazy(x0) & bdd_true() & x1;
+
+        AssertThat(e.root() -> args.size(), Is().EqualTo(2u));
+      });
+
+      it("short-circuits on absorbing constants", [&]() {
+        const bdd_expr e = bdd_lazy(x0) & x1 & bdd_false();
+
+        AssertThat(e.root() -> op == op_t::LEAF, Is().True());
+        AssertThat(bdd(e) == bdd_false(), Is().True());
+      });
+
+      it("accumulates operands in-place with '&='", [&]() {
+        bdd_expr e = bdd_lazy(x0);
+        e &= x1;
+        const bdd_expr::node *root = e.root().get();
+
+        e &= x2;
+        e &= bdd_lazy(x3);
+
+        AssertThat(e.root().get() == root, Is().True());
+        AssertThat(e.root() -> args.size(), Is().EqualTo(4u));
+      });
+
+      it("nests rather than accumulates with 'e = e & x'", [&]() {
+        bdd_expr e = bdd_lazy(x0) & x1;
+        const bdd_expr::node *root = e.root().get();
+
+        e = e & x2;
+
+        AssertThat(e.root().get() == root, Is().False());
+        AssertThat(e.root() -> args.size(), Is().EqualTo(2u));
+        AssertThat(e.root() -> args[0].root().get() == root, Is().True());
+      });
+
+      it("destroys a deep expression without overflowing the stack", [&]() {
+        bdd_expr e = bdd_lazy(x0) & x1;
+        for (size_t i = 0; i < 100000u; i++) {
+          e = e ^ x2;
+          e = e & x3;
+        }
+      });
+    });
+
+    describe("evaluation", [&]() {
+      it("computes x0 & x1 & x2 & x3", [&]() {
+        const bdd out = bdd_lazy(x0) & x1 & x2 & x3;
+
+        AssertThat(out == (x0 & x1 & x2 & x3), Is().True());
+      });
+
+      it("computes x0 | ~(x1 & x2)", [&]() {
+        const bdd out = x0 | ~(bdd_lazy(x1) & x2);
+
+        AssertThat(out == (x0 | ~(x1 & x2)), Is().True());
+      });
+
+      it("computes ~x0 ^ x1 ^ ~x2 ^ x3", [&]() {
+        const bdd out = ~bdd_lazy(x0) ^ x1 ^ ~bdd_lazy(x2) ^ x3;
+
+        AssertThat(out == (~x0 ^ x1 ^ ~x2 ^ x3), Is().True());
+      });
+
+      it("computes exists x1 : x0 & x1 & x2", [&]() {
+        const bdd out = bdd_exists(bdd_lazy(x0) & x1 & x2, 1);
+
+        AssertThat(out == (x0 & x2), Is().True());
+      });
+
+      it("computes exists x1,x2 : ~(x0 | x1 | ~x2)", [&]() {
+        const bdd out = bdd_exists(~(bdd_lazy(x0) | x1 | ~x2), labels_12);
+
+        AssertThat(out == ~x0, Is().True());
+      });
+
+      it("computes exists x2,x1,x2 : (x0 ^ x1) & (x1 | x2) & x3", [&]() {
+        label_file labels_212;
+        {
+          label_writer lw(labels_212);
+          lw << 2 << 1 << 2;
+        }
+
+        const bdd out = bdd_exists(bdd_lazy(x0 ^ x1) & (x1 | x2) & x3, labels_212);
+        const bdd expected = bdd_exists((x0 ^ x1) & (x1 | x2) & x3, labels_212);
+
+        AssertThat(out == expected, Is().True());
+        AssertThat(out == x3, Is().True());
+      });
+
+      it("computes forall x1 : x0 | x1", [&]() {
+        const bdd out = bdd_forall(bdd_lazy(x0) | x1, labels_1);
+
+        AssertThat(out == x0, Is().True());
+      });
+
+      it("computes forall x1 : x0 & x1", [&]() {
+        const bdd out = bdd_forall(bdd_lazy(x0) & x1, 1);
+
+        AssertThat(out == bdd_false(), Is().True());
+      });
+
+      it("computes a shared subexpression only once", [&]() {
+        const bdd_expr e_01 = bdd_lazy(x0) ^ x1;
+        const bdd_expr e_a = e_01 & x2;
+        const bdd_expr e_b = e_01 | x3;
+
+        const bdd out_a = e_a;
+        AssertThat(e_01.root() -> op == op_t::XOR, Is().True());
+        AssertThat(e_01.root() -> leaf.has_value(), Is().True());
+        AssertThat(e_01.root() -> args.size(), Is().EqualTo(0u));
+
+        const bdd out_b = e_b;
+
+        AssertThat(out_a == ((x0 ^ x1) & x2), Is().True());
+        AssertThat(out_b == ((x0 ^ x1) | x3), Is().True());
+      });
+
+      it("computes a deep expression", [&]() {
+        bdd_expr e = bdd_lazy(x0);
+        for (size_t i = 0; i < 1000u; i++) {
+          e = e ^ x1;
+          e = bdd_exists(e & x2, 2);
+        }
+
+        const bdd out = e;
+        AssertThat(out == x0, Is().True());
+      });
+    });
+  });
+ });
@@ -1607,5 +1607,80 @@ go_bandit([]() {
         AssertThat(out.negate, Is().False());
       });
     });
+
+    describe("bdd_exists / bdd_forall (multiple variables in one sweep)", [&]() {
+      // Quantify one variable at a time to obtain the expected result.
+      const auto per_label = [](bdd f, const std::vector<label_t> &vars, bool exists) {
+        for (const label_t var : vars) {
+          f = exists ? bdd_exists(f, var) : bdd_forall(f, var);
+        }
+        return f;
+      };
+
+      const auto to_label_file = [](const std::vector<label_t> &vars) {
+        label_file labels;
+        label_writer lw(labels);
+        for (const label_t var : vars) { lw << var; }
+        return labels;
+      };
+
+      // f = exactly 15 out of x0, ..., x19
+      const bdd f = bdd_counter(0, 19, 15);
+
+      it("should quantify consecutive levels [exists]", [&]() {
+        const std::vector<label_t> vars = { 0, 1, 2 };
+
+        bdd out = bdd_exists(f, to_label_file(vars));
+        AssertThat(out == per_label(f, vars, true), Is().True());
+      });
+
+      it("should quantify consecutive levels [forall]", [&]() {
+        const std::vector<label_t> vars = { 0, 1, 2 };
+
+        bdd out = bdd_forall(bdd_not(f), to_label_file(vars));
+        AssertThat(out == per_label(bdd_not(f), vars, false), Is().True());
+      });
+
+      it("should quantify levels with other levels in-between", [&]() {
+        const std::vector<label_t> vars = { 1, 4, 7, 12, 19 };
+
+        bdd out = bdd_exists(f, to_label_file(vars));
+        AssertThat(out == per_label(f, vars, true), Is().True());
+      });
+
+      it("should quantify the variables independently of their order", [&]() {
+        const std::vector<label_t> vars = { 12, 0, 7 };
+
+        bdd out = bdd_exists(f, to_label_file(vars));
+        AssertThat(out == per_label(f, vars, true), Is().True());
+      });
+
+      it("should ignore variables not in the BDD", [&]() {
+        const std::vector<label_t> vars = { 3, 21, 42 };
+
+        bdd out = bdd_exists(f, to_label_file(vars));
+        AssertThat(out == bdd_exists(f, 3), Is().True());
+      });
+
+      it("should defer levels with too many nodes in a request", [&]() {
+        // At most 11 different counts are possible after x0, ..., x9 which is
+        // more than the number of nodes in a request.
+        const std::vector<label_t> vars = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+        bdd out = bdd_exists(f, to_label_file(vars));
+        AssertThat(out == per_label(f, vars, true), Is().True());
+      });
+
+      it("should quantify everything into a sink", [&]() {
+        std::vector<label_t> vars;
+        for (label_t var = 0; var < 20; var++) { vars.push_back(var); }
+
+        bdd out_exists = bdd_exists(f, to_label_file(vars));
+        AssertThat(out_exists == bdd_true(), Is().True());
+
+        bdd out_forall = bdd_forall(f, to_label_file(vars));
+        AssertThat(out_forall == bdd_false(), Is().True());
+      });
+    });
   });
  });
@@ -0,0 +1,134 @@
+go_bandit([]() {
+  describe("adiar/bdd/relprod.cpp", []() {
+    ptr_t sink_F = create_sink_ptr(false);
+    ptr_t sink_T = create_sink_ptr(true);
+
+    node_file bdd_F;
+    node_file bdd_T;
+
+    { // Garbage collect writers to free write-lock
+      node_writer nw_F(bdd_F);
+      nw_F << create_sink(false);
+
+      node_writer nw_T(bdd_T);
+      nw_T << create_sink(true);
+    }
+
+    /*
+    //   1     ---- x0
+    //  / \
+    //  T 2    ---- x1
+    //   / \
+    //   F T
+    */
+    node_file bdd_1;
+
+    { // Garbage collect writer to free write-lock
+      node_writer nw_1(bdd_1);
+      nw_1 << create_node(1,MAX_ID, sink_F, sink_T)
+           << create_node(0,MAX_ID, sink_T, create_node_ptr(1,MAX_ID));
+    }
+
+    /*
+    //     1     ---- x1
+    //    / \
+    //    2  T   ---- x2
+    //   / \
+    //   F T
+    */
+    node_file bdd_2;
+
+    { // Garbage collect writer to free write-lock
+      node_writer nw_2(bdd_2);
+      nw_2 << create_node(2,MAX_ID, sink_F, sink_T)
+           << create_node(1,MAX_ID, create_node_ptr(2,MAX_ID), sink_T);
+    }
+
+    label_file vars_0;
+    label_file vars_1;
+    label_file vars_01;
+    label_file vars_012;
+
+    { // Garbage collect writers to free write-lock
+      label_writer w_0(vars_0);
+      w_0 << 0;
+
+      label_writer w_1(vars_1);
+      w_1 << 1;
+
+      label_writer w_01(vars_01);
+      w_01 << 0 << 1;
+
+      label_writer w_012(vars_012);
+      w_012 << 0 << 1 << 2;
+    }
+
+    describe("bdd_relprod(f, g, vars)", [&]() {
+      it("should shortcut on an F sink", [&]() {
+        bdd out = bdd_relprod(bdd_1, bdd_F, vars_0);
+        AssertThat(out == bdd_false(), Is().True());
+      });
+
+      it("should compute the conjunction without any variables", [&]() {
+        label_file vars;
+
+        bdd out = bdd_relprod(bdd_1, bdd_2, vars);
+        AssertThat(out == bdd_and(bdd_1, bdd_2), Is().True());
+      });
+
+      it("should quantify the root level", [&]() {
+        bdd out = bdd_relprod(bdd_1, bdd_2, vars_0);
+        AssertThat(out == bdd_exists(bdd_and(bdd_1, bdd_2), vars_0), Is().True());
+      });
+
+      it("should quantify a level shared by both BDDs", [&]() {
+        bdd out = bdd_relprod(bdd_1, bdd_2, vars_1);
+        AssertThat(out == bdd_exists(bdd_and(bdd_1, bdd_2), vars_1), Is().True());
+      });
+
+      it("should collapse to T when quantifying all variables of a satisfiable product", [&]() {
+        bdd out = bdd_relprod(bdd_1, bdd_2, vars_012);
+        AssertThat(out == bdd_true(), Is().True());
+      });
+
+      it("should collapse to F when the product is unsatisfiable", [&]() {
+        bdd out = bdd_relprod(bdd_1, bdd_not(bdd_1), vars_01);
+        AssertThat(out == bdd_false(), Is().True());
+      });
+
+      it("should quantify with negated BDDs", [&]() {
+        bdd out = bdd_relprod(bdd_not(bdd_1), bdd_2, vars_01);
+        AssertThat(out == bdd_exists(bdd_and(bdd_not(bdd_1), bdd_2), vars_01), Is().True());
+      });
+
+      it("should quantify more variables in a row than fit into a request", [&]() {
+        // f = (x0 /\ x3) \/ (x1 /\ x4) \/ (x2 /\ x5)
+        bdd f = bdd_or(bdd_or(bdd_and(bdd_ithvar(0), bdd_ithvar(3)),
+                              bdd_and(bdd_ithvar(1), bdd_ithvar(4))),
+                       bdd_and(bdd_ithvar(2), bdd_ithvar(5)));
+
+        // g = (x0 xor x1 xor x2) /\ (x3 xor x4 xor x5)
+        bdd g = bdd_and(bdd_xor(bdd_xor(bdd_ithvar(0), bdd_ithvar(1)), bdd_ithvar(2)),
+                        bdd_xor(bdd_xor(bdd_ithvar(3), bdd_ithvar(4)), bdd_ithvar(5)));
+
+        bdd out = bdd_relprod(f, g, vars_012);
+        AssertThat(out == bdd_exists(bdd_and(f, g), vars_012), Is().True());
+      });
+
+      it("should quantify variables given out of order and with duplicates", [&]() {
+        label_file vars_2101;
+        {
+          label_writer w(vars_2101);
+          w << 2 << 1 << 0 << 1;
+        }
+
+        // f = (x0 xor x1) /\ x3
+        bdd f = bdd_and(bdd_xor(bdd_ithvar(0), bdd_ithvar(1)), bdd_ithvar(3));
+
+        bdd out = bdd_relprod(f, bdd_2, vars_2101);
+        AssertThat(out == bdd_exists(bdd_and(f, bdd_2), vars_012), Is().True());
+        AssertThat(out == bdd_ithvar(3), Is().True());
+      });
+    });
+  });
+ });
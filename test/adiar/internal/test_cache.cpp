@@ -0,0 +1,103 @@
+#include <adiar/internal/cache.h>
+
+go_bandit([]() {
+  describe("adiar/internal/cache.h", []() {
+    const bdd x0 = bdd_ithvar(0);
+    const bdd x1 = bdd_ithvar(1);
+    const bdd x2 = bdd_ithvar(2);
+
+    label_file labels;
+    {
+      label_writer lw(labels);
+      lw << 1;
+    }
+
+    // Obtain the file of a (reduced) result
+    const auto file_of = [](const bdd &f) {
+      return f.file_ptr();
+    };
+
+    after_each([]() {
+      cache::set_limit(0u);
+    });
+
+    it("is disabled by default", [&]() {
+      AssertThat(cache::get_limit(), Is().EqualTo(0u));
+      AssertThat(cache::key_of(cache::operation::BDD_APPLY, x0, x1, and_op).has_value(),
+                 Is().False());
+    });
+
+    it("returns the same result for the same inputs to bdd_apply", [&]() {
+      cache::set_limit(1024u * 1024u);
+
+      const bdd out_1 = bdd_apply(x0, x1, and_op);
+      const bdd out_2 = bdd_apply(x0, x1, and_op);
+
+      AssertThat(file_of(out_1), Is().EqualTo(file_of(out_2)));
+      AssertThat(cache::size(), Is().GreaterThan(0u));
+    });
+
+    it("distinguishes operators and negation", [&]() {
+      cache::set_limit(1024u * 1024u);
+
+      const bdd out_and = bdd_apply(x0, x1, and_op);
+      const bdd out_or  = bdd_apply(x0, x1, or_op);
+      const bdd out_neg = bdd_apply(bdd_not(x0), x1, and_op);
+
+      AssertThat(file_of(out_and), Is().Not().EqualTo(file_of(out_or)));
+      AssertThat(file_of(out_and), Is().Not().EqualTo(file_of(out_neg)));
+
+      AssertThat(out_or == bdd_or(x0, x1), Is().True());
+      AssertThat(out_neg == bdd_and(bdd_not(x0), x1), Is().True());
+    });
+
+    it("does not cache a generic bool_op", [&]() {
+      cache::set_limit(1024u * 1024u);
+
+      const bool_op generic_and = [](ptr_t s1, ptr_t s2) -> ptr_t { return and_op(s1, s2); };
+
+      AssertThat(cache::key_of(cache::operation::BDD_APPLY, x0, x1, generic_and).has_value(),
+                 Is().False());
+    });
+
+    it("returns the same result for the same inputs to bdd_exists", [&]() {
+      cache::set_limit(1024u * 1024u);
+
+      const bdd f = bdd_and(x0, bdd_xor(x1, x2));
+
+      const bdd out_1 = bdd_exists(f, labels);
+      const bdd out_2 = bdd_exists(f, labels);
+
+      AssertThat(file_of(out_1), Is().EqualTo(file_of(out_2)));
+      AssertThat(out_1 == x0, Is().True());
+
+      // Forall is another operation
+      const bdd out_3 = bdd_forall(f, labels);
+      AssertThat(file_of(out_1), Is().Not().EqualTo(file_of(out_3)));
+    });
+
+    it("evicts the least recently used result", [&]() {
+      const bdd out_and = bdd_apply(x0, x1, and_op);
+
+      // Room for only a single result of this size
+      cache::set_limit(out_and.file_ptr()->file_size() + 1u);
+
+      const bdd out_1 = bdd_apply(x0, x1, and_op);
+      const bdd out_2 = bdd_apply(x0, x1, or_op);
+      const bdd out_3 = bdd_apply(x0, x1, and_op);
+
+      AssertThat(file_of(out_1), Is().Not().EqualTo(file_of(out_3)));
+      AssertThat(cache::size(), Is().LessThanOrEqualTo(cache::get_limit()));
+    });
+
+    it("is cleared when it is disabled", [&]() {
+      cache::set_limit(1024u * 1024u);
+
+      bdd_apply(x0, x1, and_op);
+      AssertThat(cache::size(), Is().GreaterThan(0u));
+
+      cache::set_limit(0u);
+      AssertThat(cache::size(), Is().EqualTo(0u));
+    });
+  });
+ });
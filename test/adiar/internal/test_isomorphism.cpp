@@ -690,6 +690,82 @@ go_bandit([]() {
           AssertThat(is_isomorphic(bdd_5_b, bdd_5_a, false, true), Is().False());
         });
       });
+
+      describe("Multi-threaded checks", [&]() {
+        // Same as bdd_5_a and bdd_5_b above, which have the same hash.
+        node_file bdd_a;
+        { node_writer w(bdd_a);
+          w << create_node(3,MAX_ID,   create_sink_ptr(false),      create_sink_ptr(true))
+            << create_node(3,MAX_ID-1, create_sink_ptr(true),       create_sink_ptr(false))
+            << create_node(2,MAX_ID,   create_node_ptr(3,MAX_ID-1), create_node_ptr(3,MAX_ID))
+            << create_node(2,MAX_ID-1, create_node_ptr(3,MAX_ID),   create_node_ptr(3,MAX_ID-1))
+            << create_node(1,MAX_ID,   create_node_ptr(2,MAX_ID-1), create_node_ptr(2,MAX_ID))
+            << create_node(0,MAX_ID,   create_node_ptr(2,MAX_ID-1), create_node_ptr(1,MAX_ID));
+        }
+
+        node_file bdd_a2;
+        { node_writer w(bdd_a2);
+          w << create_node(3,MAX_ID,   create_sink_ptr(false),      create_sink_ptr(true))
+            << create_node(3,MAX_ID-1, create_sink_ptr(true),       create_sink_ptr(false))
+            << create_node(2,MAX_ID,   create_node_ptr(3,MAX_ID-1), create_node_ptr(3,MAX_ID))
+            << create_node(2,MAX_ID-1, create_node_ptr(3,MAX_ID),   create_node_ptr(3,MAX_ID-1))
+            << create_node(1,MAX_ID,   create_node_ptr(2,MAX_ID-1), create_node_ptr(2,MAX_ID))
+            << create_node(0,MAX_ID,   create_node_ptr(2,MAX_ID-1), create_node_ptr(1,MAX_ID));
+        }
+
+        node_file bdd_b;
+        { node_writer w(bdd_b);
+          w << create_node(3,MAX_ID,   create_sink_ptr(false),      create_sink_ptr(true))
+            << create_node(3,MAX_ID-1, create_sink_ptr(true),       create_sink_ptr(false))
+            << create_node(2,MAX_ID,   create_node_ptr(3,MAX_ID-1), create_node_ptr(3,MAX_ID))
+            << create_node(2,MAX_ID-1, create_node_ptr(3,MAX_ID),   create_node_ptr(3,MAX_ID-1))
+            << create_node(1,MAX_ID,   create_node_ptr(2,MAX_ID),   create_node_ptr(2,MAX_ID-1))
+            << create_node(0,MAX_ID,   create_node_ptr(2,MAX_ID-1), create_node_ptr(1,MAX_ID));
+        }
+
+        // bdd_a with its sinks negated and (hence) the nodes on level x3 swapped
+        node_file bdd_an;
+        { node_writer w(bdd_an);
+          w << create_node(3,MAX_ID,   create_sink_ptr(true),       create_sink_ptr(false))
+            << create_node(3,MAX_ID-1, create_sink_ptr(false),      create_sink_ptr(true))
+            << create_node(2,MAX_ID,   create_node_ptr(3,MAX_ID),   create_node_ptr(3,MAX_ID-1))
+            << create_node(2,MAX_ID-1, create_node_ptr(3,MAX_ID-1), create_node_ptr(3,MAX_ID))
+            << create_node(1,MAX_ID,   create_node_ptr(2,MAX_ID-1), create_node_ptr(2,MAX_ID))
+            << create_node(0,MAX_ID,   create_node_ptr(2,MAX_ID-1), create_node_ptr(1,MAX_ID));
+        }
+
+        const size_t grain = parallel::get_grain();
+
+        before_each([&]() {
+          parallel::set_threads(4u);
+          parallel::set_grain(1u);
+        });
+
+        after_each([&]() {
+          parallel::set_threads(1u);
+          parallel::set_grain(grain);
+        });
+
+        it("accepts the same BDD in two files with level ranges compared in parallel", [&]() {
+          AssertThat(is_isomorphic(bdd_a, bdd_a2, false, false), Is().True());
+          AssertThat(is_isomorphic(bdd_a, bdd_a2, true, true), Is().True());
+        });
+
+        it("rejects on mismatch with level ranges compared in parallel", [&]() {
+          AssertThat(is_isomorphic(bdd_a, bdd_b, false, false), Is().False());
+          AssertThat(is_isomorphic(bdd_b, bdd_a2, true, true), Is().False());
+        });
+
+        it("accepts its negation of negated with inputs read ahead", [&]() {
+          AssertThat(is_isomorphic(bdd_a, bdd_an, true, false), Is().True());
+          AssertThat(is_isomorphic(bdd_an, bdd_a, true, false), Is().True());
+        });
+
+        it("rejects on mismatch with inputs read ahead", [&]() {
+          AssertThat(is_isomorphic(bdd_b, bdd_an, true, false), Is().False());
+          AssertThat(is_isomorphic(bdd_an, bdd_b, false, true), Is().False());
+        });
+      });
     });
   });
  });
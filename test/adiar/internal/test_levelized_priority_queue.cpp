@@ -3720,5 +3720,136 @@ go_bandit([]() {
         });
       });
     });
+    describe("levelized_priority_queue<...> with parallel sorting", [&]() {
+      it("pulls the buckets in sorted order", [&]() {
+        pq_test_file f;
+
+        { // Garbage collect the writer early
+          pq_test_writer fw(f);
+
+          fw.unsafe_push(create_level_info(3,1000u)); // bucket
+          fw.unsafe_push(create_level_info(2,1000u)); // bucket
+          fw.unsafe_push(create_level_info(1,1u));    // skipped
+        }
+
+        const size_t grain = parallel::get_grain();
+        parallel::set_threads(4u);
+        parallel::set_grain(1u);
+        parallel::set_sorting(true);
+
+        test_priority_queue<pq_test_file, 1> pq({f}, memory::available(), 2000);
+
+        // Push the nonces in a scrambled order
+        for (uint64_t i = 0u; i < 1000u; i++) {
+          pq.push(pq_test_data {2, (i * 7919u) % 1000u});
+          pq.push(pq_test_data {3, (i * 104729u) % 1000u});
+        }
+
+        for (label_t level = 2u; level <= 3u; level++) {
+          pq.setup_next_level();
+          AssertThat(pq.current_level(), Is().EqualTo(level));
+
+          for (uint64_t i = 0u; i < 1000u; i++) {
+            AssertThat(pq.can_pull(), Is().True());
+            AssertThat(pq.pull(), Is().EqualTo(pq_test_data {level, i}));
+          }
+          AssertThat(pq.can_pull(), Is().False());
+        }
+        AssertThat(pq.empty(), Is().True());
+
+        parallel::set_sorting(false);
+        parallel::set_threads(1u);
+        parallel::set_grain(grain);
+      });
+    });
+
+    describe("lpq_choose_lookahead(shape, max_buckets, max_lookahead)", [&]() {
+      const size_t unknown_cut = std::numeric_limits<size_t>::max();
+
+      it("looks a single level ahead for a shallow and wide input", [&]() {
+        AssertThat(lpq_choose_lookahead({ 4u, 64u, unknown_cut }, 16u, 8u), Is().EqualTo(1u));
+        AssertThat(lpq_choose_lookahead({ 4u, 8u, 4u }, 16u, 8u), Is().EqualTo(1u));
+      });
+
+      it("looks as many levels ahead as fits into memory for a deep input", [&]() {
+        AssertThat(lpq_choose_lookahead({ 64u, 128u, unknown_cut }, 4u, 8u), Is().EqualTo(3u));
+        AssertThat(lpq_choose_lookahead({ 64u, 128u, 8u }, 2u, 8u), Is().EqualTo(1u));
+        AssertThat(lpq_choose_lookahead({ 64u, 0u, unknown_cut }, 1u, 8u), Is().EqualTo(1u));
+      });
+
+      it("looks at most the maximum number of levels ahead", [&]() {
+        AssertThat(lpq_choose_lookahead({ 64u, 128u, 8u }, 100u, 8u), Is().EqualTo(8u));
+        AssertThat(lpq_choose_lookahead({ 64u, 128u, 8u }, 100u, 3u), Is().EqualTo(3u));
+      });
+
+      it("uses the fixed look-ahead (if it fits)", [&]() {
+        lpq::set_lookahead(2u);
+        AssertThat(lpq::get_lookahead(), Is().EqualTo(2u));
+
+        AssertThat(lpq_choose_lookahead({ 4u, 64u, unknown_cut }, 16u, 8u), Is().EqualTo(2u));
+        AssertThat(lpq_choose_lookahead({ 64u, 128u, 8u }, 100u, 8u), Is().EqualTo(2u));
+        AssertThat(lpq_choose_lookahead({ 64u, 128u, 8u }, 100u, 1u), Is().EqualTo(1u));
+        AssertThat(lpq_choose_lookahead({ 64u, 128u, 8u }, 2u, 8u), Is().EqualTo(1u));
+
+        lpq::set_lookahead();
+        AssertThat(lpq::get_lookahead(), Is().EqualTo(0u));
+      });
+    });
+
+    describe("levelized_priority_queue<..., LOOK_AHEAD=3> with a fixed look-ahead of 1", [&]() {
+      it("pulls elements beyond the look-ahead from the overflow queue", [&]() {
+        pq_test_file f;
+
+        { // Garbage collect the writer early
+          pq_test_writer fw(f);
+
+          fw.unsafe_push(create_level_info(5,1u));
+          fw.unsafe_push(create_level_info(4,1u));
+          fw.unsafe_push(create_level_info(3,1u));
+          fw.unsafe_push(create_level_info(2,1u));
+          fw.unsafe_push(create_level_info(1,1u)); // skipped
+        }
+
+        lpq::set_lookahead(1u);
+
+        test_priority_queue<pq_test_file, 3> pq({f}, memory::available(), 32);
+
+        pq.push(pq_test_data {5, 2});
+        pq.push(pq_test_data {4, 1});
+        pq.push(pq_test_data {2, 1});
+        pq.push(pq_test_data {5, 1});
+        pq.push(pq_test_data {3, 1});
+
+        AssertThat(pq.size(), Is().EqualTo(5u));
+
+        pq.setup_next_level();
+        AssertThat(pq.current_level(), Is().EqualTo(2u));
+        AssertThat(pq.pull(), Is().EqualTo(pq_test_data {2, 1}));
+        AssertThat(pq.can_pull(), Is().False());
+
+        pq.push(pq_test_data {4, 2});
+
+        pq.setup_next_level();
+        AssertThat(pq.current_level(), Is().EqualTo(3u));
+        AssertThat(pq.pull(), Is().EqualTo(pq_test_data {3, 1}));
+        AssertThat(pq.can_pull(), Is().False());
+
+        pq.setup_next_level();
+        AssertThat(pq.current_level(), Is().EqualTo(4u));
+        AssertThat(pq.pull(), Is().EqualTo(pq_test_data {4, 1}));
+        AssertThat(pq.pull(), Is().EqualTo(pq_test_data {4, 2}));
+        AssertThat(pq.can_pull(), Is().False());
+
+        pq.setup_next_level();
+        AssertThat(pq.current_level(), Is().EqualTo(5u));
+        AssertThat(pq.pull(), Is().EqualTo(pq_test_data {5, 1}));
+        AssertThat(pq.pull(), Is().EqualTo(pq_test_data {5, 2}));
+        AssertThat(pq.can_pull(), Is().False());
+
+        AssertThat(pq.empty(), Is().True());
+
+        lpq::set_lookahead();
+      });
+    });
   });
  });
@@ -0,0 +1,277 @@
+go_bandit([]() {
+  describe("adiar/internal/node_codec.h", []() {
+    describe("node_codec::encode / node_codec::decode", []() {
+      const auto roundtrip = [](const node_t &n, const uid_t prior) -> size_t {
+        uint8_t bytes[node_codec::MAX_NODE_BYTES];
+        const size_t len = node_codec::encode(bytes, n, prior);
+
+        const uint8_t *in = bytes;
+        const node_t out = node_codec::decode(in, prior);
+
+        AssertThat(out, Is().EqualTo(n));
+        AssertThat(static_cast<size_t>(in - bytes), Is().EqualTo(len));
+        return len;
+      };
+
+      it("encodes the first node of a level in few bytes", [&]() {
+        const node_t n = create_node(2, MAX_ID,
+                                     create_node_ptr(3, MAX_ID),
+                                     create_node_ptr(4, MAX_ID-1));
+
+        AssertThat(roundtrip(n, NIL), Is().LessThanOrEqualTo(8u));
+        AssertThat(roundtrip(n, create_node_uid(3, MAX_ID-5)), Is().LessThanOrEqualTo(8u));
+      });
+
+      it("encodes the next node on the same level in few bytes", [&]() {
+        const node_t n = create_node(2, MAX_ID-1,
+                                     create_sink_ptr(false),
+                                     create_node_ptr(3, MAX_ID-2));
+
+        AssertThat(roundtrip(n, create_node_uid(2, MAX_ID)), Is().LessThanOrEqualTo(5u));
+      });
+
+      it("encodes a sink node", [&]() {
+        roundtrip(create_sink(false), NIL);
+        roundtrip(create_sink(true), NIL);
+      });
+
+      it("encodes flagged children", [&]() {
+        roundtrip(create_node(0, 42, flag(create_node_ptr(1, 7)), flag(create_sink_ptr(true))), NIL);
+      });
+
+      it("encodes children with a lower label as is", [&]() {
+        roundtrip(create_node(5, MAX_ID, create_node_ptr(1, MAX_ID), create_sink_ptr(true)), NIL);
+      });
+
+      it("encodes the largest label and smallest id", [&]() {
+        roundtrip(create_node(MAX_LABEL, 0u, create_sink_ptr(false), create_sink_ptr(true)),
+                  create_node_uid(0, MAX_ID));
+      });
+    });
+
+    describe("node_codec::encode_uidless / node_codec::decode_uidless", []() {
+      const auto roundtrip = [](const node_t &n, const uid_t prior) -> size_t {
+        uint8_t bytes[node_codec::MAX_NODE_BYTES];
+        const size_t len = node_codec::encode_uidless(bytes, n, prior);
+
+        const uint8_t *in = bytes;
+        const node_t out = node_codec::decode_uidless(in, prior);
+
+        AssertThat(out, Is().EqualTo(n));
+        AssertThat(static_cast<size_t>(in - bytes), Is().EqualTo(len));
+        return len;
+      };
+
+      it("identifies whether a uid follows from the prior one", [&]() {
+        const ptr_t s = create_sink_ptr(false);
+
+        AssertThat(node_codec::follows(create_node_uid(2, MAX_ID),
+                                       create_node(2, MAX_ID-1, s, s)), Is().True());
+        AssertThat(node_codec::follows(create_node_uid(2, MAX_ID-4),
+                                       create_node(1, MAX_ID, s, s)), Is().True());
+
+        AssertThat(node_codec::follows(create_node_uid(2, MAX_ID),
+                                       create_node(2, MAX_ID-2, s, s)), Is().False());
+        AssertThat(node_codec::follows(create_node_uid(2, MAX_ID),
+                                       create_node(1, MAX_ID-1, s, s)), Is().False());
+        AssertThat(node_codec::follows(create_node_uid(2, MAX_ID),
+                                       create_node(3, MAX_ID, s, s)), Is().False());
+        AssertThat(node_codec::follows(NIL, create_node(2, MAX_ID, s, s)), Is().False());
+      });
+
+      it("encodes the next node on the same level without its uid", [&]() {
+        const node_t n = create_node(2, MAX_ID-1,
+                                     create_sink_ptr(false),
+                                     create_node_ptr(3, MAX_ID-2));
+
+        AssertThat(roundtrip(n, create_node_uid(2, MAX_ID)), Is().LessThanOrEqualTo(3u));
+      });
+
+      it("encodes the first node of the next level", [&]() {
+        const node_t n = create_node(2, MAX_ID,
+                                     create_node_ptr(3, MAX_ID),
+                                     create_node_ptr(4, MAX_ID-1));
+
+        AssertThat(roundtrip(n, create_node_uid(3, MAX_ID-5)), Is().LessThanOrEqualTo(5u));
+        roundtrip(n, create_node_uid(MAX_LABEL, 0u));
+      });
+
+      it("encodes flagged and raw children", [&]() {
+        roundtrip(create_node(0, 41, flag(create_node_ptr(1, 7)), flag(create_sink_ptr(true))),
+                  create_node_uid(0, 42));
+        roundtrip(create_node(5, MAX_ID, create_node_ptr(1, MAX_ID), NIL),
+                  create_node_uid(6, 0u));
+      });
+    });
+
+    describe("__encoded_node_stream", []() {
+      const label_t levels = 10u;
+      const size_t width = 300u;
+
+      // Each level has 'width' nodes, all pointing to the next level.
+      std::vector<node_t> nodes;
+      for (label_t l = levels; 0u < l; l--) {
+        const label_t label = l - 1u;
+        for (size_t i = 0u; i < width; i++) {
+          const ptr_t low = label + 1u == levels
+            ? create_sink_ptr(false)
+            : create_node_ptr(label + 1u, MAX_ID - (i % width));
+          const ptr_t high = label + 1u == levels
+            ? create_sink_ptr(true)
+            : create_node_ptr(label + 1u, MAX_ID - ((i + 1u) % width));
+
+          nodes.push_back(create_node(label, MAX_ID - i, low, high));
+        }
+      }
+
+      node_file nf;
+      nf._file_ptr -> set_internal_capacity(0u);
+      {
+        node_writer nw(nf);
+        for (const node_t &n : nodes) { nw << n; }
+      }
+
+      it("stores the nodes on disk", [&]() {
+        AssertThat(nf._file_ptr -> _files[0].is_on_disk(), Is().True());
+        AssertThat(nf.size(), Is().EqualTo(nodes.size()));
+        AssertThat(nf.meta_size(), Is().EqualTo(levels));
+      });
+
+      it("takes at most half of the bytes of the raw nodes", [&]() {
+        tpie::file_stream<uint64_t> fs;
+        tpie::temp_file tf = nf._file_ptr -> _files[0].get_tpie_file();
+        fs.open(tf, ADIAR_READ_ACCESS);
+
+        const size_t bytes = fs.size() * sizeof(uint64_t);
+        AssertThat(2u * bytes, Is().LessThanOrEqualTo(nodes.size() * sizeof(node_t)));
+      });
+
+      it("reads the nodes top-down", [&]() {
+        node_stream<> ns(nf);
+
+        for (size_t i = nodes.size(); 0u < i; i--) {
+          AssertThat(ns.can_pull(), Is().True());
+          AssertThat(ns.pull(), Is().EqualTo(nodes[i-1u]));
+        }
+        AssertThat(ns.can_pull(), Is().False());
+      });
+
+      it("reads the nodes bottom-up", [&]() {
+        node_stream<true> ns(nf);
+
+        for (size_t i = 0u; i < nodes.size(); i++) {
+          AssertThat(ns.can_pull(), Is().True());
+          AssertThat(ns.pull(), Is().EqualTo(nodes[i]));
+        }
+        AssertThat(ns.can_pull(), Is().False());
+      });
+
+      it("can seek to any node", [&]() {
+        node_stream<true> ns(nf);
+
+        for (const size_t idx : { 2999u, 0u, 1500u, 511u, 512u, 42u }) {
+          ns.seek(idx);
+          AssertThat(ns.pull(), Is().EqualTo(nodes[idx]));
+        }
+      });
+
+      // The same nodes, except for a gap in the ids of the first level of the
+      // second half of the file.
+      std::vector<node_t> gap_nodes(nodes);
+      for (size_t i = nodes.size() / 2u; i < nodes.size(); i++) {
+        const node_t &n = nodes[i];
+        gap_nodes[i] = create_node(label_of(n), id_of(n) - (label_of(n) == 4u), n.low, n.high);
+      }
+
+      node_file gap_nf;
+      gap_nf._file_ptr -> set_internal_capacity(0u);
+      {
+        node_writer nw(gap_nf);
+        for (const node_t &n : gap_nodes) { nw << n; }
+      }
+
+      it("stores the uids of nodes after a gap in the ids", [&]() {
+        tpie::file_stream<uint64_t> fs;
+
+        tpie::temp_file tf = nf._file_ptr -> _files[0].get_tpie_file();
+        fs.open(tf, ADIAR_READ_ACCESS);
+        const size_t bytes = fs.size();
+        fs.close();
+
+        tpie::temp_file gap_tf = gap_nf._file_ptr -> _files[0].get_tpie_file();
+        fs.open(gap_tf, ADIAR_READ_ACCESS);
+        const size_t gap_bytes = fs.size();
+        fs.close();
+
+        AssertThat(bytes, Is().LessThan(gap_bytes));
+      });
+
+      it("reads the nodes before and after a gap in the ids", [&]() {
+        node_stream<true> ns(gap_nf);
+
+        for (size_t i = 0u; i < gap_nodes.size(); i++) {
+          AssertThat(ns.can_pull(), Is().True());
+          AssertThat(ns.pull(), Is().EqualTo(gap_nodes[i]));
+        }
+        AssertThat(ns.can_pull(), Is().False());
+      });
+    });
+
+    describe("__encoded_node_stream::sort", []() {
+      // 1000 nodes on 10 levels, pushed with their levels and ids shuffled.
+      std::vector<node_t> nodes;
+      for (size_t i = 0u; i < 1000u; i++) {
+        const size_t j = (i * 389u) % 1000u;
+        nodes.push_back(create_node(j % 10u, MAX_ID - (j / 10u),
+                                    create_sink_ptr(false),
+                                    create_node_ptr(10u, MAX_ID - (j % 7u))));
+      }
+
+      std::vector<node_t> sorted(nodes);
+      std::sort(sorted.begin(), sorted.end(), std::greater<node_t>());
+
+      const auto write_nodes = [&](simple_file_writer<node_t> &fw) {
+        for (const node_t &n : nodes) { fw << n; }
+      };
+
+      const auto check_file = [&](simple_file<node_t> &f) {
+        AssertThat(f._file_ptr -> is_on_disk(), Is().True());
+
+        file_stream<node_t> fs(f);
+        for (const node_t &n : sorted) {
+          AssertThat(fs.can_pull(), Is().True());
+          AssertThat(fs.pull(), Is().EqualTo(n));
+        }
+        AssertThat(fs.can_pull(), Is().False());
+      };
+
+      it("sorts a node file on disk with simple_file_sorter", [&]() {
+        simple_file<node_t> f;
+        f._file_ptr -> set_internal_capacity(0u);
+        {
+          simple_file_writer<node_t> fw(f);
+          write_nodes(fw);
+        }
+
+        simple_file_sorter<node_t, std::greater<node_t>>::sort(f);
+        check_file(f);
+      });
+
+      it("sorts a node file on disk with its writer", [&]() {
+        simple_file<node_t> f;
+        f._file_ptr -> set_internal_capacity(0u);
+        {
+          simple_file_writer<node_t> fw(f);
+          write_nodes(fw);
+          fw.sort<std::greater<node_t>>();
+
+          // Nodes can still be appended after sorting.
+          fw << create_node(0, 0u, create_sink_ptr(false), create_sink_ptr(true));
+        }
+        sorted.push_back(create_node(0, 0u, create_sink_ptr(false), create_sink_ptr(true)));
+        check_file(f);
+        sorted.pop_back();
+      });
+    });
+  });
+ });
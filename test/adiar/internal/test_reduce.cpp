@@ -1775,5 +1775,137 @@ go_bandit([]() {
         AssertThat(out.file_ptr()->number_of_sinks[1], Is().EqualTo(1u));
       });
     });
+
+    describe("Multi-threaded Reduce", [&]() {
+      // Reduce the same input single-threaded and multi-threaded, where the
+      // output of the latter has to be identical to the former.
+      const auto assert_same_as_single_threaded = [&](const arc_file &in) {
+        bdd expected = reduce<bdd_policy>(in);
+
+        const size_t grain = parallel::get_grain();
+        parallel::set_threads(4u);
+        parallel::set_grain(1u);
+
+        bdd out = reduce<bdd_policy>(in);
+
+        parallel::set_threads(1u);
+        parallel::set_grain(grain);
+
+        AssertThat(is_canonical(out), Is().True());
+
+        node_test_stream expected_nodes(expected);
+        node_test_stream out_nodes(out);
+
+        while (expected_nodes.can_pull()) {
+          AssertThat(out_nodes.can_pull(), Is().True());
+          AssertThat(out_nodes.pull(), Is().EqualTo(expected_nodes.pull()));
+        }
+        AssertThat(out_nodes.can_pull(), Is().False());
+
+        level_info_test_stream<node_t> expected_meta(expected);
+        level_info_test_stream<node_t> out_meta(out);
+
+        while (expected_meta.can_pull()) {
+          AssertThat(out_meta.can_pull(), Is().True());
+          AssertThat(out_meta.pull(), Is().EqualTo(expected_meta.pull()));
+        }
+        AssertThat(out_meta.can_pull(), Is().False());
+
+        AssertThat(out.file_ptr()->number_of_sinks[0],
+                   Is().EqualTo(expected.file_ptr()->number_of_sinks[0]));
+        AssertThat(out.file_ptr()->number_of_sinks[1],
+                   Is().EqualTo(expected.file_ptr()->number_of_sinks[1]));
+      };
+
+      it("applies Reduction Rule 2 to 'disjoint' branches", [&]() {
+        ptr_t n1 = create_node_ptr(0,0);
+        ptr_t n2 = create_node_ptr(1,0);
+        ptr_t n3 = create_node_ptr(1,1);
+        ptr_t n4 = create_node_ptr(2,0);
+        ptr_t n5 = create_node_ptr(2,1);
+        ptr_t n6 = create_node_ptr(2,2);
+        ptr_t n7 = create_node_ptr(3,0);
+
+        arc_file in;
+
+        { // Garbage collect writer to free write-lock
+          arc_writer aw(in);
+
+          aw.unsafe_push_node({ n1,n2 });
+          aw.unsafe_push_node({ flag(n1),n3 });
+          aw.unsafe_push_node({ n2,n4 });
+          aw.unsafe_push_node({ flag(n2),n5 });
+          aw.unsafe_push_node({ n3,n5 });
+          aw.unsafe_push_node({ flag(n3),n6 });
+          aw.unsafe_push_node({ n5,n7 });
+
+          aw.unsafe_push_sink({ n4,sink_F });
+          aw.unsafe_push_sink({ flag(n4),sink_T });
+          aw.unsafe_push_sink({ flag(n5),sink_T });
+          aw.unsafe_push_sink({ n6,sink_F });
+          aw.unsafe_push_sink({ flag(n6),sink_T });
+          aw.unsafe_push_sink({ n7,sink_F });
+          aw.unsafe_push_sink({ flag(n7),sink_T });
+
+          aw.unsafe_push(create_level_info(0,1u));
+          aw.unsafe_push(create_level_info(1,2u));
+          aw.unsafe_push(create_level_info(2,3u));
+          aw.unsafe_push(create_level_info(3,1u));
+        }
+
+        in._file_ptr->max_1level_cut = 4;
+
+        assert_same_as_single_threaded(in);
+      });
+
+      it("applies Reduction Rule 1 and 2 on the same level", [&]() {
+        /*
+                     1                       1          ---- x0
+                   /   \                    / \
+                  2     3                  |   3        ---- x1
+                 / \   / \       =>        |  / \
+                 4 5   6 7                 4  T 7       ---- x2
+                / \|\ / \|\               / \   / \
+                F  T  T T F               F T   T F
+        */
+        ptr_t n1 = create_node_ptr(0,0);
+        ptr_t n2 = create_node_ptr(1,0);
+        ptr_t n3 = create_node_ptr(1,1);
+        ptr_t n4 = create_node_ptr(2,0);
+        ptr_t n5 = create_node_ptr(2,1);
+        ptr_t n6 = create_node_ptr(2,2);
+        ptr_t n7 = create_node_ptr(2,3);
+
+        arc_file in;
+
+        { // Garbage collect writer to free write-lock
+          arc_writer aw(in);
+
+          aw.unsafe_push_node({ n1,n2 });
+          aw.unsafe_push_node({ flag(n1),n3 });
+          aw.unsafe_push_node({ n2,n4 });
+          aw.unsafe_push_node({ flag(n2),n5 });
+          aw.unsafe_push_node({ n3,n6 });
+          aw.unsafe_push_node({ flag(n3),n7 });
+
+          aw.unsafe_push_sink({ n4,sink_F });
+          aw.unsafe_push_sink({ flag(n4),sink_T });
+          aw.unsafe_push_sink({ n5,sink_F });
+          aw.unsafe_push_sink({ flag(n5),sink_T });
+          aw.unsafe_push_sink({ n6,sink_T });
+          aw.unsafe_push_sink({ flag(n6),sink_T });
+          aw.unsafe_push_sink({ n7,sink_T });
+          aw.unsafe_push_sink({ flag(n7),sink_F });
+
+          aw.unsafe_push(create_level_info(0,1u));
+          aw.unsafe_push(create_level_info(1,2u));
+          aw.unsafe_push(create_level_info(2,4u));
+        }
+
+        in._file_ptr->max_1level_cut = 4;
+
+        assert_same_as_single_threaded(in);
+      });
+    });
   });
  });
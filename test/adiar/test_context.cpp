@@ -0,0 +1,110 @@
+#include <filesystem>
+#include <thread>
+
+#include <adiar/internal/memory.h>
+#include <adiar/internal/parallel.h>
+
+go_bandit([]() {
+  describe("adiar/context.h", [&]() {
+    const size_t MiB = 1024 * 1024;
+
+    it("has the given memory limit and directory", [&]() {
+      adiar_context ctx(64 * MiB);
+
+      AssertThat(adiar_initialized(), Is().True());
+      AssertThat(ctx.memory_limit(), Is().EqualTo(64 * MiB));
+      AssertThat(ctx.temp_dir(), Is().EqualTo(""));
+    });
+
+    it("limits the memory available to operations run within it", [&]() {
+      adiar_context ctx(64 * MiB);
+
+      const size_t available = ctx.run([]() { return memory::available(); });
+      AssertThat(available, Is().LessThanOrEqualTo(64 * MiB));
+
+      AssertThat(memory::available(), Is().GreaterThan(64 * MiB));
+    });
+
+    it("places temporary files within its directory", [&]() {
+      const std::string dir = "adiar_context_test";
+      {
+        adiar_context ctx(64 * MiB, dir);
+        AssertThat(std::filesystem::is_directory(dir), Is().True());
+
+        ctx.run([]() {
+          simple_file<int> f;
+          f._file_ptr -> set_internal_capacity(0u);
+          {
+            simple_file_writer<int> fw(f);
+            fw << 42;
+          }
+
+          AssertThat(f._file_ptr -> is_on_disk(), Is().True());
+          AssertThat(std::filesystem::is_empty(memory::_context_path), Is().False());
+        });
+      }
+      std::filesystem::remove_all(dir);
+    });
+
+    it("can nest the same context", [&]() {
+      adiar_context ctx(64 * MiB);
+
+      const bool nested = ctx.run([&]() {
+        return ctx.run([]() { return memory::_context_limit == 64 * MiB; });
+      });
+      AssertThat(nested, Is().True());
+      AssertThat(memory::_context_limit, Is().EqualTo(0u));
+    });
+
+    it("propagates its budget and directory to threads started within it", [&]() {
+      const std::string dir = "adiar_context_test";
+      {
+        adiar_context ctx(64 * MiB, dir);
+
+        std::vector<size_t> limits(4u, 0u);
+        std::vector<std::string> paths(4u);
+
+        ctx.run([&]() {
+          parallel::for_each_chunk(4u, 4u, [&](size_t chunk, size_t, size_t) {
+            limits[chunk] = memory::_context_limit;
+            paths[chunk] = memory::_context_path;
+          });
+        });
+
+        for (size_t chunk = 0u; chunk < 4u; chunk++) {
+          AssertThat(limits[chunk], Is().EqualTo(64 * MiB));
+          AssertThat(paths[chunk], Is().EqualTo(dir));
+        }
+      }
+      std::filesystem::remove_all(dir);
+    });
+
+    it("runs independent jobs concurrently on separate threads", [&]() {
+      adiar_context ctx_1(64 * MiB);
+      adiar_context ctx_2(64 * MiB);
+
+      uint64_t res_1 = 0u;
+      uint64_t res_2 = 0u;
+
+      std::thread t_1([&]() {
+        res_1 = ctx_1.run([]() {
+          bdd f = bdd_counter(0, 9, 5);
+          return bdd_satcount(f);
+        });
+      });
+
+      std::thread t_2([&]() {
+        res_2 = ctx_2.run([]() {
+          bdd f = bdd_xor(bdd_ithvar(0), bdd_ithvar(1));
+          return bdd_satcount(f, 2);
+        });
+      });
+
+      t_1.join();
+      t_2.join();
+
+      AssertThat(res_1, Is().EqualTo(252u));
+      AssertThat(res_2, Is().EqualTo(2u));
+    });
+  });
+ });
@@ -427,6 +427,54 @@ go_bandit([]() {
           AssertThat(is_commutative(diff_op), Is().False());
           AssertThat(is_commutative(diff_op), Is().False());
         });
+
+        describe("bool_op_dispatch", []() {
+          // Name of the type the function is called with
+          const auto type_of = [](const bool_op &op) {
+            return bool_op_dispatch(op, [](const auto &static_op) {
+              return std::string(typeid(static_op).name());
+            });
+          };
+
+          it("resolves the predefined operators to their type", [&]() {
+            AssertThat(type_of(and_op), Is().EqualTo(std::string(typeid(and_op_t).name())));
+            AssertThat(type_of(nand_op), Is().EqualTo(std::string(typeid(nand_op_t).name())));
+            AssertThat(type_of(or_op), Is().EqualTo(std::string(typeid(or_op_t).name())));
+            AssertThat(type_of(nor_op), Is().EqualTo(std::string(typeid(nor_op_t).name())));
+            AssertThat(type_of(xor_op), Is().EqualTo(std::string(typeid(xor_op_t).name())));
+            AssertThat(type_of(xnor_op), Is().EqualTo(std::string(typeid(xnor_op_t).name())));
+            AssertThat(type_of(imp_op), Is().EqualTo(std::string(typeid(imp_op_t).name())));
+            AssertThat(type_of(invimp_op), Is().EqualTo(std::string(typeid(invimp_op_t).name())));
+            AssertThat(type_of(equiv_op), Is().EqualTo(std::string(typeid(xnor_op_t).name())));
+            AssertThat(type_of(diff_op), Is().EqualTo(std::string(typeid(diff_op_t).name())));
+            AssertThat(type_of(less_op), Is().EqualTo(std::string(typeid(less_op_t).name())));
+          });
+
+          it("falls back to the bool_op for any other operator", [&]() {
+            const bool_op fst_op = [](ptr_t sink1, ptr_t /*sink2*/) -> ptr_t { return sink1; };
+
+            AssertThat(type_of(fst_op), Is().EqualTo(std::string(typeid(bool_op).name())));
+          });
+
+          it("agrees with the bool_op on all sinks", [&]() {
+            const ptr_t sinks[2] = { create_sink_ptr(false), create_sink_ptr(true) };
+
+            for (const ptr_t s1 : sinks) {
+              for (const ptr_t s2 : sinks) {
+                AssertThat(and_op_t()(s1, s2), Is().EqualTo(and_op(s1, s2)));
+                AssertThat(nand_op_t()(s1, s2), Is().EqualTo(nand_op(s1, s2)));
+                AssertThat(or_op_t()(s1, s2), Is().EqualTo(or_op(s1, s2)));
+                AssertThat(nor_op_t()(s1, s2), Is().EqualTo(nor_op(s1, s2)));
+                AssertThat(xor_op_t()(s1, s2), Is().EqualTo(xor_op(s1, s2)));
+                AssertThat(xnor_op_t()(s1, s2), Is().EqualTo(xnor_op(s1, s2)));
+                AssertThat(imp_op_t()(s1, s2), Is().EqualTo(imp_op(s1, s2)));
+                AssertThat(invimp_op_t()(s1, s2), Is().EqualTo(invimp_op(s1, s2)));
+                AssertThat(diff_op_t()(s1, s2), Is().EqualTo(diff_op(s1, s2)));
+                AssertThat(less_op_t()(s1, s2), Is().EqualTo(less_op(s1, s2)));
+              }
+            }
+          });
+        });
       });
     });
 
@@ -57,6 +57,138 @@ go_bandit([]() {
     arc_t sink_arc_3 = { flag(create_node_ptr(1,0)), create_sink_ptr(false) };
 
     describe("adiar/file_writer", [&]() {
+      describe("__file_appender", [&]() {
+        it("keeps a small temporary file in internal memory", [&]() {
+          simple_file<int> f;
+
+          {
+            simple_file_writer<int> fw(f);
+            fw << 1 << 2 << 3;
+          }
+
+          AssertThat(f._file_ptr -> is_on_disk(), Is().False());
+          AssertThat(f.size(), Is().EqualTo(3u));
+        });
+
+        it("spills a temporary file to disk when it outgrows the threshold", [&]() {
+          const size_t threshold = memory::get_internal_file_threshold();
+          memory::set_internal_file_threshold(2u * sizeof(int));
+
+          simple_file<int> f;
+
+          {
+            simple_file_writer<int> fw(f);
+            fw << 1 << 2;
+            AssertThat(f._file_ptr -> is_on_disk(), Is().False());
+
+            fw << 3;
+            AssertThat(f._file_ptr -> is_on_disk(), Is().True());
+
+            fw << 4;
+          }
+
+          memory::set_internal_file_threshold(threshold);
+
+          AssertThat(f.size(), Is().EqualTo(4u));
+
+          file_stream<int, false> fs(f);
+
+          AssertThat(fs.pull(), Is().EqualTo(1));
+          AssertThat(fs.pull(), Is().EqualTo(2));
+          AssertThat(fs.pull(), Is().EqualTo(3));
+          AssertThat(fs.pull(), Is().EqualTo(4));
+          AssertThat(fs.can_pull(), Is().False());
+        });
+
+        it("places a temporary file on disk with a public threshold of 0", [&]() {
+          const size_t threshold = memory::get_internal_file_threshold();
+          adiar_set_internal_file_threshold(0u);
+
+          AssertThat(memory::get_internal_file_threshold(), Is().EqualTo(0u));
+
+          simple_file<int> f;
+
+          {
+            simple_file_writer<int> fw(f);
+            fw << 1;
+          }
+
+          adiar_set_internal_file_threshold(threshold);
+
+          AssertThat(f._file_ptr -> is_on_disk(), Is().True());
+          AssertThat(f.size(), Is().EqualTo(1u));
+        });
+
+        it("keeps a file in internal memory up to its given capacity", [&]() {
+          const size_t threshold = memory::get_internal_file_threshold();
+          memory::set_internal_file_threshold(0u);
+
+          simple_file<int> f;
+          AssertThat(f._file_ptr -> is_on_disk(), Is().True());
+
+          f._file_ptr -> set_internal_capacity(3u * sizeof(int));
+          AssertThat(f._file_ptr -> is_on_disk(), Is().False());
+
+          memory::set_internal_file_threshold(threshold);
+
+          {
+            simple_file_writer<int> fw(f);
+            fw << 1 << 2 << 3;
+            AssertThat(f._file_ptr -> is_on_disk(), Is().False());
+
+            fw << 4;
+            AssertThat(f._file_ptr -> is_on_disk(), Is().True());
+          }
+
+          AssertThat(f.size(), Is().EqualTo(4u));
+        });
+
+        it("does not allocate more than its capacity in internal memory", [&]() {
+          simple_file<int> f;
+          f._file_ptr -> set_internal_capacity(37u * sizeof(int));
+
+          {
+            simple_file_writer<int> fw(f);
+            for (int i = 0; i < 37; i++) { fw << i; }
+          }
+
+          f.make_read_only();
+          AssertThat(f._file_ptr -> is_on_disk(), Is().False());
+          AssertThat(f._file_ptr -> view() -> capacity(), Is().LessThanOrEqualTo(37u));
+        });
+
+        it("spills a node_file to disk when it outgrows the threshold", [&]() {
+          const size_t threshold = memory::get_internal_file_threshold();
+          memory::set_internal_file_threshold(sizeof(node_t));
+
+          node_file nf;
+
+          {
+            node_writer nw(nf);
+            nw << create_node(1, MAX_ID, create_sink_ptr(false), create_sink_ptr(true))
+               << create_node(0, MAX_ID, create_sink_ptr(false), create_node_ptr(1, MAX_ID));
+          }
+
+          memory::set_internal_file_threshold(threshold);
+
+          AssertThat(nf._file_ptr -> _files[0].is_on_disk(), Is().True());
+
+          AssertThat(nf.size(), Is().EqualTo(2u));
+          AssertThat(nf.meta_size(), Is().EqualTo(2u));
+          AssertThat(nf._file_ptr -> canonical, Is().True());
+
+          node_stream<> ns(nf);
+
+          AssertThat(ns.pull(), Is().EqualTo(create_node(0, MAX_ID,
+                                                         create_sink_ptr(false),
+                                                         create_node_ptr(1, MAX_ID))));
+          AssertThat(ns.pull(), Is().EqualTo(create_node(1, MAX_ID,
+                                                         create_sink_ptr(false),
+                                                         create_sink_ptr(true))));
+          AssertThat(ns.can_pull(), Is().False());
+        });
+      });
+
       describe("simple_file_writer", [&]() {
         it("can hook into and write to test_file_simple", [&]() {
           AssertThat(test_file_simple.is_read_only(), Is().False());
@@ -216,6 +348,106 @@ go_bandit([]() {
 
             AssertThat(is_canonical(nf), Is().False());
           });
+
+          it("derives the same hash independent of the identifiers and order", [&]() {
+            node_file nf1;
+            {
+              node_writer nw(nf1);
+              nw << create_node(42, MAX_ID, create_sink_ptr(false), create_sink_ptr(true))
+                 << create_node(42, MAX_ID-1, create_sink_ptr(true), create_sink_ptr(false))
+                 << create_node(21, MAX_ID, create_node_ptr(42, MAX_ID), create_node_ptr(42, MAX_ID-1));
+            }
+
+            node_file nf2;
+            {
+              node_writer nw(nf2);
+              nw << create_node(42, 7, create_sink_ptr(true), create_sink_ptr(false))
+                 << create_node(42, 3, create_sink_ptr(false), create_sink_ptr(true))
+                 << create_node(21, 0, create_node_ptr(42, 3), create_node_ptr(42, 7));
+            }
+
+            AssertThat(nf1._file_ptr -> hash[false], Is().EqualTo(nf2._file_ptr -> hash[false]));
+            AssertThat(nf1._file_ptr -> hash[true], Is().EqualTo(nf2._file_ptr -> hash[true]));
+          });
+
+          it("derives the hash of the negated nodes", [&]() {
+            node_file nf1;
+            {
+              node_writer nw(nf1);
+              nw << create_node(42, MAX_ID, create_sink_ptr(false), create_sink_ptr(true));
+            }
+
+            node_file nf2;
+            {
+              node_writer nw(nf2);
+              nw << create_node(42, MAX_ID, create_sink_ptr(true), create_sink_ptr(false));
+            }
+
+            AssertThat(nf1._file_ptr -> hash[false], Is().Not().EqualTo(nf2._file_ptr -> hash[false]));
+            AssertThat(nf1._file_ptr -> hash[false], Is().EqualTo(nf2._file_ptr -> hash[true]));
+            AssertThat(nf1._file_ptr -> hash[true], Is().EqualTo(nf2._file_ptr -> hash[false]));
+          });
+
+          it("derives different hashes for different sinks", [&]() {
+            node_file nf_F;
+            {
+              node_writer nw(nf_F);
+              nw << create_sink(false);
+            }
+
+            node_file nf_T;
+            {
+              node_writer nw(nf_T);
+              nw << create_sink(true);
+            }
+
+            AssertThat(nf_F._file_ptr -> hash[false], Is().Not().EqualTo(nf_T._file_ptr -> hash[false]));
+            AssertThat(nf_F._file_ptr -> hash[true], Is().EqualTo(nf_T._file_ptr -> hash[false]));
+          });
+
+          it("derives different hashes for the same labels with other children", [&]() {
+            node_file nf1;
+            {
+              node_writer nw(nf1);
+              nw << create_node(42, MAX_ID, create_sink_ptr(false), create_sink_ptr(true))
+                 << create_node(42, MAX_ID-1, create_sink_ptr(true), create_sink_ptr(false))
+                 << create_node(21, MAX_ID, create_node_ptr(42, MAX_ID), create_node_ptr(42, MAX_ID-1));
+            }
+
+            node_file nf2;
+            {
+              node_writer nw(nf2);
+              nw << create_node(42, MAX_ID, create_sink_ptr(false), create_sink_ptr(true))
+                 << create_node(42, MAX_ID-1, create_sink_ptr(true), create_sink_ptr(false))
+                 << create_node(21, MAX_ID, create_node_ptr(42, MAX_ID-1), create_node_ptr(42, MAX_ID));
+            }
+
+            AssertThat(nf1._file_ptr -> hash[false], Is().Not().EqualTo(nf2._file_ptr -> hash[false]));
+            AssertThat(nf1._file_ptr -> hash[true], Is().EqualTo(nf2._file_ptr -> hash[false]));
+          });
+
+          it("uses the hash given with a node", [&]() {
+            const node_hash h_low = hash_of_sink(false);
+            const node_hash h_high = hash_of_sink(true);
+            const node_hash h = hash_of_node(42, h_low, h_high);
+
+            node_file nf1;
+            {
+              node_writer nw(nf1);
+              nw.unsafe_push(create_node(42, MAX_ID, create_sink_ptr(false), create_sink_ptr(true)), h);
+              nw.unsafe_push(create_level_info(42, 1u));
+            }
+
+            node_file nf2;
+            {
+              node_writer nw(nf2);
+              nw << create_node(42, MAX_ID, create_sink_ptr(false), create_sink_ptr(true));
+            }
+
+            AssertThat(nf1._file_ptr -> hash[false], Is().EqualTo(h.value[false]));
+            AssertThat(nf1._file_ptr -> hash[true], Is().EqualTo(h.value[true]));
+            AssertThat(nf2._file_ptr -> hash[false], Is().EqualTo(h.value[false]));
+          });
         });
 
         describe("arc_writer", [&]() {
@@ -237,6 +469,24 @@ go_bandit([]() {
             aw.unsafe_push_sink(sink_arc_1);
             aw.unsafe_push_sink(sink_arc_2);
           });
+
+          it("only gives the level information room for the given levels", [&]() {
+            arc_file af;
+            af._file_ptr -> set_internal_capacity(128u * sizeof(arc_t), 2u);
+
+            // An equal split of the capacity would only leave room for 32 arcs
+            // in each file.
+            {
+              arc_writer af_writer(af);
+              for (id_t id = 0u; id < 40u; id++) {
+                af_writer.unsafe_push_node({ create_node_ptr(0, 0), create_node_ptr(1, id) });
+              }
+              af_writer.unsafe_push(create_level_info(1, 40u));
+              af_writer.unsafe_push(create_level_info(0, 1u));
+            }
+
+            AssertThat(af._file_ptr -> is_on_disk(), Is().False());
+          });
         });
       });
     });
@@ -306,6 +556,151 @@ go_bandit([]() {
           AssertThat(fs.can_pull(), Is().True());
           AssertThat(fs.pull(), Is().EqualTo(21));
         });
+
+        it("shares an in-memory copy of a small file between streams", [&]() {
+          simple_file<int> f;
+
+          { // Garbage collect the writer to detach it
+            simple_file_writer<int> fw(f);
+            fw << 1 << 2 << 3;
+          }
+
+          file_stream<int, false> fs_1(f);
+          file_stream<int, true> fs_2(f);
+
+          AssertThat(f._file_ptr -> view() == nullptr, Is().False());
+          AssertThat(f._file_ptr -> view() -> size(), Is().EqualTo(3u));
+
+          AssertThat(fs_1.pull(), Is().EqualTo(1));
+          AssertThat(fs_2.pull(), Is().EqualTo(3));
+          AssertThat(fs_1.peek(), Is().EqualTo(2));
+          AssertThat(fs_2.peek(), Is().EqualTo(2));
+          AssertThat(fs_1.pull(), Is().EqualTo(2));
+          AssertThat(fs_2.pull(), Is().EqualTo(2));
+          AssertThat(fs_1.pull(), Is().EqualTo(3));
+          AssertThat(fs_2.pull(), Is().EqualTo(1));
+          AssertThat(fs_1.can_pull(), Is().False());
+          AssertThat(fs_2.can_pull(), Is().False());
+
+          fs_1.reset();
+          AssertThat(fs_1.can_pull(), Is().True());
+          AssertThat(fs_1.pull(), Is().EqualTo(1));
+        });
+
+        it("reads from disk when the file is above the threshold", [&]() {
+          const size_t threshold = memory::get_internal_file_threshold();
+          memory::set_internal_file_threshold(0u);
+
+          simple_file<int> f;
+
+          { // Garbage collect the writer to detach it
+            simple_file_writer<int> fw(f);
+            fw << 1 << 2;
+          }
+
+          file_stream<int, true> fs(f);
+
+          AssertThat(f._file_ptr -> view() == nullptr, Is().True());
+
+          AssertThat(fs.can_pull(), Is().True());
+          AssertThat(fs.pull(), Is().EqualTo(2));
+          AssertThat(fs.can_pull(), Is().True());
+          AssertThat(fs.pull(), Is().EqualTo(1));
+          AssertThat(fs.can_pull(), Is().False());
+
+          memory::set_internal_file_threshold(threshold);
+        });
+
+        it("drops the in-memory copy when the file is made writeable", [&]() {
+          simple_file<int> f;
+
+          {
+            simple_file_writer<int> fw(f);
+            fw << 1;
+          }
+
+          { file_stream<int, false> fs(f); }
+          AssertThat(f._file_ptr -> view() -> size(), Is().EqualTo(1u));
+
+          f.make_writeable();
+
+          {
+            simple_file_writer<int> fw(f);
+            fw << 2;
+          }
+
+          file_stream<int, false> fs(f);
+
+          AssertThat(f._file_ptr -> view() -> size(), Is().EqualTo(2u));
+          AssertThat(fs.pull(), Is().EqualTo(1));
+          AssertThat(fs.pull(), Is().EqualTo(2));
+          AssertThat(fs.can_pull(), Is().False());
+        });
+
+        it("shares one in-memory copy with streams attached from multiple threads", [&]() {
+          const size_t threshold = memory::get_internal_file_threshold();
+          memory::set_internal_file_threshold(1u << 20);
+
+          simple_file<int> f;
+          f._file_ptr -> set_internal_capacity(0u);
+
+          {
+            simple_file_writer<int> fw(f);
+            for (int i = 0; i < 1000; i++) { fw << i; }
+          }
+
+          AssertThat(f._file_ptr -> is_on_disk(), Is().True());
+
+          std::vector<int> sums(8u, 0);
+          std::vector<std::thread> readers;
+          for (size_t t = 0u; t < sums.size(); t++) {
+            readers.emplace_back([&f, &sums, t]() {
+              file_stream<int, false> fs(f);
+              while (fs.can_pull()) { sums[t] += fs.pull(); }
+            });
+          }
+          for (std::thread &r : readers) { r.join(); }
+
+          for (const int sum : sums) {
+            AssertThat(sum, Is().EqualTo(999 * 1000 / 2));
+          }
+          AssertThat(f._file_ptr -> view() -> size(), Is().EqualTo(1000u));
+
+          memory::set_internal_file_threshold(threshold);
+        });
+
+        it("can obtain its view and size from multiple threads at once", [&]() {
+          const size_t threshold = memory::get_internal_file_threshold();
+          memory::set_internal_file_threshold(1u << 20);
+
+          simple_file<int> f;
+          f._file_ptr -> set_internal_capacity(0u);
+
+          {
+            simple_file_writer<int> fw(f);
+            for (int i = 0; i < 1000; i++) { fw << i; }
+          }
+          f.make_read_only();
+
+          std::vector<size_t> view_sizes(4u, 0u);
+          std::vector<size_t> sizes(4u, 0u);
+          std::vector<std::thread> readers;
+          for (size_t t = 0u; t < view_sizes.size(); t++) {
+            readers.emplace_back([&f, &view_sizes, t]() {
+              view_sizes[t] = f._file_ptr -> view() -> size();
+            });
+            readers.emplace_back([&f, &sizes, t]() {
+              sizes[t] = f.size();
+            });
+          }
+          for (std::thread &r : readers) { r.join(); }
+
+          for (const size_t s : view_sizes) { AssertThat(s, Is().EqualTo(1000u)); }
+          for (const size_t s : sizes) { AssertThat(s, Is().EqualTo(1000u)); }
+          AssertThat(f._file_ptr -> is_on_disk(), Is().True());
+
+          memory::set_internal_file_threshold(threshold);
+        });
       });
 
       describe("meta_file_stream", [&]() {
@@ -773,6 +1168,88 @@ go_bandit([]() {
               AssertThat(max_label(node_test_file), Is().EqualTo(1u));
             });
           });
+
+          describe("persistent node_file", [&]() {
+            // Remove leftovers of a prior run of the unit tests
+            for (const std::string name : { "node_file_test.adiar" }) {
+              for (const std::string suffix : { "", ".levels", ".0" }) {
+                std::filesystem::remove(name + suffix);
+              }
+            }
+
+            it("can construct a new named node_file", [&]() {
+              node_file nf("node_file_test.adiar");
+
+              AssertThat(nf._file_ptr -> is_persistent(), Is().True());
+              AssertThat(nf.is_read_only(), Is().False());
+
+              {
+                node_writer nw(nf);
+                nw << create_node(1, MAX_ID,
+                                  create_sink_ptr(false),
+                                  create_sink_ptr(true));
+
+                nw << create_node(0, MAX_ID,
+                                  create_sink_ptr(false),
+                                  create_node_ptr(1, MAX_ID));
+              }
+              nf._file_ptr -> max_1level_cut = 2u;
+
+              // Header is only stored when the file becomes read-only
+              AssertThat(std::filesystem::exists("node_file_test.adiar"), Is().False());
+              AssertThat(std::filesystem::exists("node_file_test.adiar.levels"), Is().True());
+              AssertThat(std::filesystem::exists("node_file_test.adiar.0"), Is().True());
+
+              nf.make_read_only();
+              AssertThat(std::filesystem::exists("node_file_test.adiar"), Is().True());
+            });
+
+            it("can reopen a prior named node_file with its meta information", [&]() {
+              node_file nf("node_file_test.adiar");
+
+              AssertThat(nf.is_read_only(), Is().True());
+              AssertThat(nf._file_ptr -> is_persistent(), Is().True());
+
+              AssertThat(nf.size(), Is().EqualTo(2u));
+              AssertThat(nf.meta_size(), Is().EqualTo(2u));
+
+              AssertThat(nf._file_ptr -> canonical, Is().True());
+              AssertThat(nf._file_ptr -> max_1level_cut, Is().EqualTo(2u));
+              AssertThat(nf._file_ptr -> number_of_sinks[false], Is().EqualTo(2u));
+              AssertThat(nf._file_ptr -> number_of_sinks[true], Is().EqualTo(1u));
+
+              node_stream<> ns(nf);
+
+              AssertThat(ns.can_pull(), Is().True());
+              AssertThat(ns.pull(), Is().EqualTo(create_node(0, MAX_ID,
+                                                             create_sink_ptr(false),
+                                                             create_node_ptr(1, MAX_ID))));
+              AssertThat(ns.can_pull(), Is().True());
+              AssertThat(ns.pull(), Is().EqualTo(create_node(1, MAX_ID,
+                                                             create_sink_ptr(false),
+                                                             create_sink_ptr(true))));
+              AssertThat(ns.can_pull(), Is().False());
+
+              level_info_test_stream<node_t> ms(nf);
+
+              AssertThat(ms.can_pull(), Is().True());
+              AssertThat(ms.pull(), Is().EqualTo(create_level_info(1,1u)));
+              AssertThat(ms.can_pull(), Is().True());
+              AssertThat(ms.pull(), Is().EqualTo(create_level_info(0,1u)));
+              AssertThat(ms.can_pull(), Is().False());
+            });
+
+            it("keeps the files of a named node_file after garbage collection", [&]() {
+              AssertThat(std::filesystem::exists("node_file_test.adiar"), Is().True());
+              AssertThat(std::filesystem::exists("node_file_test.adiar.levels"), Is().True());
+              AssertThat(std::filesystem::exists("node_file_test.adiar.0"), Is().True());
+            });
+
+            it("does not create a header for a temporary node_file", [&]() {
+              AssertThat(x0_and_x1._file_ptr -> is_persistent(), Is().False());
+              AssertThat(x0_and_x1._file_ptr -> path().empty(), Is().True());
+            });
+          });
         });
       });
     });
@@ -1,3 +1,5 @@
+#include <adiar/internal/nary_product_construction.h>
+
 go_bandit([]() {
   describe("adiar/zdd/binop.cpp", []() {
     node_file zdd_F;
@@ -438,6 +440,76 @@ go_bandit([]() {
       });
     });
 
+    describe("zdd_union(As)", [&]() {
+      it("should resolve no ZDDs to Ø", [&]() {
+        zdd out = zdd_union(std::vector<zdd> { });
+        AssertThat(out == zdd_empty(), Is().True());
+      });
+
+      it("should ignore Ø", [&]() {
+        zdd out = zdd_union(std::vector<zdd> { zdd_F, zdd_x0, zdd_F });
+        AssertThat(out == zdd(zdd_x0), Is().True());
+      });
+
+      it("should compute { Ø } u { {0} } u { {1} } in one sweep", [&]() {
+        zdd expected = zdd_union(zdd_union(zdd_T, zdd_x0), zdd_x1);
+
+        zdd out = zdd_union(std::vector<zdd> { zdd_T, zdd_x0, zdd_x1 });
+        AssertThat(out == expected, Is().True());
+      });
+
+      it("should combine more ZDDs than fit in one sweep", [&]() {
+        std::vector<zdd> As;
+        zdd expected = zdd_empty();
+
+        for (label_t var = 0; var < 2u * NARY_MAX_OPERANDS + 1u; var++) {
+          zdd A = zdd_ithvar(var);
+          As.push_back(A);
+          expected = zdd_union(expected, A);
+        }
+
+        zdd out = zdd_union(As);
+        AssertThat(out == expected, Is().True());
+      });
+    });
+
+    describe("zdd_intsec(As)", [&]() {
+      it("should throw on no ZDDs", [&]() {
+        AssertThrows(std::invalid_argument, zdd_intsec(std::vector<zdd> { }));
+      });
+
+      it("should shortcut on Ø", [&]() {
+        zdd out = zdd_intsec(std::vector<zdd> { zdd_x0, zdd_F, zdd_x1 });
+        AssertThat(out == zdd_empty(), Is().True());
+      });
+
+      it("should compute { Ø } n { {0} } n { {1} } in one sweep", [&]() {
+        zdd out = zdd_intsec(std::vector<zdd> { zdd_T, zdd_x0, zdd_x1 });
+        AssertThat(out == zdd_empty(), Is().True());
+      });
+
+      it("should keep { Ø } in the intersection of families with it", [&]() {
+        zdd A = zdd_union(zdd_T, zdd_x0);
+        zdd B = zdd_union(zdd_T, zdd_x1);
+        zdd C = zdd_union(A, zdd_x1);
+
+        zdd out = zdd_intsec(std::vector<zdd> { A, B, C });
+        AssertThat(out == zdd_null(), Is().True());
+      });
+
+      it("should compute the same as the binary intersection", [&]() {
+        zdd A = zdd_union(zdd_union(zdd_T, zdd_x0), zdd_x1);
+        zdd B = zdd_union(zdd_x0, zdd_x1);
+        zdd C = zdd_union(zdd_T, zdd_x1);
+        zdd D = zdd_union(zdd_x1, zdd_ithvar(2));
+
+        zdd expected = zdd_intsec(zdd_intsec(zdd_intsec(A, B), C), D);
+
+        zdd out = zdd_intsec(std::vector<zdd> { A, B, C, D });
+        AssertThat(out == expected, Is().True());
+      });
+    });
+
     describe("zdd_intsec", [&]() {
       it("should shortcut on same file", [&]() {
         __zdd out_1 = zdd_intsec(zdd_x0, zdd_x0);
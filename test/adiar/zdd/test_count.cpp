@@ -119,5 +119,41 @@ go_bandit([]() {
         AssertThat(zdd_size(zdd_root_1), Is().EqualTo(1u));
       });
     });
+
+    describe("zdd_sizeln / zdd_size_mod / zdd_size_str", [&]() {
+      it("can count family { {x2, x3}, {x0, x2, x3}, {x0, x1, x3} } [1]", [&]() {
+        AssertThat(zdd_sizeln(zdd_1), Is().EqualToWithDelta(std::log2(3.0), 1e-9));
+        AssertThat(zdd_size_mod(zdd_1, 2), Is().EqualTo(1u));
+        AssertThat(zdd_size_str(zdd_1), Is().EqualTo("3"));
+      });
+
+      it("can count family { Ø } [T]", [&]() {
+        AssertThat(zdd_sizeln(zdd_T), Is().EqualToWithDelta(0.0, 1e-9));
+        AssertThat(zdd_size_mod(zdd_T, 2), Is().EqualTo(1u));
+        AssertThat(zdd_size_str(zdd_T), Is().EqualTo("1"));
+      });
+
+      it("can count family Ø [F]", [&]() {
+        AssertThat(std::isinf(zdd_sizeln(zdd_F)), Is().True());
+        AssertThat(zdd_size_mod(zdd_F, 2), Is().EqualTo(0u));
+        AssertThat(zdd_size_str(zdd_F), Is().EqualTo("0"));
+      });
+
+      it("throws if the modulus is 0", [&]() {
+        AssertThrows(std::invalid_argument, zdd_size_mod(zdd_1, 0));
+        AssertThrows(std::invalid_argument, zdd_size_mod(zdd_T, 0));
+      });
+
+      it("can count the powerset of 100 elements", [&]() {
+        label_file dom;
+        { label_writer w(dom);
+          for (label_t x = 0; x < 100; x++) { w << x; }
+        }
+        const zdd pow = zdd_powerset(dom);
+
+        AssertThat(zdd_sizeln(pow), Is().EqualToWithDelta(100.0, 1e-9));
+        AssertThat(zdd_size_str(pow), Is().EqualTo("1267650600228229401496703205376"));
+      });
+    });
   });
  });
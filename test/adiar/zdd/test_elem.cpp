@@ -214,5 +214,82 @@ go_bandit([]() {
         AssertThat(ls.can_pull(), Is().False());
       });
     });
+    describe("zdd_allelem", [&]() {
+      // Collect all batches of the enumeration and check their sizes
+      const auto collect = [](const zdd &A, const size_t batch_size) {
+        label_batch result;
+        zdd_allelem(A, [&](const label_batch &batch) {
+          AssertThat(batch.size(), Is().GreaterThan(0u));
+          AssertThat(batch.size(), Is().LessThanOrEqualTo(batch_size));
+          result.insert(result.end(), batch.begin(), batch.end());
+        }, batch_size);
+        return result;
+      };
+
+      it("finds no element on Ø", [&]() {
+        AssertThat(collect(zdd_F, 2u).size(), Is().EqualTo(0u));
+      });
+
+      it("finds empty set on { Ø }", [&]() {
+        const label_batch result = collect(zdd_T, 2u);
+        AssertThat(result.size(), Is().EqualTo(1u));
+        AssertThat(result[0].size(), Is().EqualTo(0u));
+      });
+
+      it("finds all sets on [1]", [&]() {
+        const label_batch expected = { { 1 }, { 1,2 }, { 0 }, { 0,2 } };
+        AssertThat(collect(zdd_1, 3u), Is().EqualTo(expected));
+      });
+
+      it("finds all sets on [2]", [&]() {
+        const label_batch expected = { { }, { 2 }, { 2,3 }, { 1 } };
+        AssertThat(collect(zdd_2, 1u), Is().EqualTo(expected));
+      });
+
+      it("finds all sets on [4]", [&]() {
+        const label_batch expected = { { 1 }, { 0,1 } };
+        AssertThat(collect(zdd_4, 1024u), Is().EqualTo(expected));
+      });
+    });
+    describe("zdd_sample", [&]() {
+      it("should draw sets uniformly [1]", [&]() {
+        std::mt19937_64 rng(42);
+        std::map<std::vector<label_t>, size_t> histogram;
+
+        zdd_sample(zdd_1, 4000u, rng, [&](const label_batch &batch) {
+          AssertThat(batch.size(), Is().LessThanOrEqualTo(100u));
+          for (const std::vector<label_t> &a : batch) { histogram[a]++; }
+        }, 100u);
+
+        const std::vector<std::vector<label_t>> expected = { { 1 }, { 1,2 }, { 0 }, { 0,2 } };
+
+        AssertThat(histogram.size(), Is().EqualTo(4u));
+        for (const std::vector<label_t> &a : expected) {
+          AssertThat(histogram[a], Is().GreaterThan(850u));
+          AssertThat(histogram[a], Is().LessThan(1150u));
+        }
+      });
+
+      it("should draw the empty set from { Ø }", [&]() {
+        std::mt19937_64 rng(42);
+        size_t samples = 0u;
+
+        zdd_sample(zdd_T, 5u, rng, [&](const label_batch &batch) {
+          for (const std::vector<label_t> &a : batch) {
+            AssertThat(a.size(), Is().EqualTo(0u));
+            samples++;
+          }
+        });
+
+        AssertThat(samples, Is().EqualTo(5u));
+      });
+
+      it("should draw nothing from Ø", [&]() {
+        std::mt19937_64 rng(42);
+        bool called = false;
+        zdd_sample(zdd_F, 5u, rng, [&](const label_batch &) { called = true; });
+        AssertThat(called, Is().False());
+      });
+    });
   });
  });
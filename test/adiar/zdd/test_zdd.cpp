@@ -169,6 +169,17 @@ go_bandit([]() {
       AssertThat(t2.negate, Is().False());
     });
 
+    describe("zdd_hash", [&]() {
+      it("has equal hashes for the same family", [&]() {
+        AssertThat(zdd_hash(x0_or_x1), Is().EqualTo(zdd_hash(x0 | x1)));
+      });
+
+      it("has different hashes for different families", [&]() {
+        AssertThat(zdd_hash(x0), Is().Not().EqualTo(zdd_hash(x1)));
+        AssertThat(zdd_hash(x0), Is().Not().EqualTo(zdd_hash(x0_or_x1)));
+      });
+    });
+
     describe("sink predicates", [&]() {
       describe("is_sink", [&]() {
         it("rejects x0 as a sink file", [&]() {
@@ -242,5 +253,34 @@ go_bandit([]() {
         });
       });
     });
+
+    describe("zdd_save and zdd_load", [&]() {
+      // Remove leftovers of a prior run of the unit tests
+      for (const std::string name : { "zdd_save_test_or.adiar", "zdd_save_test_F.adiar" }) {
+        for (const std::string suffix : { "", ".levels", ".0" }) {
+          std::filesystem::remove(name + suffix);
+        }
+      }
+
+      it("can save and load { {0}, {1} }", [&]() {
+        zdd_save(x0_or_x1, "zdd_save_test_or.adiar");
+
+        zdd out = zdd_load("zdd_save_test_or.adiar");
+
+        AssertThat(out.file_ptr() -> is_persistent(), Is().True());
+        AssertThat(zdd_nodecount(out), Is().EqualTo(2u));
+        AssertThat(zdd_varcount(out), Is().EqualTo(2u));
+        AssertThat(out == x0_or_x1, Is().True());
+        AssertThat(out != x0, Is().True());
+      });
+
+      it("can save and load Ø", [&]() {
+        zdd_save(sink_F, "zdd_save_test_F.adiar");
+
+        zdd out = zdd_load("zdd_save_test_F.adiar");
+
+        AssertThat(is_empty(out), Is().True());
+      });
+    });
   });
  });
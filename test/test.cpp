@@ -1,3 +1,9 @@
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <thread>
+#include <vector>
+
 #include <tpie/tpie.h>
 #include <bandit/bandit.h>
 
@@ -126,13 +132,18 @@ namespace snowhouse
 
 #include "adiar/test_file.cpp"
 
+#include "adiar/test_context.cpp"
+
 // ////////////////////////////////////////////////////////////////////////////////
 // // ADIAR Internal unit tests
 #include "adiar/internal/test_levelized_priority_queue.cpp"
 
+#include "adiar/internal/test_cache.cpp"
+
 #include "adiar/internal/test_convert.cpp"
 #include "adiar/internal/test_dot.cpp"
 #include "adiar/internal/test_isomorphism.cpp"
+#include "adiar/internal/test_node_codec.cpp"
 #include "adiar/internal/test_reduce.cpp"
 #include "adiar/internal/test_util.cpp"
 
@@ -142,12 +153,15 @@ namespace snowhouse
 
 #include "adiar/bdd/test_apply.cpp"
 #include "adiar/bdd/test_assignment.cpp"
+#include "adiar/bdd/test_async.cpp"
 #include "adiar/bdd/test_build.cpp"
 #include "adiar/bdd/test_count.cpp"
 #include "adiar/bdd/test_evaluate.cpp"
+#include "adiar/bdd/test_expr.cpp"
 #include "adiar/bdd/test_if_then_else.cpp"
 #include "adiar/bdd/test_negate.cpp"
 #include "adiar/bdd/test_quantify.cpp"
+#include "adiar/bdd/test_relprod.cpp"
 #include "adiar/bdd/test_restrict.cpp"
 
 ////////////////////////////////////////////////////////////////////////////////